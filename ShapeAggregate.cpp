@@ -0,0 +1,205 @@
+//
+//  ShapeAggregate.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 20:31:09.6410
+//
+
+#include "ShapeAggregate.hpp"
+#include "Shapes.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+//  MARK: - Local Implementation.
+namespace {
+
+//  kernel block, kept on the stack
+constexpr std::size_t block = 1024;
+
+/*
+ *  MARK: Class Accumulator
+ *  Neumaier summation plus count, NaN count, min and max.  Infinities
+ *  are counted apart and kept out of the sum, whose compensation they
+ *  would make inf - inf.
+ */
+class Accumulator {
+public:
+  void add(double value) {
+    if (std::isnan(value)) {
+      ++nan_;
+      return;
+    }
+    ++count_;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (std::isinf(value)) {
+      ++(value > 0 ? plus_inf_ : minus_inf_);
+      return;
+    }
+    sum(value);
+  }
+
+  void merge(Accumulator const & other) {
+    count_ += other.count_;
+    nan_ += other.nan_;
+    plus_inf_ += other.plus_inf_;
+    minus_inf_ += other.minus_inf_;
+    sum(other.sum_);
+    compensation_ += other.compensation_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  Summary summary() const {
+    auto total = sum_ + compensation_;
+    if (plus_inf_ != 0 || minus_inf_ != 0) {
+      total = plus_inf_ == 0 ? -inf : minus_inf_ == 0 ? inf : NAN;
+    }
+    return { count_, nan_, total, min_, max_ };
+  }
+
+protected:
+  //  hide implementation details from the interface
+  static constexpr double inf = std::numeric_limits<double>::infinity();
+
+  //  past the finite range the sum alone carries the result
+  void sum(double value) {
+    auto const t = sum_ + value;
+    if (!std::isfinite(t)) {
+      sum_ = t;
+      return;
+    }
+    if (std::abs(sum_) >= std::abs(value)) {
+      compensation_ += (sum_ - t) + value;
+    }
+    else {
+      compensation_ += (value - t) + sum_;
+    }
+    sum_ = t;
+  }
+
+  std::size_t count_ = 0;
+  std::size_t nan_ = 0;
+  std::size_t plus_inf_ = 0;
+  std::size_t minus_inf_ = 0;
+  double sum_ = 0;
+  double compensation_ = 0;
+  double min_ = Summary().min;
+  double max_ = Summary().max;
+};
+
+/*
+ *  MARK: struct Partial
+ */
+struct Partial {
+  std::size_t count = 0;
+  Accumulator area;
+  Accumulator perimeter;
+
+  void merge(Partial const & other) {
+    count += other.count;
+    area.merge(other.area);
+    perimeter.merge(other.perimeter);
+  }
+
+  Aggregate result() const {
+    return { count, area.summary(), perimeter.summary() };
+  }
+};
+
+/*
+ *  MARK: struct Chunk
+ */
+struct Chunk {
+  ShapeKind kind;
+  std::size_t first;
+  std::size_t count;
+};
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: aggregate() - ShapeBatchView
+ *  chunks never span kinds, so each one is a single kernel call per
+ *  block.
+ */
+BatchAggregate aggregate(ShapeBatchView const & batch, ThreadPool & pool) {
+  std::vector<Chunk> chunks;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const n = batch.size(kind);
+    for (std::size_t first = 0; first < n; first += aggregate_grain) {
+      chunks.push_back({ kind, first, std::min(aggregate_grain, n - first) });
+    }
+  }
+
+  std::vector<Partial> partials(chunks.size());
+  pool.parallel_for(chunks.size(), [&](std::size_t c) {
+    auto const & chunk = chunks[c];
+    auto & partial = partials[c];
+    double areas[block];
+    double perimeters[block];
+    for (std::size_t done = 0; done < chunk.count; done += block) {
+      auto const n = std::min(block, chunk.count - done);
+      auto const rows = batch.slice(chunk.kind, chunk.first + done, n);
+      rows.areas(chunk.kind, areas);
+      rows.perimeters(chunk.kind, perimeters);
+      for (std::size_t i = 0; i < n; ++i) {
+        partial.area.add(areas[i]);
+        partial.perimeter.add(perimeters[i]);
+      }
+    }
+    partial.count = chunk.count;
+  });
+
+  std::array<Partial, shape_kind_count> kinds;
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    kinds[static_cast<std::size_t>(chunks[c].kind)].merge(partials[c]);
+  }
+  Partial all;
+  BatchAggregate result;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    all.merge(kinds[k]);
+    result.kinds[k] = kinds[k].result();
+  }
+  result.all = all.result();
+  return result;
+}
+
+BatchAggregate aggregate(ShapeBatchView const & batch) {
+  return aggregate(batch, ThreadPool::shared());
+}
+
+/*
+ *  MARK: aggregate() - Shape pointers
+ */
+Aggregate aggregate(std::span<Shape const * const> shapes, ThreadPool & pool) {
+  auto const chunks = (shapes.size() + aggregate_grain - 1) / aggregate_grain;
+  std::vector<Partial> partials(chunks);
+  pool.parallel_for(chunks, [&](std::size_t c) {
+    auto & partial = partials[c];
+    auto const chunk = shapes.subspan(c * aggregate_grain,
+                                      std::min(aggregate_grain, shapes.size() - c * aggregate_grain));
+    for (auto const shape : chunk) {
+      partial.area.add(shape->area());
+      partial.perimeter.add(shape->perimeter());
+    }
+    partial.count = chunk.size();
+  });
+
+  Partial all;
+  for (auto const & partial : partials) {
+    all.merge(partial);
+  }
+  return all.result();
+}
+
+Aggregate aggregate(std::span<Shape const * const> shapes) {
+  return aggregate(shapes, ThreadPool::shared());
+}
@@ -0,0 +1,89 @@
+//
+//  ShapeAggregate.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 20:31:09.6410
+//
+//  Parallel collection statistics: count, total, min, max and mean of
+//  area() and perimeter(), overall and per ShapeKind.
+//
+//  The collection is cut into fixed chunks of aggregate_grain shapes
+//  and the chunks run on a ThreadPool.  Each chunk keeps its own
+//  compensated (Neumaier) sums, and the chunk results are combined in
+//  chunk order once all have finished.  Chunk boundaries do not depend
+//  on the number of threads or on which thread ran what, so the result
+//  is the same bit for bit on every run and every pool size.
+//
+//  NaN results (a Triangle without its sides has a NaN perimeter) are
+//  counted in nan and left out of total, min, max and mean.  Infinite
+//  results are counted and kept out of the compensated sums; total is
+//  then +inf or -inf, or NaN if both occur.
+//
+//  MARK: - References.
+//  @see: Neumaier, "Rundungsfehleranalyse einiger Verfahren zur
+//        Summation endlicher Summen", ZAMM 54(1), 1974.
+//
+
+#ifndef ShapeAggregate_hpp
+#define ShapeAggregate_hpp
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include "ShapeBatch.hpp"
+
+class Shape;
+class ThreadPool;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: struct Summary
+ *  statistics of one measure.  min and max are +inf and -inf when no
+ *  value was counted.
+ */
+struct Summary {
+  std::size_t count = 0;
+  std::size_t nan = 0;
+  double total = 0;
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+
+  double mean() const { return count == 0 ? NAN : total / count; }
+};
+
+/*
+ *  MARK: struct Aggregate
+ */
+struct Aggregate {
+  std::size_t count = 0;
+  Summary area;
+  Summary perimeter;
+};
+
+/*
+ *  MARK: struct BatchAggregate
+ */
+struct BatchAggregate {
+  Aggregate all;
+  std::array<Aggregate, shape_kind_count> kinds;
+
+  Aggregate const & operator[](ShapeKind kind) const {
+    return kinds[static_cast<std::size_t>(kind)];
+  }
+};
+
+//  shapes per chunk
+constexpr std::size_t aggregate_grain = 16384;
+
+//  columnar collection, through the batch kernels
+BatchAggregate aggregate(ShapeBatchView const & batch, ThreadPool & pool);
+BatchAggregate aggregate(ShapeBatchView const & batch);
+
+//  polymorphic collection, through the virtual area() and perimeter()
+Aggregate aggregate(std::span<Shape const * const> shapes, ThreadPool & pool);
+Aggregate aggregate(std::span<Shape const * const> shapes);
+
+#endif /* ShapeAggregate_hpp */
@@ -0,0 +1,86 @@
+//
+//  ShapeArena.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 21:48:27.1175
+//
+
+#include "ShapeArena.hpp"
+
+#include <algorithm>
+
+//  MARK: - Class ShapeArena Implementation.
+/*
+ *  MARK: ShapeArena::ShapeArena() - c'tor
+ */
+ShapeArena::ShapeArena(std::size_t block_size)
+  : block_size_(std::max<std::size_t>(block_size, 4096)),
+    next_(nullptr), end_(nullptr), full_(0), objects_(0) {}
+
+/*
+ *  MARK: ShapeArena::~ShapeArena() - d'tor
+ */
+ShapeArena::~ShapeArena() {
+  release();
+}
+
+/*
+ *  MARK: ShapeArena::release()
+ */
+void
+ShapeArena::release() noexcept {
+  for (auto f = finalizers_.rbegin(); f != finalizers_.rend(); ++f) {
+    f->destroy(f->object);
+  }
+  finalizers_.clear();
+
+  if (blocks_.size() > 1) {
+    blocks_.erase(blocks_.begin() + 1, blocks_.end());
+  }
+  next_ = blocks_.empty() ? nullptr : blocks_.front().memory.get();
+  end_ = blocks_.empty() ? nullptr : next_ + blocks_.front().size;
+  full_ = 0;
+  objects_ = 0;
+}
+
+/*
+ *  MARK: ShapeArena::used()
+ */
+std::size_t
+ShapeArena::used() const noexcept {
+  return blocks_.empty()
+         ? 0
+         : full_ + static_cast<std::size_t>(next_ - blocks_.back().memory.get());
+}
+
+/*
+ *  MARK: ShapeArena::reserved()
+ */
+std::size_t
+ShapeArena::reserved() const noexcept {
+  std::size_t n = 0;
+  for (auto const & block : blocks_) {
+    n += block.size;
+  }
+  return n;
+}
+
+/*
+ *  MARK: ShapeArena::grow()
+ *  start a new block; objects larger than a block get one of their own.
+ */
+void *
+ShapeArena::grow(std::size_t size, std::size_t align) {
+  if (!blocks_.empty()) {
+    full_ += static_cast<std::size_t>(next_ - blocks_.back().memory.get());
+  }
+  //  new[] of std::byte is aligned for any fundamental type, which
+  //  covers every Shape class; larger alignments pad the front
+  auto const bytes = std::max(block_size_, size + align);
+  blocks_.push_back({ std::unique_ptr<std::byte[]>(new std::byte[bytes]), bytes });
+
+  next_ = blocks_.back().memory.get();
+  end_ = next_ + bytes;
+  return allocate(size, align);
+}
@@ -0,0 +1,129 @@
+//
+//  ShapeArena.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 21:48:27.1175
+//
+//  Bump allocation for polymorphic shapes.
+//
+//  make<T>() places each object directly after the previous one in
+//  large blocks, so millions of shapes cost a handful of allocations,
+//  carry no per-object heap header and sit contiguously in memory for
+//  the virtual-call loops.  Objects are never freed one at a time;
+//  release() (or the destructor) drops them all at once.
+//
+//  The nine classes in Shapes.hpp hold only doubles, so dropping them
+//  without running their destructors is safe and release() costs one
+//  pass over the blocks, not one call per shape.  Any other Shape type
+//  gets its destructor recorded and run by release(), newest first.
+//
+
+#ifndef ShapeArena_hpp
+#define ShapeArena_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Shapes.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: trivially_releasable
+ *  true for types whose destructor may be skipped.
+ */
+template <typename T>
+struct trivially_releasable : std::is_trivially_destructible<T> {};
+
+template <> struct trivially_releasable<Rectangle> : std::true_type {};
+template <> struct trivially_releasable<Square> : std::true_type {};
+template <> struct trivially_releasable<Parallelogram> : std::true_type {};
+template <> struct trivially_releasable<Circle> : std::true_type {};
+template <> struct trivially_releasable<Triangle> : std::true_type {};
+template <> struct trivially_releasable<RightTriangle> : std::true_type {};
+template <> struct trivially_releasable<IsoscelesTriangle> : std::true_type {};
+template <> struct trivially_releasable<EquilateralTriangle> : std::true_type {};
+template <> struct trivially_releasable<RightIsoscelesTriangle> : std::true_type {};
+
+/*
+ *  MARK: Class ShapeArena
+ *
+ *  Not thread-safe; use one arena per thread.  Pointers from make()
+ *  stay valid until release() or destruction.
+ */
+class ShapeArena {
+public:
+  static constexpr std::size_t default_block = std::size_t(1) << 20;
+
+  explicit ShapeArena(std::size_t block_size = default_block);
+  ~ShapeArena();
+
+  ShapeArena(ShapeArena const &) = delete;
+  ShapeArena & operator=(ShapeArena const &) = delete;
+
+  template <typename T, typename... Args>
+  T * make(Args &&... args) {
+    static_assert(std::is_base_of_v<Shape, T>, "ShapeArena holds Shape types");
+    auto const memory = allocate(sizeof(T), alignof(T));
+    auto const shape = ::new (memory) T(std::forward<Args>(args)...);
+    if constexpr (!trivially_releasable<T>::value) {
+      finalizers_.push_back({ shape, [](void * p) { static_cast<T *>(p)->~T(); } });
+    }
+    ++objects_;
+    return shape;
+  }
+
+  //  every object is gone; the first block is kept for reuse
+  void release() noexcept;
+
+  std::size_t size() const noexcept { return objects_; }
+  //  bytes handed out, including alignment gaps
+  std::size_t used() const noexcept;
+  //  bytes held in blocks
+  std::size_t reserved() const noexcept;
+
+protected:
+  //  hide implementation details from the interface
+  struct Finalizer {
+    void * object;
+    void (*destroy)(void *);
+  };
+
+  struct Block {
+    std::unique_ptr<std::byte[]> memory;
+    std::size_t size;
+  };
+
+  void * allocate(std::size_t size, std::size_t align);
+  void * grow(std::size_t size, std::size_t align);
+
+  std::size_t block_size_;
+  std::vector<Block> blocks_;
+  std::byte * next_;
+  std::byte * end_;
+  std::size_t full_;      //  bytes used in blocks before the current one
+  std::size_t objects_;
+  std::vector<Finalizer> finalizers_;
+};
+
+/*
+ *  MARK: ShapeArena::allocate()
+ *  the bump itself stays inline; grow() handles the slow path.
+ */
+inline
+void * ShapeArena::allocate(std::size_t size, std::size_t align) {
+  auto const at = reinterpret_cast<std::uintptr_t>(next_);
+  auto const aligned = (at + align - 1) & ~std::uintptr_t(align - 1);
+  if (next_ != nullptr && aligned + size <= reinterpret_cast<std::uintptr_t>(end_)) {
+    next_ = reinterpret_cast<std::byte *>(aligned + size);
+    return reinterpret_cast<void *>(aligned);
+  }
+  return grow(size, align);
+}
+
+#endif /* ShapeArena_hpp */
@@ -0,0 +1,459 @@
+//
+//  ShapeBatch.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 09:31:07.5524
+//
+
+#include "ShapeBatch.hpp"
+#include "ShapeKernels.hpp"
+
+#include <cmath>
+
+//  MARK: - Class ShapeBatch Implementation.
+/*
+ *  MARK: ShapeBatch::col()
+ */
+ShapeBatch::Column &
+ShapeBatch::col(ShapeKind kind, std::size_t field) {
+  return columns_[static_cast<std::size_t>(kind)][field];
+}
+
+ShapeBatch::Column const &
+ShapeBatch::col(ShapeKind kind, std::size_t field) const {
+  return columns_[static_cast<std::size_t>(kind)][field];
+}
+
+/*
+ *  MARK: ShapeBatch::add_rectangle()
+ *  Rectangle(length, breadth) - baseA_ = length, sideA_ = breadth
+ */
+void ShapeBatch::add_rectangle(double length, double breadth) {
+  col(ShapeKind::rectangle, 0).push_back(length);
+  col(ShapeKind::rectangle, 1).push_back(breadth);
+}
+
+/*
+ *  MARK: ShapeBatch::add_square()
+ */
+void ShapeBatch::add_square(double length) {
+  col(ShapeKind::square, 0).push_back(length);
+}
+
+/*
+ *  MARK: ShapeBatch::add_parallelogram()
+ */
+void ShapeBatch::add_parallelogram(double height, double base, double side) {
+  col(ShapeKind::parallelogram, 0).push_back(height);
+  col(ShapeKind::parallelogram, 1).push_back(base);
+  col(ShapeKind::parallelogram, 2).push_back(side);
+}
+
+/*
+ *  MARK: ShapeBatch::add_circle()
+ */
+void ShapeBatch::add_circle(double radius) {
+  col(ShapeKind::circle, 0).push_back(radius);
+}
+
+/*
+ *  MARK: ShapeBatch::add_triangle()
+ */
+void ShapeBatch::add_triangle(double base, double height,
+                              double sideA, double sideB) {
+  col(ShapeKind::triangle, 0).push_back(base);
+  col(ShapeKind::triangle, 1).push_back(height);
+  col(ShapeKind::triangle, 2).push_back(sideA);
+  col(ShapeKind::triangle, 3).push_back(sideB);
+}
+
+/*
+ *  MARK: ShapeBatch::add_right_triangle()
+ *  hypotenuse_ as in RightTriangle::RightTriangle()
+ */
+void ShapeBatch::add_right_triangle(double base, double height) {
+  col(ShapeKind::right_triangle, 0).push_back(base);
+  col(ShapeKind::right_triangle, 1).push_back(height);
+  col(ShapeKind::right_triangle, 2).push_back(std::hypot(base, height));
+}
+
+/*
+ *  MARK: ShapeBatch::add_isosceles_triangle()
+ *  side length as in IsoscelesTriangle::IsoscelesTriangle()
+ */
+void ShapeBatch::add_isosceles_triangle(double base, double height) {
+  col(ShapeKind::isosceles_triangle, 0).push_back(base);
+  col(ShapeKind::isosceles_triangle, 1).push_back(height);
+  col(ShapeKind::isosceles_triangle, 2).push_back(std::hypot(base / 2., height));
+}
+
+/*
+ *  MARK: ShapeBatch::add_equilateral_triangle()
+ *  height_ as in EquilateralTriangle::EquilateralTriangle()
+ */
+void ShapeBatch::add_equilateral_triangle(double base) {
+  col(ShapeKind::equilateral_triangle, 0).push_back(base);
+  col(ShapeKind::equilateral_triangle, 1).push_back(std::sqrt(3.0) / 2 * base);
+}
+
+/*
+ *  MARK: ShapeBatch::add_right_isosceles_triangle()
+ *  hypotenuse_ as in RightIsoscelesTriangle::RightIsoscelesTriangle()
+ */
+void ShapeBatch::add_right_isosceles_triangle(double height) {
+  col(ShapeKind::right_isosceles_triangle, 0).push_back(height);
+  col(ShapeKind::right_isosceles_triangle, 1).push_back(std::hypot(height, height));
+}
+
+/*
+ *  MARK: ShapeBatch::append()
+ */
+bool ShapeBatch::append(ShapeKind kind, double const * params, std::size_t count) {
+  auto const & layout = layout_of(kind);
+  if (count < layout.required || count > layout.params) {
+    return false;
+  }
+  auto const p = [&](std::size_t i) { return i < count ? params[i] : NAN; };
+
+  switch (kind) {
+  case ShapeKind::rectangle:                add_rectangle(p(0), p(1)); break;
+  case ShapeKind::square:                   add_square(p(0)); break;
+  case ShapeKind::parallelogram:            add_parallelogram(p(0), p(1), p(2)); break;
+  case ShapeKind::circle:                   add_circle(p(0)); break;
+  case ShapeKind::triangle:                 add_triangle(p(0), p(1), p(2), p(3)); break;
+  case ShapeKind::right_triangle:           add_right_triangle(p(0), p(1)); break;
+  case ShapeKind::isosceles_triangle:       add_isosceles_triangle(p(0), p(1)); break;
+  case ShapeKind::equilateral_triangle:     add_equilateral_triangle(p(0)); break;
+  case ShapeKind::right_isosceles_triangle: add_right_isosceles_triangle(p(0)); break;
+  }
+  return true;
+}
+
+void ShapeBatch::append(ShapeBatch const & other) {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    for (std::size_t f = 0; f < shape_layouts[k].fields; ++f) {
+      auto & to = columns_[k][f];
+      auto const & from = other.columns_[k][f];
+      to.insert(to.end(), from.begin(), from.end());
+    }
+  }
+}
+
+/*
+ *  MARK: ShapeBatch::reserve()
+ */
+void ShapeBatch::reserve(ShapeKind kind, std::size_t n) {
+  for (std::size_t f = 0; f < layout_of(kind).fields; ++f) {
+    col(kind, f).reserve(n);
+  }
+}
+
+/*
+ *  MARK: ShapeBatch::clear()
+ */
+void ShapeBatch::clear() {
+  for (auto & kind : columns_) {
+    for (auto & column : kind) {
+      column.clear();
+    }
+  }
+}
+
+/*
+ *  MARK: ShapeBatch::size()
+ */
+std::size_t ShapeBatch::size(ShapeKind kind) const {
+  return col(kind, 0).size();
+}
+
+std::size_t ShapeBatch::size() const {
+  std::size_t n = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    n += size(static_cast<ShapeKind>(k));
+  }
+  return n;
+}
+
+/*
+ *  MARK: ShapeBatch::column()
+ */
+ShapeBatchView::Column ShapeBatch::column(ShapeKind kind, std::size_t field) const {
+  return col(kind, field);
+}
+
+/*
+ *  MARK: ShapeBatch::view()
+ */
+ShapeBatchView ShapeBatch::view() const {
+  ShapeBatchView view;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    view.set(kind, size(kind), { col(kind, 0).data(), col(kind, 1).data(),
+                                 col(kind, 2).data(), col(kind, 3).data() });
+  }
+  return view;
+}
+
+/*
+ *  MARK: ShapeBatch::derive()
+ *  as the add_ functions compute them, bit for bit.
+ */
+void ShapeBatch::derive(ShapeKind kind, std::size_t first) {
+  auto const n = size(kind) - first;
+  auto const f = [&](std::size_t field) { return col(kind, field).data() + first; };
+
+  switch (kind) {
+  case ShapeKind::right_triangle:
+    for (std::size_t i = 0; i < n; ++i) {
+      f(2)[i] = std::hypot(f(0)[i], f(1)[i]);
+    }
+    break;
+
+  case ShapeKind::isosceles_triangle:
+    for (std::size_t i = 0; i < n; ++i) {
+      f(2)[i] = std::hypot(f(0)[i] / 2., f(1)[i]);
+    }
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    for (std::size_t i = 0; i < n; ++i) {
+      f(1)[i] = std::sqrt(3.0) / 2 * f(0)[i];
+    }
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    for (std::size_t i = 0; i < n; ++i) {
+      f(1)[i] = std::hypot(f(0)[i], f(0)[i]);
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+//  MARK: - Class ShapeBatchView Implementation.
+/*
+ *  MARK: ShapeBatchView::set()
+ */
+void ShapeBatchView::set(ShapeKind kind, std::size_t size,
+                         std::array<double const *, 4> const & fields) {
+  sizes_[static_cast<std::size_t>(kind)] = size;
+  fields_[static_cast<std::size_t>(kind)] = fields;
+}
+
+/*
+ *  MARK: ShapeBatchView::size()
+ */
+std::size_t ShapeBatchView::size() const {
+  std::size_t n = 0;
+  for (auto size : sizes_) {
+    n += size;
+  }
+  return n;
+}
+
+/*
+ *  MARK: ShapeBatchView::slice()
+ */
+ShapeBatchView ShapeBatchView::slice(ShapeKind kind, std::size_t first,
+                                     std::size_t count) const {
+  auto const k = static_cast<std::size_t>(kind);
+  std::array<double const *, 4> fields {};
+  for (std::size_t f = 0; f < layout_of(kind).fields; ++f) {
+    fields[f] = fields_[k][f] + first;
+  }
+  ShapeBatchView view;
+  view.set(kind, count, fields);
+  return view;
+}
+
+/*
+ *  MARK: ShapeBatchView::areas()
+ */
+void ShapeBatchView::areas(ShapeKind kind, double * out) const {
+  namespace sk = shape_kernels;
+  auto const n = size(kind);
+  auto const f = [&](std::size_t field) { return column(kind, field).data(); };
+
+  switch (kind) {
+  case ShapeKind::rectangle:
+  case ShapeKind::square:
+    //  Rectangle::area() - baseA_ * sideA_, both are the length for Square
+    sk::product(f(0), kind == ShapeKind::square ? f(0) : f(1), out, n);
+    break;
+
+  case ShapeKind::parallelogram:
+    sk::product(f(1), f(0), out, n);
+    break;
+
+  case ShapeKind::circle:
+    sk::scaled_product(M_PI, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::triangle:
+  case ShapeKind::right_triangle:
+  case ShapeKind::isosceles_triangle:
+    sk::half_product(f(0), f(1), out, n);
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    sk::scaled_product(std::sqrt(3.0) / 4, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    //  base_ == height_
+    sk::half_product(f(0), f(0), out, n);
+    break;
+  }
+}
+
+void ShapeBatchView::areas(double * out) const {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    areas(kind, out);
+    out += size(kind);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchView::perimeters()
+ */
+void ShapeBatchView::perimeters(ShapeKind kind, double * out) const {
+  namespace sk = shape_kernels;
+  auto const n = size(kind);
+  auto const f = [&](std::size_t field) { return column(kind, field).data(); };
+
+  switch (kind) {
+  case ShapeKind::rectangle:
+    //  Quadrilateral::perimeter() - baseA_ + sideA_ + baseB_ + sideB_
+    sk::sum4(f(0), f(1), f(0), f(1), out, n);
+    break;
+
+  case ShapeKind::square:
+    sk::sum4(f(0), f(0), f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::parallelogram:
+    sk::sum4(f(1), f(2), f(1), f(2), out, n);
+    break;
+
+  case ShapeKind::circle:
+    //  Circle::circumference() - M_PI * (radius_ * 2.0)
+    sk::scaled_sum(M_PI, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::triangle:
+    //  Triangle::perimeter() - base_ + sideA_ + sideB_, NaN propagates
+    sk::sum3(f(0), f(2), f(3), out, n);
+    break;
+
+  case ShapeKind::right_triangle:
+    //  sideA_ == height_, sideB_ == hypotenuse_
+    sk::sum3(f(0), f(1), f(2), out, n);
+    break;
+
+  case ShapeKind::isosceles_triangle:
+    sk::sum3(f(0), f(2), f(2), out, n);
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    sk::sum3(f(0), f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    //  base_ == sideA_ == height_, sideB_ == hypotenuse_
+    sk::sum3(f(0), f(0), f(1), out, n);
+    break;
+  }
+}
+
+void ShapeBatchView::perimeters(double * out) const {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    perimeters(kind, out);
+    out += size(kind);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchView::dims()
+ */
+void ShapeBatchView::dims(RectDims * out) const {
+  auto const length = column(ShapeKind::rectangle, 0);
+  auto const breadth = column(ShapeKind::rectangle, 1);
+  for (std::size_t i = 0, n = size(ShapeKind::rectangle); i < n; ++i) {
+    out[i] = { length[i], breadth[i] };
+  }
+}
+
+void ShapeBatchView::dims(SquareDims * out) const {
+  auto const length = column(ShapeKind::square, 0);
+  for (std::size_t i = 0, n = size(ShapeKind::square); i < n; ++i) {
+    out[i] = { length[i] };
+  }
+}
+
+void ShapeBatchView::dims(ParallelogramDims * out) const {
+  auto const height = column(ShapeKind::parallelogram, 0);
+  auto const base = column(ShapeKind::parallelogram, 1);
+  auto const side = column(ShapeKind::parallelogram, 2);
+  for (std::size_t i = 0, n = size(ShapeKind::parallelogram); i < n; ++i) {
+    out[i] = { base[i], height[i], side[i] };
+  }
+}
+
+void ShapeBatchView::dims(CircleDims * out) const {
+  auto const radius = column(ShapeKind::circle, 0);
+  for (std::size_t i = 0, n = size(ShapeKind::circle); i < n; ++i) {
+    out[i] = { radius[i] };
+  }
+}
+
+void ShapeBatchView::dims(TriangleDims * out) const {
+  auto const base = column(ShapeKind::triangle, 0);
+  auto const height = column(ShapeKind::triangle, 1);
+  auto const sideA = column(ShapeKind::triangle, 2);
+  auto const sideB = column(ShapeKind::triangle, 3);
+  for (std::size_t i = 0, n = size(ShapeKind::triangle); i < n; ++i) {
+    out[i] = { base[i], height[i], sideA[i], sideB[i] };
+  }
+}
+
+void ShapeBatchView::dims(RightTriangleDims * out) const {
+  auto const base = column(ShapeKind::right_triangle, 0);
+  auto const height = column(ShapeKind::right_triangle, 1);
+  auto const hypotenuse = column(ShapeKind::right_triangle, 2);
+  for (std::size_t i = 0, n = size(ShapeKind::right_triangle); i < n; ++i) {
+    out[i] = { base[i], height[i], hypotenuse[i] };
+  }
+}
+
+void ShapeBatchView::dims(IsoscelesDims * out) const {
+  auto const base = column(ShapeKind::isosceles_triangle, 0);
+  auto const height = column(ShapeKind::isosceles_triangle, 1);
+  auto const side = column(ShapeKind::isosceles_triangle, 2);
+  for (std::size_t i = 0, n = size(ShapeKind::isosceles_triangle); i < n; ++i) {
+    out[i] = { base[i], height[i], side[i] };
+  }
+}
+
+void ShapeBatchView::dims(EquilateralDims * out) const {
+  auto const base = column(ShapeKind::equilateral_triangle, 0);
+  auto const height = column(ShapeKind::equilateral_triangle, 1);
+  for (std::size_t i = 0, n = size(ShapeKind::equilateral_triangle); i < n; ++i) {
+    out[i] = { base[i], height[i] };
+  }
+}
+
+void ShapeBatchView::dims(RightIsoscelesDims * out) const {
+  auto const height = column(ShapeKind::right_isosceles_triangle, 0);
+  auto const hypotenuse = column(ShapeKind::right_isosceles_triangle, 1);
+  for (std::size_t i = 0, n = size(ShapeKind::right_isosceles_triangle); i < n; ++i) {
+    //  iheight_ as in RightIsoscelesTriangle::RightIsoscelesTriangle()
+    auto const h = height[i];
+    auto const c = hypotenuse[i];
+    out[i] = { h, c, std::sqrt((h * h) - (c * c / 4.0)) };
+  }
+}
@@ -0,0 +1,190 @@
+//
+//  ShapeBatch.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 09:31:07.5524
+//
+
+#ifndef ShapeBatch_hpp
+#define ShapeBatch_hpp
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeDims.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: enum ShapeKind
+ *  one entry per concrete class in the Shape hierarchy.
+ */
+enum class ShapeKind : std::uint8_t {
+  rectangle,
+  square,
+  parallelogram,
+  circle,
+  triangle,
+  right_triangle,
+  isosceles_triangle,
+  equilateral_triangle,
+  right_isosceles_triangle,
+};
+
+constexpr std::size_t shape_kind_count = 9;
+
+/*
+ *  MARK: struct ShapeLayout
+ *  column layout of one kind.  The first params fields are the
+ *  constructor arguments in constructor order, the rest are derived.
+ *  Only the first required arguments must be given; Triangle's sides
+ *  default to NAN as in its constructor.
+ */
+struct ShapeLayout {
+  char const * name;
+  std::uint8_t required;
+  std::uint8_t params;
+  std::uint8_t fields;
+  std::array<char const *, 4> field_names;
+};
+
+constexpr std::array<ShapeLayout, shape_kind_count> shape_layouts {{
+  { "Rectangle",              2, 2, 2, { "baseA", "sideA" } },
+  { "Square",                 1, 1, 1, { "baseA" } },
+  { "Parallelogram",          3, 3, 3, { "height", "baseA", "sideA" } },
+  { "Circle",                 1, 1, 1, { "radius" } },
+  { "Triangle",               2, 4, 4, { "base", "height", "sideA", "sideB" } },
+  { "RightTriangle",          2, 2, 3, { "base", "height", "hypotenuse" } },
+  { "IsoscelesTriangle",      2, 2, 3, { "base", "height", "side" } },
+  { "EquilateralTriangle",    1, 1, 2, { "base", "height" } },
+  { "RightIsoscelesTriangle", 1, 1, 2, { "height", "hypotenuse" } },
+}};
+
+constexpr
+ShapeLayout const & layout_of(ShapeKind kind) {
+  return shape_layouts[static_cast<std::size_t>(kind)];
+}
+
+/*
+ *  MARK: Class ShapeBatchView
+ *
+ *  Non-owning view of columns laid out as in ShapeBatch, wherever they
+ *  live: a ShapeBatch, or a mapped column file (ShapeStore.hpp).  The
+ *  batch kernels are defined on the view, so every store shares them.
+ */
+class ShapeBatchView {
+public:
+  using Column = std::span<double const>;
+
+  ShapeBatchView() = default;
+
+  //  field points at size doubles for each of the kind's fields
+  void set(ShapeKind kind, std::size_t size, std::array<double const *, 4> const & fields);
+
+  std::size_t size() const;
+  std::size_t size(ShapeKind kind) const {
+    return sizes_[static_cast<std::size_t>(kind)];
+  }
+  Column column(ShapeKind kind, std::size_t field) const {
+    return { fields_[static_cast<std::size_t>(kind)][field], size(kind) };
+  }
+
+  //  rows [first, first + count) of kind, every other kind empty
+  ShapeBatchView slice(ShapeKind kind, std::size_t first, std::size_t count) const;
+
+  //  out must hold size(kind) values
+  void areas(ShapeKind kind, double * out) const;
+  void perimeters(ShapeKind kind, double * out) const;
+
+  //  out must hold size() values, kinds laid out in ShapeKind order
+  void areas(double * out) const;
+  void perimeters(double * out) const;
+
+  //  typed dimensions of the matching kind, out must hold size(kind)
+  void dims(RectDims * out) const;
+  void dims(SquareDims * out) const;
+  void dims(ParallelogramDims * out) const;
+  void dims(CircleDims * out) const;
+  void dims(TriangleDims * out) const;
+  void dims(RightTriangleDims * out) const;
+  void dims(IsoscelesDims * out) const;
+  void dims(EquilateralDims * out) const;
+  void dims(RightIsoscelesDims * out) const;
+
+protected:
+  //  hide implementation details from the interface
+  std::array<std::size_t, shape_kind_count> sizes_ {};
+  std::array<std::array<double const *, 4>, shape_kind_count> fields_ {};
+};
+
+/*
+ *  MARK: Class ShapeBatch
+ *
+ *  Structure-of-arrays store: every kind keeps its fields in contiguous
+ *  per-field columns, named after the members of the matching class.
+ *  Derived members (hypotenuse_, the isosceles sides, the equilateral
+ *  height_) are computed once on insertion exactly as the constructors
+ *  compute them, so the batch kernels reproduce area() and perimeter()
+ *  bit for bit.
+ */
+class ShapeBatch {
+public:
+  using Column = std::vector<double>;
+
+  ShapeBatch() = default;
+
+  void add_rectangle(double length, double breadth);
+  void add_square(double length);
+  void add_parallelogram(double height, double base, double side);
+  void add_circle(double radius);
+  void add_triangle(double base, double height,
+                    double sideA = NAN, double sideB = NAN);
+  void add_right_triangle(double base, double height);
+  void add_isosceles_triangle(double base, double height);
+  void add_equilateral_triangle(double base);
+  void add_right_isosceles_triangle(double height);
+
+  //  generic form of the add_ functions: count constructor arguments,
+  //  false if count is outside [required, params] for the kind
+  bool append(ShapeKind kind, double const * params, std::size_t count);
+  //  every shape of other, after the ones already held
+  void append(ShapeBatch const & other);
+
+  void reserve(ShapeKind kind, std::size_t n);
+  void clear();
+
+  std::size_t size() const;
+  std::size_t size(ShapeKind kind) const;
+  ShapeBatchView::Column column(ShapeKind kind, std::size_t field) const;
+
+  //  valid until the batch is next modified
+  ShapeBatchView view() const;
+
+  //  as ShapeBatchView
+  void areas(ShapeKind kind, double * out) const { view().areas(kind, out); }
+  void perimeters(ShapeKind kind, double * out) const { view().perimeters(kind, out); }
+  void areas(double * out) const { view().areas(out); }
+  void perimeters(double * out) const { view().perimeters(out); }
+
+  template <typename Dims>
+  void dims(Dims * out) const { view().dims(out); }
+
+protected:
+  //  hide implementation details from the interface
+  //  ShapeFactory fills the argument columns in place
+  friend class ShapeFactory;
+
+  Column & col(ShapeKind kind, std::size_t field);
+  Column const & col(ShapeKind kind, std::size_t field) const;
+  //  derived fields of rows [first, size(kind)) from their arguments,
+  //  a column at a time
+  void derive(ShapeKind kind, std::size_t first);
+
+  std::array<std::array<Column, 4>, shape_kind_count> columns_;
+};
+
+#endif /* ShapeBatch_hpp */
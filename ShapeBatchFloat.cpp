@@ -0,0 +1,320 @@
+//
+//  ShapeBatchFloat.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:06:21.9347
+//
+
+#include "ShapeBatchFloat.hpp"
+#include "ShapeKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//  MARK: - Local Implementation.
+namespace {
+
+//  totals work through a stack buffer of this many values at a time
+constexpr std::size_t total_block = 2048;
+
+constexpr float pi_f = static_cast<float>(M_PI);
+constexpr float equilateral_height_f = static_cast<float>(1.7320508075688772 / 2);
+constexpr float equilateral_area_f = static_cast<float>(1.7320508075688772 / 4);
+
+} /* namespace */
+
+//  MARK: - Class ShapeBatchFloat Implementation.
+/*
+ *  MARK: ShapeBatchFloat::col()
+ */
+ShapeBatchFloat::Column &
+ShapeBatchFloat::col(ShapeKind kind, std::size_t field) {
+  return columns_[static_cast<std::size_t>(kind)][field];
+}
+
+ShapeBatchFloat::Column const &
+ShapeBatchFloat::col(ShapeKind kind, std::size_t field) const {
+  return columns_[static_cast<std::size_t>(kind)][field];
+}
+
+/*
+ *  MARK: ShapeBatchFloat::append()
+ */
+bool
+ShapeBatchFloat::append(ShapeKind kind, double const * params, std::size_t count) {
+  auto const & layout = layout_of(kind);
+  if (count < layout.required || count > layout.params) {
+    return false;
+  }
+  auto const first = size(kind);
+  for (std::size_t f = 0; f < layout.fields; ++f) {
+    col(kind, f).push_back(f < count ? static_cast<float>(params[f]) : NAN);
+  }
+  derive(kind, first);
+  return true;
+}
+
+void
+ShapeBatchFloat::append(ShapeBatchView const & batch) {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const & layout = shape_layouts[k];
+    auto const first = size(kind);
+    auto const n = batch.size(kind);
+    for (std::size_t f = 0; f < layout.fields; ++f) {
+      auto & to = col(kind, f);
+      to.resize(first + n);
+      if (f < layout.params) {
+        auto const from = batch.column(kind, f);
+        std::transform(from.begin(), from.end(), to.begin() + first,
+                       [](double x) { return static_cast<float>(x); });
+      }
+    }
+    derive(kind, first);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::derive()
+ *  as ShapeBatch::add_ functions compute them, in float.
+ */
+void
+ShapeBatchFloat::derive(ShapeKind kind, std::size_t first) {
+  namespace sk = shape_kernels;
+  auto const n = size(kind) - first;
+  auto const f = [&](std::size_t field) { return col(kind, field).data() + first; };
+
+  switch (kind) {
+  case ShapeKind::right_triangle:
+    sk::hypotenuse(1.0f, f(0), f(1), f(2), n);
+    break;
+
+  case ShapeKind::isosceles_triangle:
+    sk::hypotenuse(0.5f, f(0), f(1), f(2), n);
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    sk::scaled(equilateral_height_f, f(0), f(1), n);
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    sk::hypotenuse(1.0f, f(0), f(0), f(1), n);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::reserve()
+ */
+void
+ShapeBatchFloat::reserve(ShapeKind kind, std::size_t n) {
+  for (std::size_t f = 0; f < layout_of(kind).fields; ++f) {
+    col(kind, f).reserve(n);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::clear()
+ */
+void
+ShapeBatchFloat::clear() {
+  for (auto & kind : columns_) {
+    for (auto & column : kind) {
+      column.clear();
+    }
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::size()
+ */
+std::size_t
+ShapeBatchFloat::size(ShapeKind kind) const {
+  return col(kind, 0).size();
+}
+
+std::size_t
+ShapeBatchFloat::size() const {
+  std::size_t n = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    n += size(static_cast<ShapeKind>(k));
+  }
+  return n;
+}
+
+/*
+ *  MARK: ShapeBatchFloat::column()
+ */
+std::span<float const>
+ShapeBatchFloat::column(ShapeKind kind, std::size_t field) const {
+  return col(kind, field);
+}
+
+/*
+ *  MARK: ShapeBatchFloat::areas()
+ *  the ShapeBatchView::areas() expressions.
+ */
+void
+ShapeBatchFloat::areas(ShapeKind kind, std::size_t first, std::size_t n, float * out) const {
+  namespace sk = shape_kernels;
+  auto const f = [&](std::size_t field) { return col(kind, field).data() + first; };
+
+  switch (kind) {
+  case ShapeKind::rectangle:
+  case ShapeKind::square:
+    sk::product(f(0), kind == ShapeKind::square ? f(0) : f(1), out, n);
+    break;
+
+  case ShapeKind::parallelogram:
+    sk::product(f(1), f(0), out, n);
+    break;
+
+  case ShapeKind::circle:
+    sk::scaled_product(pi_f, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::triangle:
+  case ShapeKind::right_triangle:
+  case ShapeKind::isosceles_triangle:
+    sk::half_product(f(0), f(1), out, n);
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    sk::scaled_product(equilateral_area_f, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    sk::half_product(f(0), f(0), out, n);
+    break;
+  }
+}
+
+void
+ShapeBatchFloat::areas(ShapeKind kind, float * out) const {
+  areas(kind, 0, size(kind), out);
+}
+
+void
+ShapeBatchFloat::areas(float * out) const {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    areas(kind, out);
+    out += size(kind);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::perimeters()
+ *  the ShapeBatchView::perimeters() expressions.
+ */
+void
+ShapeBatchFloat::perimeters(ShapeKind kind, std::size_t first, std::size_t n,
+                            float * out) const {
+  namespace sk = shape_kernels;
+  auto const f = [&](std::size_t field) { return col(kind, field).data() + first; };
+
+  switch (kind) {
+  case ShapeKind::rectangle:
+    sk::sum4(f(0), f(1), f(0), f(1), out, n);
+    break;
+
+  case ShapeKind::square:
+    sk::sum4(f(0), f(0), f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::parallelogram:
+    sk::sum4(f(1), f(2), f(1), f(2), out, n);
+    break;
+
+  case ShapeKind::circle:
+    sk::scaled_sum(pi_f, f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::triangle:
+    sk::sum3(f(0), f(2), f(3), out, n);
+    break;
+
+  case ShapeKind::right_triangle:
+    sk::sum3(f(0), f(1), f(2), out, n);
+    break;
+
+  case ShapeKind::isosceles_triangle:
+    sk::sum3(f(0), f(2), f(2), out, n);
+    break;
+
+  case ShapeKind::equilateral_triangle:
+    sk::sum3(f(0), f(0), f(0), out, n);
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    sk::sum3(f(0), f(0), f(1), out, n);
+    break;
+  }
+}
+
+void
+ShapeBatchFloat::perimeters(ShapeKind kind, float * out) const {
+  perimeters(kind, 0, size(kind), out);
+}
+
+void
+ShapeBatchFloat::perimeters(float * out) const {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    perimeters(kind, out);
+    out += size(kind);
+  }
+}
+
+/*
+ *  MARK: ShapeBatchFloat::total_area()
+ *  block by block, so the values never need a full-size buffer.
+ */
+double
+ShapeBatchFloat::total_area(Accumulator accumulator) const {
+  float values[total_block];
+  float single = 0;
+  double widened = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    for (std::size_t first = 0; first < size(kind); first += total_block) {
+      auto const n = std::min(total_block, size(kind) - first);
+      areas(kind, first, n, values);
+      if (accumulator == Accumulator::single) {
+        single += shape_kernels::sum(values, n);
+      }
+      else {
+        widened += shape_kernels::widened_sum(values, n);
+      }
+    }
+  }
+  return accumulator == Accumulator::single ? single : widened;
+}
+
+/*
+ *  MARK: ShapeBatchFloat::total_perimeter()
+ */
+double
+ShapeBatchFloat::total_perimeter(Accumulator accumulator) const {
+  float values[total_block];
+  float single = 0;
+  double widened = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    for (std::size_t first = 0; first < size(kind); first += total_block) {
+      auto const n = std::min(total_block, size(kind) - first);
+      perimeters(kind, first, n, values);
+      if (accumulator == Accumulator::single) {
+        single += shape_kernels::sum(values, n);
+      }
+      else {
+        widened += shape_kernels::widened_sum(values, n);
+      }
+    }
+  }
+  return accumulator == Accumulator::single ? single : widened;
+}
@@ -0,0 +1,99 @@
+//
+//  ShapeBatchFloat.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:06:21.9347
+//
+//  Single-precision storage for batch collections.
+//
+//  ShapeBatchFloat has the ShapeBatch column layout with float fields:
+//  half the bytes per shape, and twice the lanes per vector in the
+//  area and perimeter kernels.  Derived fields are computed in float
+//  from the narrowed constructor arguments.  Results are meant for
+//  display and dashboards, not for values that must match area() and
+//  perimeter().
+//
+//  Every stored field and every area and perimeter is within
+//  float_tolerance of the double result for the same shape, relative,
+//  as long as the dimensions and their squares are normal floats
+//  (about 1.1e-19 to 1.8e19); bench/BenchFloat.cpp measures it.  NaN
+//  propagates as in the double kernels.
+//
+//  Totals are sums of the float values in float accumulators, or
+//  widened to double first.  Every float addition may round, so on
+//  large batches the float total can drift past float_tolerance; the
+//  widened total stays within it.
+//
+
+#ifndef ShapeBatchFloat_hpp
+#define ShapeBatchFloat_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+
+//  MARK: - Definitions.
+//  relative error bound of a stored field, area or perimeter, 2^-21
+constexpr double float_tolerance = 1.0 / (1 << 21);
+
+/*
+ *  MARK: enum Accumulator
+ */
+enum class Accumulator : std::uint8_t {
+  single,
+  widened,
+};
+
+/*
+ *  MARK: Class ShapeBatchFloat
+ */
+class ShapeBatchFloat {
+public:
+  using Column = std::vector<float>;
+
+  ShapeBatchFloat() = default;
+  explicit ShapeBatchFloat(ShapeBatchView const & batch) { append(batch); }
+
+  //  as ShapeBatch::append(), arguments rounded to float
+  bool append(ShapeKind kind, double const * params, std::size_t count);
+  //  every shape of batch, after the ones already held
+  void append(ShapeBatchView const & batch);
+
+  void reserve(ShapeKind kind, std::size_t n);
+  void clear();
+
+  std::size_t size() const;
+  std::size_t size(ShapeKind kind) const;
+  std::span<float const> column(ShapeKind kind, std::size_t field) const;
+
+  //  out must hold size(kind) values
+  void areas(ShapeKind kind, float * out) const;
+  void perimeters(ShapeKind kind, float * out) const;
+
+  //  out must hold size() values, kinds laid out in ShapeKind order
+  void areas(float * out) const;
+  void perimeters(float * out) const;
+
+  double total_area(Accumulator accumulator = Accumulator::widened) const;
+  double total_perimeter(Accumulator accumulator = Accumulator::widened) const;
+
+protected:
+  //  hide implementation details from the interface
+  Column & col(ShapeKind kind, std::size_t field);
+  Column const & col(ShapeKind kind, std::size_t field) const;
+
+  //  rows [first, first + n) of kind
+  void areas(ShapeKind kind, std::size_t first, std::size_t n, float * out) const;
+  void perimeters(ShapeKind kind, std::size_t first, std::size_t n, float * out) const;
+  //  derived fields of rows [first, size(kind)) from their arguments
+  void derive(ShapeKind kind, std::size_t first);
+
+  std::array<std::array<Column, 4>, shape_kind_count> columns_;
+};
+
+#endif /* ShapeBatchFloat_hpp */
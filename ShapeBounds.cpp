@@ -0,0 +1,165 @@
+//
+//  ShapeBounds.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:05:51.2087
+//
+
+#include "ShapeBounds.hpp"
+#include "Shapes.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: fields()
+ *  a value's members in layout_of() order.
+ */
+std::array<double, 4> fields(RectangleValue const & s) { return { s.length, s.breadth }; }
+std::array<double, 4> fields(SquareValue const & s) { return { s.length }; }
+std::array<double, 4> fields(ParallelogramValue const & s) { return { s.height, s.base, s.side }; }
+std::array<double, 4> fields(CircleValue const & s) { return { s.radius }; }
+std::array<double, 4> fields(TriangleValue const & s) {
+  return { s.base, s.height, s.sideA, s.sideB };
+}
+std::array<double, 4> fields(RightTriangleValue const & s) {
+  return { s.base, s.height, s.hypotenuse };
+}
+std::array<double, 4> fields(IsoscelesTriangleValue const & s) {
+  return { s.base, s.height, s.side };
+}
+std::array<double, 4> fields(EquilateralTriangleValue const & s) { return { s.base, s.height }; }
+std::array<double, 4> fields(RightIsoscelesTriangleValue const & s) {
+  return { s.height, s.hypotenuse };
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: outline() - fields
+ */
+Outline
+outline(ShapeKind kind, double const * f, Placement const & at) {
+  Outline o;
+  auto const corners = [&o](std::initializer_list<Point> local) {
+    for (auto const & p : local) {
+      o.corners[o.size++] = p;
+    }
+  };
+
+  switch (kind) {
+  case ShapeKind::rectangle:
+    corners({ { 0, 0 }, { f[0], 0 }, { f[0], f[1] }, { 0, f[1] } });
+    break;
+  case ShapeKind::square:
+    corners({ { 0, 0 }, { f[0], 0 }, { f[0], f[0] }, { 0, f[0] } });
+    break;
+  case ShapeKind::parallelogram: {
+    auto const d = std::sqrt(f[2] * f[2] - f[0] * f[0]);
+    corners({ { 0, 0 }, { f[1], 0 }, { f[1] + d, f[0] }, { d, f[0] } });
+    break;
+  }
+  case ShapeKind::circle:
+    o.centre = { at.x, at.y };
+    o.radius = f[0];
+    return o;
+  case ShapeKind::triangle: {
+    auto const d = std::isnan(f[2]) || std::isnan(f[3])
+                   ? f[0] / 2
+                   : (f[0] * f[0] + f[2] * f[2] - f[3] * f[3]) / (2 * f[0]);
+    corners({ { 0, 0 }, { f[0], 0 }, { d, f[1] } });
+    break;
+  }
+  case ShapeKind::right_triangle:
+    corners({ { 0, 0 }, { f[0], 0 }, { 0, f[1] } });
+    break;
+  case ShapeKind::isosceles_triangle:
+  case ShapeKind::equilateral_triangle:
+    corners({ { 0, 0 }, { f[0], 0 }, { f[0] / 2, f[1] } });
+    break;
+  case ShapeKind::right_isosceles_triangle:
+    corners({ { 0, 0 }, { f[0], 0 }, { 0, f[0] } });
+    break;
+  }
+
+  auto const c = std::cos(at.angle);
+  auto const s = std::sin(at.angle);
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    auto const p = o.corners[i];
+    o.corners[i] = { at.x + (c * p.x - s * p.y), at.y + (s * p.x + c * p.y) };
+  }
+  return o;
+}
+
+/*
+ *  MARK: outline() - ShapeValue
+ */
+Outline
+outline(ShapeValue const & shape, Placement const & at) {
+  auto const f = std::visit([](auto const & s) { return fields(s); }, shape);
+  return outline(static_cast<ShapeKind>(shape.index()), f.data(), at);
+}
+
+/*
+ *  MARK: outline() - Shape
+ */
+Outline
+outline(Shape const & shape, Placement const & at) {
+  return outline(to_shape_value(shape), at);
+}
+
+/*
+ *  MARK: bounds() - Outline
+ */
+Box
+bounds(Outline const & o) {
+  Box box;
+  if (o.size == 0) {
+    box = { o.centre.x - o.radius, o.centre.y - o.radius,
+            o.centre.x + o.radius, o.centre.y + o.radius };
+  }
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    box.merge(o.corners[i].x, o.corners[i].y);
+  }
+  //  std::min/max drop a NaN corner; the box must not
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    if (std::isnan(o.corners[i].x) || std::isnan(o.corners[i].y)) {
+      box.min_x = box.min_y = box.max_x = box.max_y = NAN;
+    }
+  }
+  return box;
+}
+
+/*
+ *  MARK: bounds() - ShapeBatchView
+ */
+void
+bounds(ShapeBatchView const & batch, std::span<Placement const> at, Box * out) {
+  if (at.size() != batch.size()) {
+    throw std::invalid_argument("bounds: one placement per shape is required"s);
+  }
+  std::size_t row = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const & layout = layout_of(kind);
+    std::array<ShapeBatchView::Column, 4> columns;
+    for (std::size_t f = 0; f < layout.fields; ++f) {
+      columns[f] = batch.column(kind, f);
+    }
+    for (std::size_t i = 0; i < batch.size(kind); ++i, ++row) {
+      double f[4] {};
+      for (std::size_t j = 0; j < layout.fields; ++j) {
+        f[j] = columns[j][i];
+      }
+      out[row] = bounds(outline(kind, f, at[row]));
+    }
+  }
+}
@@ -0,0 +1,142 @@
+//
+//  ShapeBounds.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:05:51.2087
+//
+//  Placement and axis-aligned bounding boxes.
+//
+//  A shape's dimensions fix its local outline; a Placement puts that
+//  outline in the plane, rotated by angle (radians, counter-clockwise)
+//  about the local origin and then moved to (x, y).  Placements are
+//  kept beside the shapes, as the batch keeps its columns, rather than
+//  in every object.
+//
+//  Local outlines, corners counter-clockwise from the origin:
+//    Rectangle, Square       (0, 0) (length, 0) (length, breadth) (0, breadth)
+//    Parallelogram           (0, 0) (base, 0) (base + d, height) (d, height),
+//                            d = sqrt(side^2 - height^2)
+//    Triangle                (0, 0) (base, 0) (d, height), d from the law of
+//                            cosines when both sides are known, base / 2
+//                            otherwise
+//    RightTriangle           (0, 0) (base, 0) (0, height)
+//    IsoscelesTriangle,
+//    EquilateralTriangle     (0, 0) (base, 0) (base / 2, height)
+//    RightIsoscelesTriangle  (0, 0) (height, 0) (0, height)
+//    Circle                  centred on the origin
+//
+
+#ifndef ShapeBounds_hpp
+#define ShapeBounds_hpp
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "ShapeBatch.hpp"
+#include "ShapeValue.hpp"
+
+class Shape;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: struct Point
+ */
+struct Point {
+  double x;
+  double y;
+};
+
+/*
+ *  MARK: struct Placement
+ */
+struct Placement {
+  double x = 0;
+  double y = 0;
+  double angle = 0;
+};
+
+/*
+ *  MARK: struct Box
+ *  closed; the default box is empty, as is one with a NaN edge.
+ */
+struct Box {
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+
+  bool empty() const noexcept {
+    return !(min_x <= max_x && min_y <= max_y);
+  }
+
+  bool contains(double x, double y) const noexcept {
+    return min_x <= x && x <= max_x && min_y <= y && y <= max_y;
+  }
+
+  bool overlaps(Box const & other) const noexcept {
+    return min_x <= other.max_x && other.min_x <= max_x
+           && min_y <= other.max_y && other.min_y <= max_y;
+  }
+
+  void merge(Box const & other) noexcept {
+    min_x = std::min(min_x, other.min_x);
+    min_y = std::min(min_y, other.min_y);
+    max_x = std::max(max_x, other.max_x);
+    max_y = std::max(max_y, other.max_y);
+  }
+
+  void merge(double x, double y) noexcept {
+    min_x = std::min(min_x, x);
+    min_y = std::min(min_y, y);
+    max_x = std::max(max_x, x);
+    max_y = std::max(max_y, y);
+  }
+
+  //  half the perimeter: the surface area heuristic's measure in 2D
+  double margin() const noexcept {
+    return (max_x - min_x) + (max_y - min_y);
+  }
+
+  //  squared distance from (x, y), 0 inside
+  double distance2(double x, double y) const noexcept {
+    auto const dx = std::max({ min_x - x, 0.0, x - max_x });
+    auto const dy = std::max({ min_y - y, 0.0, y - max_y });
+    return dx * dx + dy * dy;
+  }
+};
+
+/*
+ *  MARK: struct Outline
+ *  a placed shape: size corners, or for a circle (size 0) a centre and
+ *  radius.
+ */
+struct Outline {
+  std::array<Point, 4> corners {};
+  std::uint8_t size = 0;
+  Point centre {};
+  double radius = 0;
+};
+
+//  fields as in layout_of(kind)
+Outline outline(ShapeKind kind, double const * fields, Placement const & at = {});
+Outline outline(ShapeValue const & shape, Placement const & at = {});
+Outline outline(Shape const & shape, Placement const & at = {});
+
+Box bounds(Outline const & outline);
+
+inline Box bounds(ShapeValue const & shape, Placement const & at = {}) {
+  return bounds(outline(shape, at));
+}
+
+inline Box bounds(Shape const & shape, Placement const & at = {}) {
+  return bounds(outline(shape, at));
+}
+
+//  at and out hold size() entries, kinds laid out in ShapeKind order
+void bounds(ShapeBatchView const & batch, std::span<Placement const> at, Box * out);
+
+#endif /* ShapeBounds_hpp */
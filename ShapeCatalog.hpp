@@ -0,0 +1,117 @@
+//
+//  ShapeCatalog.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 22:36:05.4418
+//
+//  Compile-time tables of fixed shapes.
+//
+//  make_catalog() takes named ShapeValues and works out area, perimeter
+//  and dimensions for each one.  Bind the result to a constexpr variable
+//  and the whole table is a constant in the binary; lookup() by name is
+//  constexpr too, so a static_assert or a template argument can use it.
+//
+//    constexpr auto panels = make_catalog({
+//      { "door",   RectangleValue(2040, 826) },
+//      { "brace",  RightTriangleValue(600, 450) },
+//      { "port",   CircleValue(150) },
+//    });
+//    constexpr double port = lookup(panels, "port")->area;
+//
+//  MARK: - References.
+//  @see: https://en.wikipedia.org/wiki/ISO_216
+//
+
+#ifndef ShapeCatalog_hpp
+#define ShapeCatalog_hpp
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "ShapeBatch.hpp"
+#include "ShapeValue.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: struct CatalogItem
+ *  what a catalog is built from.
+ */
+struct CatalogItem {
+  std::string_view name;
+  ShapeValue shape;
+};
+
+/*
+ *  MARK: struct CatalogShape
+ */
+struct CatalogShape {
+  std::string_view name;
+  ShapeValue shape;
+  double area;
+  double perimeter;
+  ShapeDimensions dimensions;
+
+  constexpr ShapeKind kind() const noexcept {
+    return static_cast<ShapeKind>(shape.index());
+  }
+};
+
+/*
+ *  MARK: make_catalog()
+ */
+template <std::size_t N>
+constexpr std::array<CatalogShape, N>
+make_catalog(CatalogItem const (&items)[N]) {
+  std::array<CatalogShape, N> catalog {};
+  for (std::size_t i = 0; i < N; ++i) {
+    auto const & shape = items[i].shape;
+    catalog[i] = { items[i].name, shape, area(shape), perimeter(shape), dimensions(shape) };
+  }
+  return catalog;
+}
+
+/*
+ *  MARK: lookup()
+ *  nullptr if no entry has that name.
+ */
+template <std::size_t N>
+constexpr CatalogShape const *
+lookup(std::array<CatalogShape, N> const & catalog, std::string_view name) noexcept {
+  for (auto const & entry : catalog) {
+    if (entry.name == name) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ *  MARK: namespace shape_catalog
+ *  standard tables.
+ */
+namespace shape_catalog {
+
+//  ISO 216 A series, millimetres, portrait
+inline constexpr auto iso216_a = make_catalog({
+  { "A0", RectangleValue(841, 1189) },
+  { "A1", RectangleValue(594, 841) },
+  { "A2", RectangleValue(420, 594) },
+  { "A3", RectangleValue(297, 420) },
+  { "A4", RectangleValue(210, 297) },
+  { "A5", RectangleValue(148, 210) },
+  { "A6", RectangleValue(105, 148) },
+  { "A7", RectangleValue(74, 105) },
+  { "A8", RectangleValue(52, 74) },
+  { "A9", RectangleValue(37, 52) },
+  { "A10", RectangleValue(26, 37) },
+});
+
+static_assert(lookup(iso216_a, "A4")->area == 210.0 * 297.0);
+static_assert(lookup(iso216_a, "A4")->perimeter == 1014.0);
+static_assert(lookup(iso216_a, "B5") == nullptr);
+
+} /* namespace shape_catalog */
+
+#endif /* ShapeCatalog_hpp */
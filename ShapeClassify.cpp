@@ -0,0 +1,138 @@
+//
+//  ShapeClassify.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 08:03:44.2716
+//
+
+#include "ShapeClassify.hpp"
+#include "ShapeKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+//  rows per kernel call
+constexpr std::size_t block = 4096;
+
+/*
+ *  MARK: kind_of()
+ *  the most particular kind the flags of a valid row allow.
+ */
+ShapeKind kind_of(std::uint8_t flags) noexcept {
+  using namespace shape_kernels;
+  if (flags & triangle_equilateral) {
+    return ShapeKind::equilateral_triangle;
+  }
+  if (flags & triangle_right_isosceles) {
+    return ShapeKind::right_isosceles_triangle;
+  }
+  if (flags & triangle_right) {
+    return ShapeKind::right_triangle;
+  }
+  if (flags & triangle_isosceles) {
+    return ShapeKind::isosceles_triangle;
+  }
+  return ShapeKind::triangle;
+}
+
+/*
+ *  MARK: struct Sides
+ *  lo <= mid <= hi.
+ */
+struct Sides {
+  double lo;
+  double mid;
+  double hi;
+};
+
+Sides sorted(double a, double b, double c) noexcept {
+  auto const ab = std::min(a, b);
+  auto const top = std::max(a, b);
+  auto const rest = std::min(top, c);
+  return { std::min(ab, rest), std::max(ab, rest), std::max(top, c) };
+}
+
+} /* namespace */
+
+//  MARK: - Class TriangleClassifier Implementation.
+/*
+ *  MARK: TriangleClassifier::TriangleClassifier()
+ *  the kernel a block at a time, each block's rows filed as it is done.
+ */
+TriangleClassifier::TriangleClassifier(std::span<double const> a, std::span<double const> b,
+                                       std::span<double const> c, double tolerance, bool strict)
+  : a_(a), b_(b), c_(c) {
+  if (a.size() != b.size() || a.size() != c.size()) {
+    throw std::invalid_argument("TriangleClassifier: columns of "s + std::to_string(a.size())
+                                + ", "s + std::to_string(b.size()) + " and "s
+                                + std::to_string(c.size()) + " rows"s);
+  }
+  if (!(tolerance >= 0)) {
+    throw std::invalid_argument("TriangleClassifier: bad tolerance "s + std::to_string(tolerance));
+  }
+  if (a.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    throw std::length_error("TriangleClassifier: too many rows, "s + std::to_string(a.size()));
+  }
+
+  auto const n = a.size();
+  area_.resize(n);
+  std::uint8_t flags[block];
+  for (std::size_t first = 0; first < n; first += block) {
+    auto const count = std::min(block, n - first);
+    shape_kernels::classify_triangles(a.data() + first, b.data() + first, c.data() + first,
+                                      tolerance, flags, area_.data() + first, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      auto const row = static_cast<std::uint32_t>(first + i);
+      if ((flags[i] & shape_kernels::triangle_valid) == 0) {
+        if (strict) {
+          throw std::invalid_argument("TriangleClassifier: row "s + std::to_string(row)
+                                      + " is not a triangle"s);
+        }
+        rejected_.push_back(row);
+        continue;
+      }
+      members_[static_cast<std::size_t>(kind_of(flags[i]))].push_back(row);
+    }
+  }
+}
+
+/*
+ *  MARK: TriangleClassifier::build()
+ *  constructor arguments from the sorted sides and the area.
+ */
+void
+TriangleClassifier::build(ShapeBatch & batch) const {
+  auto const sides = [&](std::uint32_t i) { return sorted(a_[i], b_[i], c_[i]); };
+  for (auto const i : indices(ShapeKind::triangle)) {
+    auto const s = sides(i);
+    batch.add_triangle(s.hi, 2 * area_[i] / s.hi, s.mid, s.lo);
+  }
+  //  the right test only bounds the other leg; it comes from the area
+  for (auto const i : indices(ShapeKind::right_triangle)) {
+    auto const s = sides(i);
+    batch.add_right_triangle(s.mid, 2 * area_[i] / s.mid);
+  }
+  //  the base is the side left over by the closer pair
+  for (auto const i : indices(ShapeKind::isosceles_triangle)) {
+    auto const s = sides(i);
+    auto const base = s.mid - s.lo <= s.hi - s.mid ? s.hi : s.lo;
+    batch.add_isosceles_triangle(base, 2 * area_[i] / base);
+  }
+  for (auto const i : indices(ShapeKind::equilateral_triangle)) {
+    auto const s = sides(i);
+    batch.add_equilateral_triangle((s.lo + s.mid + s.hi) / 3);
+  }
+  for (auto const i : indices(ShapeKind::right_isosceles_triangle)) {
+    auto const s = sides(i);
+    batch.add_right_isosceles_triangle((s.lo + s.mid) / 2);
+  }
+}
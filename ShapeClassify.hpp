@@ -0,0 +1,99 @@
+//
+//  ShapeClassify.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 08:03:44.2716
+//
+//  Triangles from raw side lengths.
+//
+//  A TriangleClassifier takes three columns of side lengths, a, b and c,
+//  one triangle per row, and works out in one vector pass
+//  (shape_kernels::classify_triangles()) which rows are triangles,
+//  which of those are right, isosceles or equilateral, and the area of
+//  each by Heron's formula.  It then files every triangle under the
+//  most particular kind it fits:
+//
+//    equilateral               EquilateralTriangle
+//    right with equal legs     RightIsoscelesTriangle
+//    right                     RightTriangle
+//    isosceles                 IsoscelesTriangle
+//    none of them              Triangle
+//
+//  and keeps, per kind, the ascending list of rows filed under it.
+//  build() appends the triangles to a ShapeBatch with the constructor
+//  arguments of their kind, kind by kind and each kind in list order,
+//  so the n-th row of a kind's columns is the n-th index of its list.
+//
+//  Tests are relative to the longest side: isosceles and equilateral
+//  when sides differ by at most tolerance times it, right when
+//  lo^2 + mid^2 - hi^2 is within tolerance times its square.  The legs
+//  of a right triangle are the two shorter sides, so a thin isosceles
+//  triangle that passes the right test, its two long sides equal, is a
+//  RightTriangle and not a RightIsoscelesTriangle.  A side that should
+//  be equal to another is given as the mean of the two (or three) it
+//  stands for.  Heights come from the Heron area, so a built Triangle,
+//  RightTriangle or IsoscelesTriangle has the classifier's area() to
+//  rounding; the other two are within the tolerance of it.
+//
+//  MARK: - References.
+//  @see: Kahan, "Miscalculating Area and Angles of a Needle-like
+//        Triangle", 2014.
+//
+
+#ifndef ShapeClassify_hpp
+#define ShapeClassify_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class TriangleClassifier
+ *
+ *  A row is rejected unless its sides are positive and finite and the
+ *  longest is shorter than the other two together.  A strict
+ *  classifier throws std::invalid_argument naming the first one; others
+ *  leave it out and list it in rejected().  Columns of different
+ *  lengths or a negative or NaN tolerance throw std::invalid_argument,
+ *  2^32 rows or more std::length_error.  The columns are read again by
+ *  build() and must outlive the classifier.
+ */
+class TriangleClassifier {
+public:
+  TriangleClassifier(std::span<double const> a, std::span<double const> b,
+                     std::span<double const> c, double tolerance = 1e-9, bool strict = true);
+
+  //  rows taken in
+  std::size_t rows() const noexcept { return area_.size(); }
+  //  triangles accepted
+  std::size_t size() const noexcept { return rows() - rejected_.size(); }
+
+  //  rows filed under kind, ascending; empty for a kind not a triangle
+  std::span<std::uint32_t const> indices(ShapeKind kind) const noexcept {
+    return members_[static_cast<std::size_t>(kind)];
+  }
+  //  rows left out, ascending
+  std::span<std::uint32_t const> rejected() const noexcept { return rejected_; }
+  //  Heron's area of every row, NaN for those left out
+  std::span<double const> areas() const noexcept { return area_; }
+
+  //  every accepted triangle appended to batch
+  void build(ShapeBatch & batch) const;
+
+protected:
+  //  hide implementation details from the interface
+  std::span<double const> a_;
+  std::span<double const> b_;
+  std::span<double const> c_;
+  std::vector<double> area_;
+  std::array<std::vector<std::uint32_t>, shape_kind_count> members_;
+  std::vector<std::uint32_t> rejected_;
+};
+
+#endif /* ShapeClassify_hpp */
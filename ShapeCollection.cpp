@@ -0,0 +1,432 @@
+//
+//  ShapeCollection.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:02:48.3361
+//
+
+#include "ShapeCollection.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: neumaier()
+ *  sum + compensation += value.  Past the finite range the sum alone
+ *  carries the result; the compensation would be inf - inf.
+ */
+void neumaier(double & sum, double & compensation, double value) {
+  auto const t = sum + value;
+  if (!std::isfinite(t)) {
+    sum = t;
+    return;
+  }
+  if (std::abs(sum) >= std::abs(value)) {
+    compensation += (sum - t) + value;
+  }
+  else {
+    compensation += (value - t) + sum;
+  }
+  sum = t;
+}
+
+/*
+ *  MARK: close()
+ */
+bool close(double value, double reference, double tolerance) {
+  return value == reference || (std::isnan(value) && std::isnan(reference))
+      || std::abs(value - reference) <= tolerance * std::abs(reference);
+}
+
+bool close(Summary const & a, Summary const & b, double tolerance) {
+  return a.count == b.count && a.nan == b.nan && a.min == b.min && a.max == b.max
+      && close(a.total, b.total, tolerance);
+}
+
+} /* namespace */
+
+//  MARK: - Class ShapeCollection::Measure Implementation.
+/*
+ *  MARK: ShapeCollection::Measure::add()
+ */
+void
+ShapeCollection::Measure::add(double value) {
+  if (std::isnan(value)) {
+    ++nan;
+    return;
+  }
+  ++count;
+  if (std::isinf(value)) {
+    ++(value > 0 ? plus_inf : minus_inf);
+    return;
+  }
+  neumaier(sum, compensation, value);
+}
+
+/*
+ *  MARK: ShapeCollection::Measure::remove()
+ *  value must have been added.
+ */
+void
+ShapeCollection::Measure::remove(double value) {
+  if (std::isnan(value)) {
+    --nan;
+    return;
+  }
+  if (std::isinf(value)) {
+    --(value > 0 ? plus_inf : minus_inf);
+  }
+  if (--count == 0) {
+    sum = compensation = 0;
+    return;
+  }
+  if (!std::isinf(value)) {
+    neumaier(sum, compensation, -value);
+  }
+}
+
+/*
+ *  MARK: ShapeCollection::Measure::total()
+ *  an infinity held overrides the sum; both signs make NaN.
+ */
+double
+ShapeCollection::Measure::total() const noexcept {
+  if (plus_inf != 0 && minus_inf != 0) {
+    return NAN;
+  }
+  if (plus_inf != 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (minus_inf != 0) {
+    return -std::numeric_limits<double>::infinity();
+  }
+  return sum + compensation;
+}
+
+//  MARK: - Class ShapeCollection::Extremes Implementation.
+/*
+ *  MARK: ShapeCollection::Extremes::of()
+ */
+ShapeCollection::Extremes
+ShapeCollection::Extremes::of(double area, double perimeter) {
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  return { std::isnan(area) ? inf : area, std::isnan(area) ? -inf : area,
+           std::isnan(perimeter) ? inf : perimeter, std::isnan(perimeter) ? -inf : perimeter };
+}
+
+/*
+ *  MARK: ShapeCollection::Extremes::merge()
+ */
+ShapeCollection::Extremes
+ShapeCollection::Extremes::merge(Extremes const & a, Extremes const & b) {
+  return { std::min(a.area_min, b.area_min), std::max(a.area_max, b.area_max),
+           std::min(a.perimeter_min, b.perimeter_min),
+           std::max(a.perimeter_max, b.perimeter_max) };
+}
+
+//  MARK: - Class ShapeCollection Implementation.
+/*
+ *  MARK: ShapeCollection::slot()
+ */
+ShapeCollection::Slot &
+ShapeCollection::slot(ShapeId id) {
+  if (id >= slots_.size() || !slots_[id].live) {
+    throw std::out_of_range("ShapeCollection: no shape with id "s + std::to_string(id));
+  }
+  return slots_[id];
+}
+
+ShapeCollection::Slot const &
+ShapeCollection::slot(ShapeId id) const {
+  return const_cast<ShapeCollection *>(this)->slot(id);
+}
+
+/*
+ *  MARK: ShapeCollection::set_leaf()
+ *  climbs while the node above changes.
+ */
+void
+ShapeCollection::set_leaf(Kind & kind, std::size_t position, Extremes const & leaf) {
+  auto & tree = kind.tree;
+  auto i = tree.size() / 2 + position;
+  tree[i] = leaf;
+  for (i /= 2; i >= 1; i /= 2) {
+    auto const node = Extremes::merge(tree[2 * i], tree[2 * i + 1]);
+    if (node == tree[i]) {
+      break;
+    }
+    tree[i] = node;
+  }
+}
+
+/*
+ *  MARK: ShapeCollection::add()
+ *  id goes last among its kind.  A full tree doubles its leaves and is
+ *  rebuilt bottom up.
+ */
+void
+ShapeCollection::add(ShapeId id) {
+  auto & s = slots_[id];
+  auto & kind = kinds_[s.value.index()];
+  kind.area.add(s.area);
+  kind.perimeter.add(s.perimeter);
+  s.position = static_cast<std::uint32_t>(kind.members.size());
+  kind.members.push_back(id);
+
+  auto & tree = kind.tree;
+  if (s.position >= tree.size() / 2) {
+    auto const leaves = std::max<std::size_t>(tree.size(), 16);
+    tree.assign(2 * leaves, Extremes::of(NAN, NAN));
+    for (std::size_t p = 0; p < s.position; ++p) {
+      auto const & member = slots_[kind.members[p]];
+      tree[leaves + p] = Extremes::of(member.area, member.perimeter);
+    }
+    for (auto i = leaves - 1; i >= 1; --i) {
+      tree[i] = Extremes::merge(tree[2 * i], tree[2 * i + 1]);
+    }
+  }
+  set_leaf(kind, s.position, Extremes::of(s.area, s.perimeter));
+}
+
+/*
+ *  MARK: ShapeCollection::subtract()
+ *  the last of the kind moves into the gap.
+ */
+void
+ShapeCollection::subtract(ShapeId id) {
+  auto const & s = slots_[id];
+  auto & kind = kinds_[s.value.index()];
+  kind.area.remove(s.area);
+  kind.perimeter.remove(s.perimeter);
+
+  auto const last = kind.members.size() - 1;
+  if (s.position != last) {
+    auto const moved = kind.members[last];
+    kind.members[s.position] = moved;
+    slots_[moved].position = s.position;
+    set_leaf(kind, s.position, kind.tree[kind.tree.size() / 2 + last]);
+  }
+  kind.members.pop_back();
+  set_leaf(kind, last, Extremes::of(NAN, NAN));
+}
+
+/*
+ *  MARK: ShapeCollection::insert()
+ */
+ShapeId
+ShapeCollection::insert(ShapeValue const & value) {
+  ShapeId id;
+  if (free_.empty()) {
+    if (slots_.size() > std::numeric_limits<ShapeId>::max()) {
+      throw std::length_error("ShapeCollection::insert: out of ids"s);
+    }
+    id = static_cast<ShapeId>(slots_.size());
+    slots_.push_back({ value, area(value), perimeter(value), 0, true });
+  }
+  else {
+    id = free_.back();
+    free_.pop_back();
+    slots_[id] = { value, area(value), perimeter(value), 0, true };
+  }
+  add(id);
+  ++size_;
+  return id;
+}
+
+ShapeId
+ShapeCollection::insert(Shape const & shape) {
+  return insert(to_shape_value(shape));
+}
+
+/*
+ *  MARK: ShapeCollection::update()
+ *  a shape that keeps its kind keeps its leaf.
+ */
+void
+ShapeCollection::update(ShapeId id, ShapeValue const & value) {
+  auto & s = slot(id);
+  if (s.value.index() != value.index()) {
+    subtract(id);
+    s = { value, area(value), perimeter(value), 0, true };
+    add(id);
+    return;
+  }
+  auto & kind = kinds_[value.index()];
+  kind.area.remove(s.area);
+  kind.perimeter.remove(s.perimeter);
+  s.value = value;
+  s.area = area(value);
+  s.perimeter = perimeter(value);
+  kind.area.add(s.area);
+  kind.perimeter.add(s.perimeter);
+  set_leaf(kind, s.position, Extremes::of(s.area, s.perimeter));
+}
+
+/*
+ *  MARK: ShapeCollection::remove()
+ */
+void
+ShapeCollection::remove(ShapeId id) {
+  slot(id);
+  subtract(id);
+  slots_[id].live = false;
+  free_.push_back(id);
+  --size_;
+}
+
+/*
+ *  MARK: ShapeCollection::clear()
+ */
+void
+ShapeCollection::clear() {
+  slots_.clear();
+  free_.clear();
+  kinds_ = {};
+  size_ = 0;
+}
+
+/*
+ *  MARK: ShapeCollection::contains()
+ */
+bool
+ShapeCollection::contains(ShapeId id) const noexcept {
+  return id < slots_.size() && slots_[id].live;
+}
+
+/*
+ *  MARK: ShapeCollection::operator[]()
+ */
+ShapeValue const &
+ShapeCollection::operator[](ShapeId id) const {
+  return slot(id).value;
+}
+
+/*
+ *  MARK: ShapeCollection::result()
+ *  a kind's statistics from its totals and the root of its tree.
+ */
+Aggregate
+ShapeCollection::result(Kind const & kind) {
+  auto const root = kind.tree.empty() ? Extremes::of(NAN, NAN) : kind.tree[1];
+  Summary area;
+  area.count = kind.area.count;
+  area.nan = kind.area.nan;
+  area.total = kind.area.total();
+  area.min = root.area_min;
+  area.max = root.area_max;
+  Summary perimeter;
+  perimeter.count = kind.perimeter.count;
+  perimeter.nan = kind.perimeter.nan;
+  perimeter.total = kind.perimeter.total();
+  perimeter.min = root.perimeter_min;
+  perimeter.max = root.perimeter_max;
+  return { kind.members.size(), area, perimeter };
+}
+
+/*
+ *  MARK: ShapeCollection::statistics()
+ *  one kind, read from its running state.
+ */
+Aggregate
+ShapeCollection::statistics(ShapeKind kind) const {
+  return result(kinds_[static_cast<std::size_t>(kind)]);
+}
+
+/*
+ *  MARK: ShapeCollection::statistics()
+ *  the whole collection from the kinds: counts add, totals are summed
+ *  compensated, min and max are the least and greatest of the kinds'.
+ */
+BatchAggregate
+ShapeCollection::statistics() const {
+  BatchAggregate stats;
+  double compensation[2] = {};
+  auto const merge = [](Summary & all, Summary const & s, double & compensation) {
+    all.count += s.count;
+    all.nan += s.nan;
+    neumaier(all.total, compensation, s.total);
+    all.min = std::min(all.min, s.min);
+    all.max = std::max(all.max, s.max);
+  };
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const & kind = stats.kinds[k] = result(kinds_[k]);
+    stats.all.count += kind.count;
+    merge(stats.all.area, kind.area, compensation[0]);
+    merge(stats.all.perimeter, kind.perimeter, compensation[1]);
+  }
+  stats.all.area.total += compensation[0];
+  stats.all.perimeter.total += compensation[1];
+  return stats;
+}
+
+/*
+ *  MARK: ShapeCollection::consistent()
+ *  area and perimeter are worked out again too, not taken from the
+ *  slots, and every shape must sit at its position in its kind.
+ */
+bool
+ShapeCollection::consistent(double tolerance) const {
+  struct Fresh {
+    std::size_t count = 0;
+    Measure area;
+    Measure perimeter;
+    Extremes extremes = Extremes::of(NAN, NAN);
+  };
+  std::array<Fresh, shape_kind_count> fresh;
+  std::size_t live = 0;
+  for (ShapeId id = 0; id < slots_.size(); ++id) {
+    auto const & s = slots_[id];
+    if (!s.live) {
+      continue;
+    }
+    auto const k = s.value.index();
+    if (s.position >= kinds_[k].members.size() || kinds_[k].members[s.position] != id) {
+      return false;
+    }
+    auto const a = area(s.value);
+    auto const p = perimeter(s.value);
+    ++fresh[k].count;
+    fresh[k].area.add(a);
+    fresh[k].perimeter.add(p);
+    fresh[k].extremes = Extremes::merge(fresh[k].extremes, Extremes::of(a, p));
+    ++live;
+  }
+  if (live != size_ || live + free_.size() != slots_.size()) {
+    return false;
+  }
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const running = result(kinds_[k]);
+    auto const & f = fresh[k];
+    auto const & e = f.extremes;
+    if (running.count != f.count
+        || !close(running.area, { f.area.count, f.area.nan, f.area.total(),
+                                  e.area_min, e.area_max }, tolerance)
+        || !close(running.perimeter, { f.perimeter.count, f.perimeter.nan, f.perimeter.total(),
+                                       e.perimeter_min, e.perimeter_max }, tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ *  MARK: ShapeCollection::recompute()
+ */
+void
+ShapeCollection::recompute() {
+  kinds_ = {};
+  for (ShapeId id = 0; id < slots_.size(); ++id) {
+    if (slots_[id].live) {
+      add(id);
+    }
+  }
+}
@@ -0,0 +1,142 @@
+//
+//  ShapeCollection.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:02:48.3361
+//
+//  A mutable collection whose statistics are always current.
+//
+//  ShapeCollection holds shapes as ShapeValues under stable ids and
+//  keeps the aggregate() statistics of ShapeAggregate.hpp up to date as
+//  shapes are inserted, removed and updated, so reading them never
+//  walks the collection.  Area and perimeter are those of the member
+//  functions, bit for bit, worked out once per change.
+//
+//  Totals per kind are compensated (Neumaier) sums, added to on insert
+//  and subtracted from on remove; a kind left empty goes back to an
+//  exact 0.  Infinite values are counted apart and kept out of the
+//  sums, so a total is +inf or -inf only while such a shape is held
+//  (NaN with both).  Min and max come from a tournament tree per
+//  kind: an implicit binary tree in one array, over the kind's shapes
+//  packed from position 0, each node holding the extremes below it.  A
+//  change rewrites one or two leaves and climbs only while a node
+//  changes, so it costs O(log n) at worst and a level or two for most
+//  values.  Reading statistics() costs O(kinds): each kind's totals and
+//  the root of its tree.
+//
+//  Long runs of changes can still leave totals a few ulps from a fresh
+//  sum.  consistent() recomputes everything from the shapes and
+//  compares; recompute() replaces the running state with that result.
+//
+//  Not thread-safe: use one collection per thread or lock around it.
+//
+//  MARK: - References.
+//  @see: Neumaier, "Rundungsfehleranalyse einiger Verfahren zur
+//        Summation endlicher Summen", ZAMM 54(1), 1974.
+//
+
+#ifndef ShapeCollection_hpp
+#define ShapeCollection_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ShapeAggregate.hpp"
+#include "ShapeBatch.hpp"
+#include "ShapeValue.hpp"
+
+//  MARK: - Definitions.
+//  reused after remove()
+using ShapeId = std::uint32_t;
+
+/*
+ *  MARK: Class ShapeCollection
+ *
+ *  update(), remove() and operator[] throw std::out_of_range for an id
+ *  not in the collection.
+ */
+class ShapeCollection {
+public:
+  ShapeId insert(ShapeValue const & value);
+  ShapeId insert(Shape const & shape);
+  void update(ShapeId id, ShapeValue const & value);
+  void remove(ShapeId id);
+  void clear();
+
+  bool contains(ShapeId id) const noexcept;
+  ShapeValue const & operator[](ShapeId id) const;
+  std::size_t size() const noexcept { return size_; }
+
+  //  as aggregate() over every shape held
+  BatchAggregate statistics() const;
+  Aggregate statistics(ShapeKind kind) const;
+
+  //  counts, min and max exactly, totals within tolerance, relative,
+  //  of a full recomputation
+  bool consistent(double tolerance = 1e-12) const;
+  void recompute();
+
+protected:
+  //  hide implementation details from the interface
+  struct Slot {
+    ShapeValue value;
+    double area;
+    double perimeter;
+    std::uint32_t position;   //  among the shapes of its kind
+    bool live;
+  };
+
+  /*
+   *  MARK: struct ShapeCollection::Measure
+   *  running total of one measure of one kind.
+   */
+  struct Measure {
+    void add(double value);
+    void remove(double value);
+    double total() const noexcept;
+
+    std::size_t count = 0;
+    std::size_t nan = 0;
+    std::size_t plus_inf = 0;    //  counted, kept out of the sum
+    std::size_t minus_inf = 0;
+    double sum = 0;
+    double compensation = 0;
+  };
+
+  //  a node of the tournament tree; an empty leaf or a NaN value is
+  //  +inf for min and -inf for max
+  struct Extremes {
+    double area_min;
+    double area_max;
+    double perimeter_min;
+    double perimeter_max;
+
+    static Extremes of(double area, double perimeter);
+    static Extremes merge(Extremes const & a, Extremes const & b);
+    bool operator==(Extremes const &) const = default;
+  };
+
+  struct Kind {
+    Measure area;
+    Measure perimeter;
+    std::vector<ShapeId> members;   //  id by position
+    std::vector<Extremes> tree;     //  root at 1, leaves from tree.size() / 2
+  };
+
+  Slot & slot(ShapeId id);
+  Slot const & slot(ShapeId id) const;
+  void add(ShapeId id);
+  void subtract(ShapeId id);
+  static void set_leaf(Kind & kind, std::size_t position, Extremes const & leaf);
+  static Aggregate result(Kind const & kind);
+
+  std::vector<Slot> slots_;
+  std::vector<ShapeId> free_;
+  std::array<Kind, shape_kind_count> kinds_;
+  std::size_t size_ = 0;
+};
+
+#endif /* ShapeCollection_hpp */
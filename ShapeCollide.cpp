@@ -0,0 +1,236 @@
+//
+//  ShapeCollide.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:58:14.5031
+//
+
+#include "ShapeCollide.hpp"
+#include "ShapeKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+namespace sk = shape_kernels;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: struct Edges
+ *  one edge function a * x + b * y + c per side, >= 0 inside.
+ */
+struct Edges {
+  double a[4];
+  double b[4];
+  double c[4];
+  std::size_t size = 0;
+};
+
+/*
+ *  MARK: twice_area()
+ *  signed, positive for a counter-clockwise outline.
+ */
+double twice_area(Outline const & o) {
+  double area = 0;
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    auto const & p = o.corners[i];
+    auto const & q = o.corners[(i + 1) % o.size];
+    area += p.x * q.y - q.x * p.y;
+  }
+  return area;
+}
+
+/*
+ *  MARK: usable()
+ *  false for a NaN coordinate, a negative radius or a polygon of
+ *  zero area.
+ */
+bool usable(Outline const & o) {
+  if (o.size == 0) {
+    return o.radius >= 0 && !std::isnan(o.centre.x) && !std::isnan(o.centre.y);
+  }
+  //  a NaN corner makes the area NaN
+  auto const area = twice_area(o);
+  return area < 0 || area > 0;
+}
+
+/*
+ *  MARK: edges()
+ *  empty when the polygon is not usable.
+ */
+Edges edges(Outline const & o) {
+  Edges e;
+  auto const area = twice_area(o);
+  if (!(area < 0 || area > 0)) {
+    return e;
+  }
+  auto const winding = area > 0 ? 1.0 : -1.0;
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    auto const & p = o.corners[i];
+    auto const & q = o.corners[(i + 1) % o.size];
+    e.a[i] = winding * (p.y - q.y);
+    e.b[i] = winding * (q.x - p.x);
+    e.c[i] = -(e.a[i] * p.x + e.b[i] * p.y);
+  }
+  e.size = o.size;
+  return e;
+}
+
+/*
+ *  MARK: project()
+ *  [lo, hi] of an outline on the axis (nx, ny).
+ */
+void project(Outline const & o, double nx, double ny, double & lo, double & hi) {
+  if (o.size == 0) {
+    auto const c = nx * o.centre.x + ny * o.centre.y;
+    auto const r = o.radius * std::hypot(nx, ny);
+    lo = c - r;
+    hi = c + r;
+    return;
+  }
+  lo = std::numeric_limits<double>::infinity();
+  hi = -lo;
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    auto const d = nx * o.corners[i].x + ny * o.corners[i].y;
+    lo = std::min(lo, d);
+    hi = std::max(hi, d);
+  }
+}
+
+/*
+ *  MARK: separates()
+ */
+bool separates(Outline const & a, Outline const & b, double nx, double ny) {
+  double alo = 0, ahi = 0, blo = 0, bhi = 0;
+  project(a, nx, ny, alo, ahi);
+  project(b, nx, ny, blo, bhi);
+  return ahi < blo || bhi < alo;
+}
+
+/*
+ *  MARK: separated_by_edges()
+ *  true if a normal of one of polygon's sides separates it from other.
+ */
+bool separated_by_edges(Outline const & polygon, Outline const & other) {
+  for (std::uint8_t i = 0; i < polygon.size; ++i) {
+    auto const & p = polygon.corners[i];
+    auto const & q = polygon.corners[(i + 1) % polygon.size];
+    if (separates(polygon, other, p.y - q.y, q.x - p.x)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: contains() - one point
+ *  the kernels' expressions, evaluated in the same order.
+ */
+bool
+contains(Outline const & shape, double x, double y) {
+  if (shape.size == 0) {
+    if (!(shape.radius >= 0)) {
+      return false;
+    }
+    auto const dx = x - shape.centre.x;
+    auto const dy = y - shape.centre.y;
+    return dx * dx + dy * dy <= shape.radius * shape.radius;
+  }
+  auto const e = edges(shape);
+  if (e.size == 0) {
+    return false;
+  }
+  for (std::size_t i = 0; i < e.size; ++i) {
+    if (!(0 <= e.a[i] * x + e.b[i] * y + e.c[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ *  MARK: contains() - point arrays
+ */
+void
+contains(Outline const & shape, double const * x, double const * y,
+         std::uint8_t * out, std::size_t n) {
+  if (shape.size == 0) {
+    if (!(shape.radius >= 0)) {
+      std::memset(out, 0, n);
+      return;
+    }
+    sk::inside_circle(shape.centre.x, shape.centre.y, shape.radius * shape.radius, x, y, out, n);
+    return;
+  }
+  auto const e = edges(shape);
+  if (e.size == 0) {
+    std::memset(out, 0, n);
+    return;
+  }
+  sk::inside_edges(e.a, e.b, e.c, e.size, x, y, out, n);
+}
+
+/*
+ *  MARK: overlaps()
+ *  boxes first; then the separating axes.
+ */
+bool
+overlaps(Outline const & a, Outline const & b) {
+  if (!usable(a) || !usable(b) || !bounds(a).overlaps(bounds(b))) {
+    return false;
+  }
+  if (a.size == 0 && b.size == 0) {
+    auto const dx = a.centre.x - b.centre.x;
+    auto const dy = a.centre.y - b.centre.y;
+    auto const r = a.radius + b.radius;
+    return dx * dx + dy * dy <= r * r;
+  }
+  if (a.size == 0) {
+    return overlaps(b, a);
+  }
+  if (separated_by_edges(a, b)) {
+    return false;
+  }
+  if (b.size > 0) {
+    return !separated_by_edges(b, a);
+  }
+
+  //  circle: the remaining candidate axis runs through a's nearest corner
+  auto nearest = a.corners[0];
+  auto best = std::numeric_limits<double>::infinity();
+  for (std::uint8_t i = 0; i < a.size; ++i) {
+    auto const dx = a.corners[i].x - b.centre.x;
+    auto const dy = a.corners[i].y - b.centre.y;
+    if (dx * dx + dy * dy < best) {
+      best = dx * dx + dy * dy;
+      nearest = a.corners[i];
+    }
+  }
+  auto const nx = nearest.x - b.centre.x;
+  auto const ny = nearest.y - b.centre.y;
+  return (nx == 0 && ny == 0) || !separates(a, b, nx, ny);
+}
+
+/*
+ *  MARK: overlaps() - pairs
+ */
+void
+overlaps(std::span<Outline const> a, std::span<Outline const> b, std::uint8_t * out) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("overlaps: a and b differ in size"s);
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    out[i] = overlaps(a[i], b[i]);
+  }
+}
@@ -0,0 +1,53 @@
+//
+//  ShapeCollide.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:58:14.5031
+//
+//  Point containment and overlap of placed shapes (see ShapeBounds.hpp).
+//
+//  A polygon contains a point when every edge function, the cross
+//  product of the edge with the point, is >= 0 for the outline's
+//  winding; a circle when the squared distance to the centre is <= the
+//  squared radius.  Both are closed: the boundary is inside.  The array
+//  forms run the shape_kernels lanes over the points, and the
+//  single-point form evaluates the same expressions, so the two agree
+//  bit for bit.
+//
+//  overlaps() is a separating-axis test: two convex outlines are apart
+//  exactly when their projections onto some edge normal are, and for a
+//  circle against a polygon, onto the axis through its nearest corner.
+//  Touching outlines overlap.
+//
+//  An outline with a NaN coordinate, or a polygon of zero area,
+//  contains nothing and overlaps nothing.
+//
+//  MARK: - References.
+//  @see: Pineda, "A Parallel Algorithm for Polygon Rasterization",
+//        SIGGRAPH 1988.
+//  @see: Ericson, "Real-Time Collision Detection", ch. 5, 2004.
+//
+
+#ifndef ShapeCollide_hpp
+#define ShapeCollide_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "ShapeBounds.hpp"
+
+//  MARK: - Definitions.
+bool contains(Outline const & shape, double x, double y);
+
+//  out[i] = 1 where (x[i], y[i]) is inside, 0 elsewhere
+void contains(Outline const & shape, double const * x, double const * y,
+              std::uint8_t * out, std::size_t n);
+
+bool overlaps(Outline const & a, Outline const & b);
+
+//  out[i] = overlaps(a[i], b[i])
+void overlaps(std::span<Outline const> a, std::span<Outline const> b, std::uint8_t * out);
+
+#endif /* ShapeCollide_hpp */
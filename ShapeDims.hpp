@@ -0,0 +1,71 @@
+//
+//  ShapeDims.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 15:48:12.6092
+//
+
+#ifndef ShapeDims_hpp
+#define ShapeDims_hpp
+
+//  MARK: - Definitions.
+/*
+ *  Typed dimensions, one struct per concrete class, returned by the
+ *  non-virtual dims() accessors.  Only the values that mean something
+ *  for the kind are present; there is no NaN padding.
+ */
+
+struct RectDims {
+  double length;
+  double breadth;
+};
+
+struct SquareDims {
+  double length;
+};
+
+struct ParallelogramDims {
+  double base;
+  double height;
+  double side;
+};
+
+struct CircleDims {
+  double radius;
+};
+
+struct TriangleDims {
+  double base;
+  double height;
+  double sideA;
+  double sideB;
+};
+
+struct RightTriangleDims {
+  double base;
+  double height;
+  double hypotenuse;
+};
+
+struct IsoscelesDims {
+  double base;
+  double height;
+  double side;
+};
+
+struct EquilateralDims {
+  double base;
+  double height;
+};
+
+/*
+ *  height is both legs, height2 the height over the hypotenuse.
+ */
+struct RightIsoscelesDims {
+  double height;
+  double hypotenuse;
+  double height2;
+};
+
+#endif /* ShapeDims_hpp */
@@ -0,0 +1,244 @@
+//
+//  ShapeFactory.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:52:37.6120
+//
+
+#include "ShapeFactory.hpp"
+#include "ShapeArena.hpp"
+#include "ShapeKernels.hpp"
+#include "Shapes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: check()
+ *  valid for the n rows whose given arguments are all lengths.  An
+ *  optional argument passes when not given.
+ */
+void check(std::array<double const *, 4> const & args, ShapeLayout const & layout,
+           std::uint8_t const * given, std::uint8_t * valid, std::size_t n) {
+  std::fill_n(valid, n, 1);
+  for (std::size_t f = 0; f < layout.required; ++f) {
+    shape_kernels::check_lengths(args[f], valid, n);
+  }
+  std::vector<std::uint8_t> optional;
+  for (std::size_t f = layout.required; f < layout.params; ++f) {
+    optional.assign(n, 1);
+    shape_kernels::check_lengths(args[f], optional.data(), n);
+    for (std::size_t r = 0; r < n; ++r) {
+      valid[r] &= optional[r] | (given[r] <= f);
+    }
+  }
+}
+
+} /* namespace */
+
+//  MARK: - Class ShapeFactory Implementation.
+/*
+ *  MARK: ShapeFactory::ShapeFactory()
+ *  the arguments go straight into the batch's columns, which are
+ *  checked, cleared of rejected rows and derived in place.
+ */
+ShapeFactory::ShapeFactory(std::span<ShapeDescriptor const> descriptors, bool strict) {
+  auto const n = descriptors.size();
+  std::vector<std::uint8_t> accepted(n, 0);
+
+  //  kind and count, and rows per kind
+  std::array<std::size_t, shape_kind_count> rows {};
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const & d = descriptors[i];
+    auto const k = static_cast<std::size_t>(d.kind);
+    if (k < shape_kind_count && d.count >= shape_layouts[k].required
+        && d.count <= shape_layouts[k].params) {
+      accepted[i] = 1;
+      ++rows[k];
+    }
+  }
+
+  //  arguments into columns, NAN where not given
+  std::array<std::array<double *, 4>, shape_kind_count> args {};
+  std::array<std::vector<std::uint8_t>, shape_kind_count> given;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    for (std::size_t f = 0; f < shape_layouts[k].fields; ++f) {
+      batch_.col(kind, f).resize(rows[k]);
+      args[k][f] = batch_.col(kind, f).data();
+    }
+    if (shape_layouts[k].required < shape_layouts[k].params) {
+      given[k].resize(rows[k]);
+    }
+  }
+  std::array<std::size_t, shape_kind_count> next {};
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!accepted[i]) {
+      continue;
+    }
+    auto const & d = descriptors[i];
+    auto const k = static_cast<std::size_t>(d.kind);
+    auto const & layout = shape_layouts[k];
+    auto const r = next[k]++;
+    for (std::size_t f = 0; f < layout.params; ++f) {
+      args[k][f][r] = f < d.count ? d.params[f] : NAN;
+    }
+    if (layout.required < layout.params) {
+      given[k][r] = d.count;
+    }
+  }
+
+  //  the arguments, a column at a time
+  std::array<std::vector<std::uint8_t>, shape_kind_count> valid;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    valid[k].resize(rows[k]);
+    check({ args[k][0], args[k][1], args[k][2], args[k][3] }, shape_layouts[k],
+          given[k].data(), valid[k].data(), rows[k]);
+  }
+  next = {};
+  kinds_.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (accepted[i]) {
+      auto const k = static_cast<std::size_t>(descriptors[i].kind);
+      if (valid[k][next[k]++]) {
+        kinds_.push_back(descriptors[i].kind);
+        continue;
+      }
+    }
+    rejected_.push_back(i);
+  }
+  if (strict && !rejected_.empty()) {
+    throw std::invalid_argument("ShapeFactory: invalid shape descriptor at index "s
+                                + std::to_string(rejected_.front()));
+  }
+
+  //  valid rows to the front, then derived fields by column
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const & layout = shape_layouts[k];
+    std::size_t kept = 0;
+    for (std::size_t r = 0; r < rows[k]; ++r) {
+      if (valid[k][r]) {
+        if (kept != r) {
+          for (std::size_t f = 0; f < layout.params; ++f) {
+            args[k][f][kept] = args[k][f][r];
+          }
+        }
+        ++kept;
+      }
+    }
+    for (std::size_t f = 0; f < layout.fields; ++f) {
+      batch_.col(kind, f).resize(kept);
+    }
+    batch_.derive(kind, 0);
+  }
+}
+
+/*
+ *  MARK: ShapeFactory::build()
+ */
+void
+ShapeFactory::build(ShapeBatch & batch) const {
+  batch.append(batch_);
+}
+
+/*
+ *  MARK: ShapeFactory::build()
+ *  the objects of each kind are placed together, in one loop per kind.
+ *  Each triangle with derived members adopts them from the columns,
+ *  which hold what derive_members() would compute.
+ */
+std::vector<Shape *>
+ShapeFactory::build(ShapeArena & arena) const {
+  auto const adopt = [](Triangle & t, double value) { t.adopt_derived(value); };
+
+  std::array<std::vector<Shape *>, shape_kind_count> placed;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const n = batch_.size(kind);
+    auto const c = [&](std::size_t f) { return batch_.col(kind, f).data(); };
+    auto & out = placed[k];
+    out.resize(n);
+    auto const each = [&](auto make) {
+      for (std::size_t r = 0; r < n; ++r) {
+        out[r] = make(r);
+      }
+    };
+
+    switch (kind) {
+    case ShapeKind::rectangle:
+      each([&](std::size_t r) { return arena.make<Rectangle>(c(0)[r], c(1)[r]); });
+      break;
+
+    case ShapeKind::square:
+      each([&](std::size_t r) { return arena.make<Square>(c(0)[r]); });
+      break;
+
+    case ShapeKind::parallelogram:
+      each([&](std::size_t r) {
+        return arena.make<Parallelogram>(c(0)[r], c(1)[r], c(2)[r]);
+      });
+      break;
+
+    case ShapeKind::circle:
+      each([&](std::size_t r) { return arena.make<Circle>(c(0)[r]); });
+      break;
+
+    case ShapeKind::triangle:
+      each([&](std::size_t r) {
+        return arena.make<Triangle>(c(0)[r], c(1)[r], c(2)[r], c(3)[r]);
+      });
+      break;
+
+    case ShapeKind::right_triangle:
+      each([&](std::size_t r) {
+        auto const s = arena.make<RightTriangle>(c(0)[r], c(1)[r]);
+        adopt(*s, c(2)[r]);
+        return s;
+      });
+      break;
+
+    case ShapeKind::isosceles_triangle:
+      each([&](std::size_t r) {
+        auto const s = arena.make<IsoscelesTriangle>(c(0)[r], c(1)[r]);
+        adopt(*s, c(2)[r]);
+        return s;
+      });
+      break;
+
+    case ShapeKind::equilateral_triangle:
+      each([&](std::size_t r) {
+        auto const s = arena.make<EquilateralTriangle>(c(0)[r]);
+        adopt(*s, c(1)[r]);
+        return s;
+      });
+      break;
+
+    case ShapeKind::right_isosceles_triangle:
+      each([&](std::size_t r) {
+        auto const s = arena.make<RightIsoscelesTriangle>(c(0)[r]);
+        adopt(*s, c(1)[r]);
+        return s;
+      });
+      break;
+    }
+  }
+
+  //  in descriptor order
+  std::vector<Shape *> shapes;
+  shapes.reserve(size());
+  std::array<std::size_t, shape_kind_count> next {};
+  for (auto const kind : kinds_) {
+    auto const k = static_cast<std::size_t>(kind);
+    shapes.push_back(placed[k][next[k]++]);
+  }
+  return shapes;
+}
@@ -0,0 +1,82 @@
+//
+//  ShapeFactory.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:52:37.6120
+//
+//  Bulk construction of shapes from descriptor arrays.
+//
+//  A ShapeFactory takes a whole span of ShapeDescriptors in one pass:
+//  it sorts the arguments into one column per kind and argument,
+//  checks every column with the vector kernels (each given argument a
+//  finite length, 0 or more), and computes the derived fields a column
+//  at a time, once, exactly as the constructors would.
+//
+//  The result goes out columnar, appended to a ShapeBatch, or as
+//  polymorphic objects placed in a ShapeArena, one kind after another,
+//  and listed in descriptor order.  The objects are built by their own
+//  constructors, which cannot be skipped, but their derived members
+//  are adopted from the columns already computed, so no object derives
+//  them on first use.
+//
+
+#ifndef ShapeFactory_hpp
+#define ShapeFactory_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+
+class Shape;
+class ShapeArena;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: struct ShapeDescriptor
+ *  the constructor arguments of one shape; count of params are given.
+ */
+struct ShapeDescriptor {
+  ShapeKind    kind;
+  std::uint8_t count;
+  double       params[4];
+};
+
+/*
+ *  MARK: Class ShapeFactory
+ *
+ *  A descriptor is rejected for an unknown kind, a count outside
+ *  [required, params] for its kind, or a given argument that is
+ *  negative, infinite or NaN.  Strict factories throw
+ *  std::invalid_argument naming the first one; others leave it out
+ *  and list it in rejected().
+ */
+class ShapeFactory {
+public:
+  explicit ShapeFactory(std::span<ShapeDescriptor const> descriptors, bool strict = true);
+
+  //  shapes accepted
+  std::size_t size() const noexcept { return kinds_.size(); }
+  //  indices of the descriptors left out, ascending
+  std::vector<std::size_t> const & rejected() const noexcept { return rejected_; }
+
+  //  every accepted shape appended to batch
+  void build(ShapeBatch & batch) const;
+  //  every accepted shape placed in arena; pointers in descriptor order
+  std::vector<Shape *> build(ShapeArena & arena) const;
+
+  //  the accepted shapes, columnar
+  ShapeBatch const & batch() const noexcept { return batch_; }
+
+protected:
+  //  hide implementation details from the interface
+  ShapeBatch batch_;
+  std::vector<ShapeKind> kinds_;
+  std::vector<std::size_t> rejected_;
+};
+
+#endif /* ShapeFactory_hpp */
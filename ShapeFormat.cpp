@@ -0,0 +1,119 @@
+//
+//  ShapeFormat.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 16:52:29.9147
+//
+
+#include "ShapeFormat.hpp"
+#include "Shapes.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+
+//  MARK: - Class TextAppender Implementation.
+/*
+ *  MARK: TextAppender::put()
+ */
+void
+TextAppender::put(char const * text, std::size_t n) noexcept {
+  if (size_ < capacity_) {
+    std::memcpy(buf_ + size_, text, std::min(n, capacity_ - size_));
+  }
+  size_ += n;
+}
+
+/*
+ *  MARK: TextAppender::operator<<()
+ */
+TextAppender &
+TextAppender::operator<<(std::string_view text) noexcept {
+  put(text.data(), text.size());
+  return *this;
+}
+
+TextAppender &
+TextAppender::operator<<(char c) noexcept {
+  put(&c, 1);
+  return *this;
+}
+
+TextAppender &
+TextAppender::operator<<(double value) noexcept {
+  //  %g with the default stream precision
+  char digits[32];
+  auto const r = std::to_chars(digits, digits + sizeof(digits), value,
+                               std::chars_format::general, 6);
+  put(digits, static_cast<std::size_t>(r.ptr - digits));
+  return *this;
+}
+
+TextAppender &
+TextAppender::operator<<(Fixed value) noexcept {
+  //  %f, up to 309 integer digits plus sign, point and 6 decimals
+  char digits[320];
+  auto const r = std::to_chars(digits, digits + sizeof(digits), value.value,
+                               std::chars_format::fixed, 6);
+  put(digits, static_cast<std::size_t>(r.ptr - digits));
+  return *this;
+}
+
+//  MARK: - Class ShapeFormatter Implementation.
+/*
+ *  MARK: ShapeFormatter::ShapeFormatter() - default c'tor
+ */
+ShapeFormatter::ShapeFormatter(std::size_t reserve)
+  : buf_(std::max<std::size_t>(reserve, 64)), size_(0) {}
+
+/*
+ *  MARK: ShapeFormatter::append()
+ *  format straight into the free tail; grow and retry only when the
+ *  text did not fit.
+ */
+ShapeFormatter &
+ShapeFormatter::append(Shape const & shape) {
+  auto n = shape.format_to(buf_.data() + size_, buf_.size() - size_);
+  if (size_ + n > buf_.size()) {
+    buf_.resize(std::max(buf_.size() * 2, size_ + n));
+    n = shape.format_to(buf_.data() + size_, buf_.size() - size_);
+  }
+  size_ += n;
+  return *this;
+}
+
+ShapeFormatter &
+ShapeFormatter::append(std::string_view text) {
+  if (size_ + text.size() > buf_.size()) {
+    buf_.resize(std::max(buf_.size() * 2, size_ + text.size()));
+  }
+  std::memcpy(buf_.data() + size_, text.data(), text.size());
+  size_ += text.size();
+  return *this;
+}
+
+ShapeFormatter &
+ShapeFormatter::append(char c) {
+  return append(std::string_view(&c, 1));
+}
+
+/*
+ *  MARK: ShapeFormatter::write()
+ */
+bool
+ShapeFormatter::write(std::FILE * file) {
+  auto const ok = std::fwrite(buf_.data(), 1, size_, file) == size_
+                  && std::fflush(file) == 0;
+  clear();
+  return ok;
+}
+
+bool
+ShapeFormatter::write(std::ostream & out) {
+  out.write(buf_.data(), static_cast<std::streamsize>(size_));
+  out.flush();
+  clear();
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,100 @@
+//
+//  ShapeFormat.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 16:52:29.9147
+//
+//  MARK: - References.
+//  @see: https://en.cppreference.com/w/cpp/utility/to_chars
+//
+
+#ifndef ShapeFormat_hpp
+#define ShapeFormat_hpp
+
+#include <cstddef>
+#include <cstdio>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+class Shape;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class TextAppender
+ *
+ *  Formats into a caller-owned buffer with std::to_chars: no locale, no
+ *  stream state, no allocation.  Numbers are written the way a default
+ *  std::ostream writes them (%g, precision 6), or as std::fixed does
+ *  when wrapped in fixed().  Like snprintf, size() is the length of the
+ *  full text even when it did not fit; the buffer then holds a prefix.
+ *  No terminating NUL is written.
+ */
+class TextAppender {
+public:
+  struct Fixed {
+    double value;
+  };
+
+  TextAppender(char * buf, std::size_t capacity) noexcept
+    : buf_(buf), capacity_(capacity), size_(0) {}
+
+  TextAppender & operator<<(std::string_view text) noexcept;
+  TextAppender & operator<<(char c) noexcept;
+  TextAppender & operator<<(double value) noexcept;
+  TextAppender & operator<<(Fixed value) noexcept;
+
+  std::size_t size() const noexcept { return size_; }
+  bool truncated() const noexcept { return size_ > capacity_; }
+
+protected:
+  //  hide implementation details from the interface
+  void put(char const * text, std::size_t n) noexcept;
+
+  char * buf_;
+  std::size_t capacity_;
+  std::size_t size_;
+};
+
+/*
+ *  MARK: fixed()
+ *  std::fixed for one value.
+ */
+inline
+TextAppender::Fixed fixed(double value) noexcept {
+  return { value };
+}
+
+/*
+ *  MARK: Class ShapeFormatter
+ *
+ *  Renders many shapes into one contiguous, growing buffer and hands it
+ *  to the output in a single write.
+ */
+class ShapeFormatter {
+public:
+  ShapeFormatter(std::size_t reserve = 4096);
+
+  //  display() text of shape
+  ShapeFormatter & append(Shape const & shape);
+  ShapeFormatter & append(std::string_view text);
+  ShapeFormatter & append(char c);
+
+  std::string_view view() const noexcept {
+    return { buf_.data(), size_ };
+  }
+  std::size_t size() const noexcept { return size_; }
+  void clear() noexcept { size_ = 0; }
+
+  //  one write of the whole buffer, then clear()
+  bool write(std::FILE * file);
+  bool write(std::ostream & out);
+
+protected:
+  //  hide implementation details from the interface
+  std::vector<char> buf_;
+  std::size_t size_;
+};
+
+#endif /* ShapeFormat_hpp */
@@ -0,0 +1,394 @@
+//
+//  ShapeIndex.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:05:51.2087
+//
+
+#include "ShapeIndex.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr std::size_t bins = 16;
+//  leaves never hold more than this, however cheap the SAH finds them
+constexpr std::size_t max_leaf = 16;
+//  from this depth on splits fall back to the centroid median, which
+//  bounds the depth of the tree and so the query stacks
+constexpr std::size_t sah_depth = 48;
+constexpr std::size_t max_depth = 96;
+//  nodes with fewer prims are built whole by one task, in cache
+constexpr std::size_t subtree_grain = 4096;
+
+/*
+ *  MARK: struct Prim
+ */
+struct Prim {
+  Box box;
+  double cx;
+  double cy;
+  ShapeIndex::Id id;
+  std::uint32_t bin;     //  in the node being split
+};
+
+/*
+ *  MARK: struct Pending
+ *  a node whose prims [begin, end) are still to be split.
+ */
+struct Pending {
+  std::uint32_t node;
+  std::uint32_t begin;
+  std::uint32_t end;
+  std::uint32_t depth;
+  Box box;
+  Box centroids;
+};
+
+/*
+ *  MARK: struct Split
+ */
+struct Split {
+  bool leaf = true;
+  Pending left;
+  Pending right;
+};
+
+/*
+ *  MARK: children()
+ *  pending nodes for [begin, mid) and [mid, end).
+ */
+Split children(Pending const & node, Prim const * prims, std::uint32_t mid) {
+  Split split;
+  split.leaf = false;
+  split.left = { 0, node.begin, mid, node.depth + 1, {}, {} };
+  split.right = { 0, mid, node.end, node.depth + 1, {}, {} };
+  for (auto i = node.begin; i < node.end; ++i) {
+    auto & side = i < mid ? split.left : split.right;
+    side.box.merge(prims[i].box);
+    side.centroids.merge(prims[i].cx, prims[i].cy);
+  }
+  return split;
+}
+
+/*
+ *  MARK: split()
+ *  binned SAH along the longer centroid axis; the median when the
+ *  centroids coincide or the tree is already deep.
+ */
+Split split(Pending const & node, Prim * prims) {
+  auto const n = node.end - node.begin;
+  if (n <= ShapeIndex::leaf_size) {
+    return {};
+  }
+  auto const & c = node.centroids;
+  bool const y = (c.max_y - c.min_y) > (c.max_x - c.min_x);
+  auto const lo = y ? c.min_y : c.min_x;
+  auto const extent = y ? c.max_y - c.min_y : c.max_x - c.min_x;
+  auto const centroid = [y](Prim const & p) { return y ? p.cy : p.cx; };
+
+  if (!(extent > 0) || node.depth >= sah_depth) {
+    auto const mid = node.begin + n / 2;
+    std::nth_element(prims + node.begin, prims + mid, prims + node.end,
+                     [&](Prim const & a, Prim const & b) {
+                       return centroid(a) < centroid(b) || (centroid(a) == centroid(b) && a.id < b.id);
+                     });
+    return children(node, prims, mid);
+  }
+
+  auto const scale = bins / extent;
+  auto const bin = [&](Prim const & p) {
+    return std::min<std::uint32_t>(bins - 1, static_cast<std::int32_t>((centroid(p) - lo) * scale));
+  };
+  std::array<Box, bins> box;
+  std::array<Box, bins> centroids;
+  std::array<std::uint32_t, bins> count {};
+  for (auto i = node.begin; i < node.end; ++i) {
+    auto const b = prims[i].bin = bin(prims[i]);
+    box[b].merge(prims[i].box);
+    centroids[b].merge(prims[i].cx, prims[i].cy);
+    ++count[b];
+  }
+
+  //  cost of the split below bin b, for b in [1, bins)
+  std::array<double, bins> cost {};
+  Box right;
+  std::uint32_t right_count = 0;
+  for (auto b = bins - 1; b > 0; --b) {
+    right.merge(box[b]);
+    right_count += count[b];
+    cost[b] = right_count * right.margin();
+  }
+  Box left;
+  std::uint32_t left_count = 0;
+  auto best = std::numeric_limits<double>::infinity();
+  std::size_t best_bin = 0;
+  for (std::size_t b = 1; b < bins; ++b) {
+    left.merge(box[b - 1]);
+    left_count += count[b - 1];
+    auto const total = cost[b] + left_count * left.margin();
+    if (left_count > 0 && left_count < n && total < best) {
+      best = total;
+      best_bin = b;
+    }
+  }
+  if (best_bin == 0 || (n <= max_leaf && best >= n * node.box.margin())) {
+    return n <= max_leaf ? Split() : children(node, prims, node.begin + n / 2);
+  }
+
+  auto const mid = std::partition(prims + node.begin, prims + node.end,
+                                  [&](Prim const & p) { return p.bin < best_bin; });
+  //  the children's bounds are the bins' bounds, no second pass
+  Split split;
+  split.leaf = false;
+  split.left = { 0, node.begin, static_cast<std::uint32_t>(mid - prims), node.depth + 1, {}, {} };
+  split.right = { 0, split.left.end, node.end, node.depth + 1, {}, {} };
+  for (std::size_t b = 0; b < bins; ++b) {
+    auto & side = b < best_bin ? split.left : split.right;
+    side.box.merge(box[b]);
+    side.centroids.merge(centroids[b]);
+  }
+  return split;
+}
+
+/*
+ *  MARK: grow()
+ *  the subtree below nodes[at], depth first into nodes.
+ */
+template <typename Node>
+void grow(std::vector<Node> & nodes, std::size_t at, Pending const & pending, Prim * prims) {
+  auto const halves = split(pending, prims);
+  if (halves.leaf) {
+    nodes[at].first = pending.begin;
+    nodes[at].count = pending.end - pending.begin;
+    return;
+  }
+  auto const first = nodes.size();
+  nodes[at].first = static_cast<std::uint32_t>(first);
+  nodes.push_back({ halves.left.box, 0, 0 });
+  nodes.push_back({ halves.right.box, 0, 0 });
+  grow(nodes, first, halves.left, prims);
+  grow(nodes, first + 1, halves.right, prims);
+}
+
+} /* namespace */
+
+//  MARK: - Class ShapeIndex Implementation.
+/*
+ *  MARK: ShapeIndex::ShapeIndex() - c'tor
+ */
+ShapeIndex::ShapeIndex(std::span<Box const> boxes) {
+  build(boxes, ThreadPool::shared());
+}
+
+ShapeIndex::ShapeIndex(std::span<Box const> boxes, ThreadPool & pool) {
+  build(boxes, pool);
+}
+
+/*
+ *  MARK: ShapeIndex::clear()
+ */
+void
+ShapeIndex::clear() {
+  nodes_.clear();
+  ids_.clear();
+  boxes_.clear();
+}
+
+/*
+ *  MARK: ShapeIndex::build()
+ *  one parallel_for per level of large nodes; a node of subtree_grain
+ *  prims or fewer is finished by its task.  Nodes are numbered in level
+ *  order once the level is done, so numbering does not depend on timing.
+ */
+void
+ShapeIndex::build(std::span<Box const> boxes, ThreadPool & pool) {
+  clear();
+  if (boxes.size() > std::numeric_limits<Id>::max()) {
+    throw std::length_error("ShapeIndex::build: more boxes than ids"s);
+  }
+
+  std::vector<Prim> prims;
+  prims.reserve(boxes.size());
+  Pending root { 0, 0, 0, 0, {}, {} };
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    auto const & b = boxes[i];
+    if (!(std::isfinite(b.min_x) && std::isfinite(b.min_y)
+          && std::isfinite(b.max_x) && std::isfinite(b.max_y)) || b.empty()) {
+      continue;
+    }
+    prims.push_back({ b, (b.min_x + b.max_x) / 2, (b.min_y + b.max_y) / 2, static_cast<Id>(i), 0 });
+    root.box.merge(b);
+    root.centroids.merge(prims.back().cx, prims.back().cy);
+  }
+  if (prims.empty()) {
+    return;
+  }
+  root.end = static_cast<std::uint32_t>(prims.size());
+
+  nodes_.push_back({ root.box, 0, 0 });
+  std::vector<Pending> level { root };
+  std::vector<Split> splits;
+  std::vector<std::vector<Node>> subtrees;
+  while (!level.empty()) {
+    splits.assign(level.size(), Split());
+    subtrees.assign(level.size(), {});
+    pool.parallel_for(level.size(), [&](std::size_t i) {
+      auto const & pending = level[i];
+      if (pending.end - pending.begin > subtree_grain) {
+        splits[i] = split(pending, prims.data());
+        return;
+      }
+      subtrees[i].push_back({ pending.box, 0, 0 });
+      grow(subtrees[i], 0, pending, prims.data());
+    });
+
+    std::vector<Pending> next;
+    for (std::size_t i = 0; i < level.size(); ++i) {
+      auto const & pending = level[i];
+      if (!subtrees[i].empty()) {
+        //  subtree node j > 0 lands at base + j - 1; its root is pending.node
+        auto const base = static_cast<std::uint32_t>(nodes_.size());
+        auto & tree = subtrees[i];
+        for (auto & node : tree) {
+          if (node.count == 0) {
+            node.first += base - 1;
+          }
+        }
+        nodes_[pending.node] = tree.front();
+        nodes_.insert(nodes_.end(), tree.begin() + 1, tree.end());
+        continue;
+      }
+      if (splits[i].leaf) {
+        nodes_[pending.node].first = pending.begin;
+        nodes_[pending.node].count = pending.end - pending.begin;
+        continue;
+      }
+      auto const first = static_cast<std::uint32_t>(nodes_.size());
+      nodes_[pending.node].first = first;
+      for (auto child : { splits[i].left, splits[i].right }) {
+        child.node = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back({ child.box, 0, 0 });
+        next.push_back(child);
+      }
+    }
+    level.swap(next);
+  }
+
+  ids_.reserve(prims.size());
+  boxes_.reserve(prims.size());
+  for (auto const & p : prims) {
+    ids_.push_back(p.id);
+    boxes_.push_back(p.box);
+  }
+}
+
+/*
+ *  MARK: ShapeIndex::query() - region
+ */
+void
+ShapeIndex::query(Box const & region, std::vector<Id> & out) const {
+  if (nodes_.empty()) {
+    return;
+  }
+  std::uint32_t stack[max_depth + 1];
+  std::size_t top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    auto const & node = nodes_[stack[--top]];
+    if (!node.box.overlaps(region)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (auto i = node.first; i < node.first + node.count; ++i) {
+        if (boxes_[i].overlaps(region)) {
+          out.push_back(ids_[i]);
+        }
+      }
+      continue;
+    }
+    stack[top++] = node.first + 1;
+    stack[top++] = node.first;
+  }
+}
+
+/*
+ *  MARK: ShapeIndex::query() - point
+ */
+void
+ShapeIndex::query(double x, double y, std::vector<Id> & out) const {
+  query(Box { x, y, x, y }, out);
+}
+
+/*
+ *  MARK: ShapeIndex::nearest()
+ *  depth first, nearer child first, pruned by the k-th best so far.
+ *  best is a max-heap on (distance, id) while searching.
+ */
+void
+ShapeIndex::nearest(double x, double y, std::size_t k, std::vector<Neighbour> & out) const {
+  if (nodes_.empty() || k == 0) {
+    return;
+  }
+  auto const before = [](Neighbour const & a, Neighbour const & b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+  };
+  std::vector<Neighbour> best;
+  best.reserve(std::min(k, size()));
+  auto const limit = [&] {
+    return best.size() < k ? std::numeric_limits<double>::infinity() : best.front().distance;
+  };
+
+  struct Entry {
+    std::uint32_t node;
+    double distance;
+  };
+  Entry stack[max_depth + 1];
+  std::size_t top = 0;
+  stack[top++] = { 0, nodes_.front().box.distance2(x, y) };
+  while (top > 0) {
+    auto const entry = stack[--top];
+    if (entry.distance > limit()) {
+      continue;
+    }
+    auto const & node = nodes_[entry.node];
+    if (node.count > 0) {
+      for (auto i = node.first; i < node.first + node.count; ++i) {
+        Neighbour const candidate { ids_[i], boxes_[i].distance2(x, y) };
+        if (best.size() < k) {
+          best.push_back(candidate);
+          std::push_heap(best.begin(), best.end(), before);
+        }
+        else if (before(candidate, best.front())) {
+          std::pop_heap(best.begin(), best.end(), before);
+          best.back() = candidate;
+          std::push_heap(best.begin(), best.end(), before);
+        }
+      }
+      continue;
+    }
+    Entry near { node.first, nodes_[node.first].box.distance2(x, y) };
+    Entry far { node.first + 1, nodes_[node.first + 1].box.distance2(x, y) };
+    if (far.distance < near.distance) {
+      std::swap(near, far);
+    }
+    stack[top++] = far;
+    stack[top++] = near;
+  }
+
+  std::sort_heap(best.begin(), best.end(), before);
+  for (auto & neighbour : best) {
+    neighbour.distance = std::sqrt(neighbour.distance);
+  }
+  out.insert(out.end(), best.begin(), best.end());
+}
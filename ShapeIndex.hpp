@@ -0,0 +1,99 @@
+//
+//  ShapeIndex.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:05:51.2087
+//
+//  Bounding-volume hierarchy over shape bounding boxes.
+//
+//  The tree is built top down with a binned surface area heuristic: a
+//  node's boxes are sorted into bins by centroid along its longer axis
+//  and split where the summed child margins, weighted by box counts,
+//  are least.  The upper levels are one parallel_for each over their
+//  nodes; below a few thousand boxes a task builds the whole subtree.
+//  A node's split depends only on its own boxes, so the tree is the
+//  same for every pool size.
+//
+//  Siblings sit side by side, and a leaf's boxes are copied next to
+//  each other so a query reads them in one run.  Ids are positions in
+//  the span the index was built from.  Boxes that are empty or have a
+//  NaN edge are not indexed.
+//
+//  MARK: - References.
+//  @see: Wald, "On fast Construction of SAH-based Bounding Volume
+//        Hierarchies", IEEE Symposium on Interactive Ray Tracing, 2007.
+//
+
+#ifndef ShapeIndex_hpp
+#define ShapeIndex_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeBounds.hpp"
+
+class ThreadPool;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class ShapeIndex
+ *
+ *  Queries append to out and do not clear it; they are safe to run
+ *  concurrently with each other, not with build().
+ */
+class ShapeIndex {
+public:
+  using Id = std::uint32_t;
+
+  /*
+   *  MARK: struct ShapeIndex::Neighbour
+   *  distance is to the box, 0 when the point is inside it.
+   */
+  struct Neighbour {
+    Id id;
+    double distance;
+  };
+
+  static constexpr std::size_t leaf_size = 4;
+
+  ShapeIndex() = default;
+  explicit ShapeIndex(std::span<Box const> boxes);
+  ShapeIndex(std::span<Box const> boxes, ThreadPool & pool);
+
+  void build(std::span<Box const> boxes, ThreadPool & pool);
+  void clear();
+
+  //  boxes indexed, nodes in the tree
+  std::size_t size() const noexcept { return ids_.size(); }
+  std::size_t nodes() const noexcept { return nodes_.size(); }
+  Box bounds() const noexcept { return nodes_.empty() ? Box() : nodes_.front().box; }
+
+  //  ids of boxes that overlap region, or contain (x, y)
+  void query(Box const & region, std::vector<Id> & out) const;
+  void query(double x, double y, std::vector<Id> & out) const;
+
+  //  the k boxes nearest (x, y), nearest first, ties by id
+  void nearest(double x, double y, std::size_t k, std::vector<Neighbour> & out) const;
+
+protected:
+  //  hide implementation details from the interface
+  /*
+   *  MARK: struct ShapeIndex::Node
+   *  a leaf holds count boxes from first; an inner node's children are
+   *  first and first + 1.
+   */
+  struct Node {
+    Box box;
+    std::uint32_t first;
+    std::uint32_t count;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<Id> ids_;
+  std::vector<Box> boxes_;     //  in ids_ order
+};
+
+#endif /* ShapeIndex_hpp */
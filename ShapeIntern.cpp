@@ -0,0 +1,243 @@
+//
+//  ShapeIntern.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 05:31:12.4408
+//
+
+#include "ShapeIntern.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: bits()
+ *  every NaN of one sign the same.
+ */
+std::uint64_t bits(double x) noexcept {
+  return std::bit_cast<std::uint64_t>(
+    std::isnan(x) ? std::copysign(std::numeric_limits<double>::quiet_NaN(), x) : x);
+}
+
+/*
+ *  MARK: make_key()
+ *  false if kind or count is out of range.
+ */
+bool make_key(ShapeKind kind, double const * params, std::size_t count,
+              std::array<std::uint64_t, 4> & key) noexcept {
+  auto const k = static_cast<std::size_t>(kind);
+  if (k >= shape_kind_count || count < shape_layouts[k].required
+      || count > shape_layouts[k].params) {
+    return false;
+  }
+  for (std::size_t f = 0; f < key.size(); ++f) {
+    key[f] = bits(f < count ? params[f] : NAN);
+  }
+  return true;
+}
+
+/*
+ *  MARK: hash_of()
+ *  splitmix64 finalizer over kind and arguments.
+ */
+std::uint64_t hash_of(ShapeKind kind, std::array<std::uint64_t, 4> const & key) noexcept {
+  std::uint64_t h = static_cast<std::uint64_t>(kind) * 0x9e3779b97f4a7c15;
+  for (auto const b : key) {
+    h = (h ^ b) * 0xbf58476d1ce4e5b9;
+    h ^= h >> 31;
+  }
+  h *= 0x94d049bb133111eb;
+  return h ^ (h >> 29);
+}
+
+/*
+ *  MARK: arguments()
+ *  the constructor arguments a value was made from, NAN padded.
+ */
+std::array<double, 4> arguments(ShapeValue const & v) {
+  std::array<double, 4> a { NAN, NAN, NAN, NAN };
+  switch (static_cast<ShapeKind>(v.index())) {
+  case ShapeKind::rectangle: {
+    auto const & s = std::get<RectangleValue>(v);
+    a[0] = s.length;
+    a[1] = s.breadth;
+    break;
+  }
+  case ShapeKind::square:
+    a[0] = std::get<SquareValue>(v).length;
+    break;
+
+  case ShapeKind::parallelogram: {
+    auto const & s = std::get<ParallelogramValue>(v);
+    a[0] = s.height;
+    a[1] = s.base;
+    a[2] = s.side;
+    break;
+  }
+  case ShapeKind::circle:
+    a[0] = std::get<CircleValue>(v).radius;
+    break;
+
+  case ShapeKind::triangle: {
+    auto const & s = std::get<TriangleValue>(v);
+    a = { s.base, s.height, s.sideA, s.sideB };
+    break;
+  }
+  case ShapeKind::right_triangle: {
+    auto const & s = std::get<RightTriangleValue>(v);
+    a[0] = s.base;
+    a[1] = s.height;
+    break;
+  }
+  case ShapeKind::isosceles_triangle: {
+    auto const & s = std::get<IsoscelesTriangleValue>(v);
+    a[0] = s.base;
+    a[1] = s.height;
+    break;
+  }
+  case ShapeKind::equilateral_triangle:
+    a[0] = std::get<EquilateralTriangleValue>(v).base;
+    break;
+
+  case ShapeKind::right_isosceles_triangle:
+    a[0] = std::get<RightIsoscelesTriangleValue>(v).height;
+    break;
+  }
+  return a;
+}
+
+} /* namespace */
+
+//  MARK: - Class ShapeInterner Implementation.
+/*
+ *  MARK: ShapeInterner::Table::Table()
+ *  capacity is a power of two.
+ */
+ShapeInterner::Table::Table(std::size_t capacity)
+  : mask(capacity - 1), slots(new std::atomic<ShapeHandle>[capacity]) {
+  for (std::size_t i = 0; i < capacity; ++i) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+/*
+ *  MARK: ShapeInterner::ShapeInterner()
+ *  room for capacity distinct shapes before the table first grows.
+ */
+ShapeInterner::ShapeInterner(std::size_t capacity)
+  : size_(0) {
+  tables_.push_back(std::make_unique<Table>(std::bit_ceil(std::max<std::size_t>(capacity, 8) * 2)));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+/*
+ *  MARK: ShapeInterner::find()
+ */
+ShapeHandle
+ShapeInterner::find(Table const & table, ShapeKind kind, Key const & key,
+                    std::uint64_t hash) noexcept {
+  for (auto i = hash & table.mask;; i = (i + 1) & table.mask) {
+    auto const shape = table.slots[i].load(std::memory_order_acquire);
+    if (shape == nullptr) {
+      return nullptr;
+    }
+    if (shape->hash == hash && shape->kind == kind && bits(shape->params[0]) == key[0]
+        && bits(shape->params[1]) == key[1] && bits(shape->params[2]) == key[2]
+        && bits(shape->params[3]) == key[3]) {
+      return shape;
+    }
+  }
+}
+
+ShapeHandle
+ShapeInterner::find(ShapeKind kind, double const * params, std::size_t count) const noexcept {
+  Key key;
+  if (!make_key(kind, params, count, key)) {
+    return nullptr;
+  }
+  return find(*table_.load(std::memory_order_acquire), kind, key, hash_of(kind, key));
+}
+
+/*
+ *  MARK: ShapeInterner::intern()
+ *  the lock is only taken for a shape not seen before.
+ */
+ShapeHandle
+ShapeInterner::intern(ShapeKind kind, double const * params, std::size_t count) {
+  Key key;
+  if (!make_key(kind, params, count, key)) {
+    throw std::invalid_argument("ShapeInterner::intern: bad kind or argument count "s
+                                + std::to_string(count));
+  }
+  auto const hash = hash_of(kind, key);
+  if (auto const shape = find(*table_.load(std::memory_order_acquire), kind, key, hash)) {
+    return shape;
+  }
+  return insert(kind, key, hash);
+}
+
+ShapeHandle
+ShapeInterner::intern(ShapeValue const & value) {
+  auto const kind = static_cast<ShapeKind>(value.index());
+  return intern(kind, arguments(value).data(), layout_of(kind).params);
+}
+
+ShapeHandle
+ShapeInterner::intern(Shape const & shape) {
+  return intern(to_shape_value(shape));
+}
+
+/*
+ *  MARK: ShapeInterner::insert()
+ *  under the lock: look again, grow at half full, then publish.
+ */
+ShapeHandle
+ShapeInterner::insert(ShapeKind kind, Key const & key, std::uint64_t hash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto table = table_.load(std::memory_order_relaxed);
+  if (auto const shape = find(*table, kind, key, hash)) {
+    return shape;
+  }
+
+  auto const place = [](Table const & to, ShapeHandle shape) {
+    auto i = shape->hash & to.mask;
+    while (to.slots[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1) & to.mask;
+    }
+    to.slots[i].store(shape, std::memory_order_release);
+  };
+
+  auto const size = size_.load(std::memory_order_relaxed) + 1;
+  if (size * 2 > table->mask + 1) {
+    auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+    for (std::size_t i = 0; i <= table->mask; ++i) {
+      if (auto const shape = table->slots[i].load(std::memory_order_relaxed)) {
+        place(*grown, shape);
+      }
+    }
+    table = grown.get();
+    tables_.push_back(std::move(grown));
+    table_.store(table, std::memory_order_release);
+  }
+
+  std::array<double, 4> params;
+  for (std::size_t f = 0; f < params.size(); ++f) {
+    params[f] = std::bit_cast<double>(key[f]);
+  }
+  auto const value = make_value(kind, params.data());
+  auto const & shape = shapes_.emplace_back(
+    InternedShape { kind, params, value, area(value), perimeter(value), hash });
+  place(*table, &shape);
+  size_.store(size, std::memory_order_relaxed);
+  return &shape;
+}
@@ -0,0 +1,111 @@
+//
+//  ShapeIntern.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 05:31:12.4408
+//
+//  Hash-consed shapes: one shared, immutable copy of every distinct
+//  shape.
+//
+//  A ShapeInterner keys shapes on their kind and constructor arguments,
+//  compared bit for bit after every NaN is made the quiet NaN of its
+//  sign, so an argument not given (a Triangle's sides, padded with NAN)
+//  matches itself and no other.  -0.0 and 0.0 stay distinct, as do nan
+//  and -nan; they print differently.  intern() returns a ShapeHandle,
+//  a pointer to the one InternedShape for that key, so equal shapes
+//  have equal handles, and area and perimeter are worked out once per
+//  distinct shape.
+//
+//  The table is open addressing with linear probing.  Lookups are
+//  lock-free: slots are atomic pointers to records that never move or
+//  change once published.  Inserts take a mutex, look again and, at
+//  half full, move every handle to a table twice the size.  Older
+//  tables are kept until the interner is destroyed, so a reader still
+//  probing one is safe; at worst it misses and retries under the lock.
+//
+//  MARK: - References.
+//  @see: https://en.wikipedia.org/wiki/Hash_consing
+//
+
+#ifndef ShapeIntern_hpp
+#define ShapeIntern_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeValue.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: struct InternedShape
+ *  params are the constructor arguments, NAN where not given; area and
+ *  perimeter match the member functions bit for bit.
+ */
+struct InternedShape {
+  ShapeKind kind;
+  std::array<double, 4> params;
+  ShapeValue value;
+  double area;
+  double perimeter;
+  std::uint64_t hash;
+};
+
+//  valid for the life of the interner; equal handles, equal shapes
+using ShapeHandle = InternedShape const *;
+
+/*
+ *  MARK: Class ShapeInterner
+ *
+ *  intern() and find() may be called from any number of threads at
+ *  once.
+ */
+class ShapeInterner {
+public:
+  explicit ShapeInterner(std::size_t capacity = 1024);
+
+  ShapeInterner(ShapeInterner const &) = delete;
+  ShapeInterner & operator=(ShapeInterner const &) = delete;
+
+  //  count constructor arguments, as ShapeBatch::append(); throws
+  //  std::invalid_argument if count is outside [required, params]
+  ShapeHandle intern(ShapeKind kind, double const * params, std::size_t count);
+  ShapeHandle intern(ShapeValue const & value);
+  ShapeHandle intern(Shape const & shape);
+
+  //  nullptr if the shape was never interned
+  ShapeHandle find(ShapeKind kind, double const * params, std::size_t count) const noexcept;
+
+  //  distinct shapes held
+  std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+protected:
+  //  hide implementation details from the interface
+  using Key = std::array<std::uint64_t, 4>;
+
+  struct Table {
+    explicit Table(std::size_t capacity);
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<ShapeHandle>[]> slots;
+  };
+
+  static ShapeHandle find(Table const & table, ShapeKind kind, Key const & key,
+                          std::uint64_t hash) noexcept;
+  ShapeHandle insert(ShapeKind kind, Key const & key, std::uint64_t hash);
+
+  std::atomic<Table const *> table_;
+  std::atomic<std::size_t> size_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Table>> tables_;
+  std::deque<InternedShape> shapes_;
+};
+
+#endif /* ShapeIntern_hpp */
@@ -0,0 +1,719 @@
+//
+//  ShapeKernels.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 09:14:52.3310
+//
+//  MARK: - References.
+//  @see: https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+//
+
+#ifndef ShapeKernels_hpp
+#define ShapeKernels_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//  MARK: - Definitions.
+/*
+ *  MARK: namespace shape_kernels
+ *
+ *  Element-wise array kernels used by the batch stores.  Every kernel
+ *  evaluates its expression in exactly the same order as the matching
+ *  member function in the Shape hierarchy, so a lane result is
+ *  bit-identical to the per-object result.
+ */
+namespace shape_kernels {
+
+/*
+ *  MARK: Lane
+ *  widest double vector the target was compiled for.
+ */
+#if defined(__AVX2__)
+struct Lane {
+  static constexpr std::size_t width = 4;
+  __m256d v;
+
+  static Lane load(double const * p) { return { _mm256_loadu_pd(p) }; }
+  static Lane load(float const * p) { return { _mm256_cvtps_pd(_mm_loadu_ps(p)) }; }
+  static Lane set1(double x) { return { _mm256_set1_pd(x) }; }
+  void store(double * p) const { _mm256_storeu_pd(p, v); }
+  friend Lane operator+(Lane a, Lane b) { return { _mm256_add_pd(a.v, b.v) }; }
+  friend Lane operator-(Lane a, Lane b) { return { _mm256_sub_pd(a.v, b.v) }; }
+  friend Lane operator*(Lane a, Lane b) { return { _mm256_mul_pd(a.v, b.v) }; }
+  friend Lane sqrt(Lane a) { return { _mm256_sqrt_pd(a.v) }; }
+  friend Lane operator&(Lane a, Lane b) { return { _mm256_and_pd(a.v, b.v) }; }
+  friend Lane operator|(Lane a, Lane b) { return { _mm256_or_pd(a.v, b.v) }; }
+  friend Lane operator<(Lane a, Lane b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+  friend Lane operator<=(Lane a, Lane b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+  friend Lane min(Lane a, Lane b) { return { _mm256_min_pd(a.v, b.v) }; }
+  friend Lane max(Lane a, Lane b) { return { _mm256_max_pd(a.v, b.v) }; }
+  unsigned mask() const { return static_cast<unsigned>(_mm256_movemask_pd(v)); }
+};
+#elif defined(__SSE2__)
+struct Lane {
+  static constexpr std::size_t width = 2;
+  __m128d v;
+
+  static Lane load(double const * p) { return { _mm_loadu_pd(p) }; }
+  static Lane load(float const * p) {
+    return { _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(p)))) };
+  }
+  static Lane set1(double x) { return { _mm_set1_pd(x) }; }
+  void store(double * p) const { _mm_storeu_pd(p, v); }
+  friend Lane operator+(Lane a, Lane b) { return { _mm_add_pd(a.v, b.v) }; }
+  friend Lane operator-(Lane a, Lane b) { return { _mm_sub_pd(a.v, b.v) }; }
+  friend Lane operator*(Lane a, Lane b) { return { _mm_mul_pd(a.v, b.v) }; }
+  friend Lane sqrt(Lane a) { return { _mm_sqrt_pd(a.v) }; }
+  friend Lane operator&(Lane a, Lane b) { return { _mm_and_pd(a.v, b.v) }; }
+  friend Lane operator|(Lane a, Lane b) { return { _mm_or_pd(a.v, b.v) }; }
+  friend Lane operator<(Lane a, Lane b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+  friend Lane operator<=(Lane a, Lane b) { return { _mm_cmple_pd(a.v, b.v) }; }
+  friend Lane min(Lane a, Lane b) { return { _mm_min_pd(a.v, b.v) }; }
+  friend Lane max(Lane a, Lane b) { return { _mm_max_pd(a.v, b.v) }; }
+  unsigned mask() const { return static_cast<unsigned>(_mm_movemask_pd(v)); }
+};
+#else
+struct Lane {
+  static constexpr std::size_t width = 1;
+  double v;
+
+  static Lane load(double const * p) { return { *p }; }
+  static Lane load(float const * p) { return { *p }; }
+  static Lane set1(double x) { return { x }; }
+  void store(double * p) const { *p = v; }
+  friend Lane operator+(Lane a, Lane b) { return { a.v + b.v }; }
+  friend Lane operator-(Lane a, Lane b) { return { a.v - b.v }; }
+  friend Lane operator*(Lane a, Lane b) { return { a.v * b.v }; }
+  friend Lane sqrt(Lane a) { return { std::sqrt(a.v) }; }
+  //  comparisons give 1 or 0 here rather than an all-ones lane
+  friend Lane operator&(Lane a, Lane b) { return { a.v * b.v }; }
+  friend Lane operator|(Lane a, Lane b) { return { a.v != 0 || b.v != 0 ? 1.0 : 0.0 }; }
+  friend Lane operator<(Lane a, Lane b) { return { a.v < b.v ? 1.0 : 0.0 }; }
+  friend Lane operator<=(Lane a, Lane b) { return { a.v <= b.v ? 1.0 : 0.0 }; }
+  //  as minpd and maxpd: b when either is NaN
+  friend Lane min(Lane a, Lane b) { return { a.v < b.v ? a.v : b.v }; }
+  friend Lane max(Lane a, Lane b) { return { a.v > b.v ? a.v : b.v }; }
+  unsigned mask() const { return v != 0 ? 1u : 0u; }
+};
+#endif
+
+/*
+ *  MARK: FloatLane
+ *  widest float vector the target was compiled for, twice the width
+ *  of Lane.
+ */
+#if defined(__AVX2__)
+struct FloatLane {
+  static constexpr std::size_t width = 8;
+  __m256 v;
+
+  static FloatLane load(float const * p) { return { _mm256_loadu_ps(p) }; }
+  static FloatLane set1(float x) { return { _mm256_set1_ps(x) }; }
+  void store(float * p) const { _mm256_storeu_ps(p, v); }
+  friend FloatLane operator+(FloatLane a, FloatLane b) { return { _mm256_add_ps(a.v, b.v) }; }
+  friend FloatLane operator*(FloatLane a, FloatLane b) { return { _mm256_mul_ps(a.v, b.v) }; }
+  friend FloatLane sqrt(FloatLane a) { return { _mm256_sqrt_ps(a.v) }; }
+};
+#elif defined(__SSE2__)
+struct FloatLane {
+  static constexpr std::size_t width = 4;
+  __m128 v;
+
+  static FloatLane load(float const * p) { return { _mm_loadu_ps(p) }; }
+  static FloatLane set1(float x) { return { _mm_set1_ps(x) }; }
+  void store(float * p) const { _mm_storeu_ps(p, v); }
+  friend FloatLane operator+(FloatLane a, FloatLane b) { return { _mm_add_ps(a.v, b.v) }; }
+  friend FloatLane operator*(FloatLane a, FloatLane b) { return { _mm_mul_ps(a.v, b.v) }; }
+  friend FloatLane sqrt(FloatLane a) { return { _mm_sqrt_ps(a.v) }; }
+};
+#else
+struct FloatLane {
+  static constexpr std::size_t width = 1;
+  float v;
+
+  static FloatLane load(float const * p) { return { *p }; }
+  static FloatLane set1(float x) { return { x }; }
+  void store(float * p) const { *p = v; }
+  friend FloatLane operator+(FloatLane a, FloatLane b) { return { a.v + b.v }; }
+  friend FloatLane operator*(FloatLane a, FloatLane b) { return { a.v * b.v }; }
+  friend FloatLane sqrt(FloatLane a) { return { std::sqrt(a.v) }; }
+};
+#endif
+
+/*
+ *  MARK: for_each_lane()
+ *  run op over [0, n) a full vector at a time, then finish the tail
+ *  with the scalar form of the same expression.
+ */
+template <typename L = Lane, typename VecOp, typename ScalarOp>
+inline
+void for_each_lane(std::size_t n, VecOp vop, ScalarOp sop) {
+  std::size_t i = 0;
+  for (; i + L::width <= n; i += L::width) {
+    vop(i);
+  }
+  for (; i < n; ++i) {
+    sop(i);
+  }
+}
+
+/*
+ *  MARK: product()
+ *  out = a * b  -  Rectangle::area(), Parallelogram::area()
+ */
+inline
+void product(double const * a, double const * b, double * out, std::size_t n) {
+  for_each_lane(n,
+    [&](std::size_t i) { (Lane::load(a + i) * Lane::load(b + i)).store(out + i); },
+    [&](std::size_t i) { out[i] = a[i] * b[i]; });
+}
+
+/*
+ *  MARK: half_product()
+ *  out = (a / 2.0) * b  -  Triangle::area()
+ */
+inline
+void half_product(double const * a, double const * b, double * out, std::size_t n) {
+  auto const half = Lane::set1(0.5);
+  for_each_lane(n,
+    [&](std::size_t i) { (Lane::load(a + i) * half * Lane::load(b + i)).store(out + i); },
+    [&](std::size_t i) { out[i] = (a[i] / 2.0) * b[i]; });
+}
+
+/*
+ *  MARK: scaled_product()
+ *  out = k * (a * b)  -  Circle::area(), EquilateralTriangle::area()
+ */
+inline
+void scaled_product(double k, double const * a, double const * b,
+                    double * out, std::size_t n) {
+  auto const kk = Lane::set1(k);
+  for_each_lane(n,
+    [&](std::size_t i) { (kk * (Lane::load(a + i) * Lane::load(b + i))).store(out + i); },
+    [&](std::size_t i) { out[i] = k * (a[i] * b[i]); });
+}
+
+/*
+ *  MARK: scaled_sum()
+ *  out = k * (a + b)  -  Circle::circumference() with a == b == radius
+ */
+inline
+void scaled_sum(double k, double const * a, double const * b,
+                double * out, std::size_t n) {
+  auto const kk = Lane::set1(k);
+  for_each_lane(n,
+    [&](std::size_t i) { (kk * (Lane::load(a + i) + Lane::load(b + i))).store(out + i); },
+    [&](std::size_t i) { out[i] = k * (a[i] + b[i]); });
+}
+
+/*
+ *  MARK: sum3()
+ *  out = a + b + c  -  Triangle::perimeter()
+ */
+inline
+void sum3(double const * a, double const * b, double const * c,
+          double * out, std::size_t n) {
+  for_each_lane(n,
+    [&](std::size_t i) {
+      (Lane::load(a + i) + Lane::load(b + i) + Lane::load(c + i)).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = a[i] + b[i] + c[i]; });
+}
+
+/*
+ *  MARK: sum4()
+ *  out = a + b + c + d  -  Quadrilateral::perimeter()
+ */
+inline
+void sum4(double const * a, double const * b, double const * c, double const * d,
+          double * out, std::size_t n) {
+  for_each_lane(n,
+    [&](std::size_t i) {
+      (Lane::load(a + i) + Lane::load(b + i)
+        + Lane::load(c + i) + Lane::load(d + i)).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = a[i] + b[i] + c[i] + d[i]; });
+}
+
+/*
+ *  MARK: store_mask()
+ *  out[j] = bit j of m, for the lanes of one vector.
+ */
+inline
+void store_mask(unsigned m, std::uint8_t * out) {
+  for (std::size_t j = 0; j < Lane::width; ++j) {
+    out[j] = static_cast<std::uint8_t>((m >> j) & 1);
+  }
+}
+
+/*
+ *  MARK: inside_circle()
+ *  out = (x - cx) * (x - cx) + (y - cy) * (y - cy) <= r2
+ */
+inline
+void inside_circle(double cx, double cy, double r2,
+                   double const * x, double const * y, std::uint8_t * out, std::size_t n) {
+  auto const vcx = Lane::set1(cx);
+  auto const vcy = Lane::set1(cy);
+  auto const vr2 = Lane::set1(r2);
+  for_each_lane(n,
+    [&](std::size_t i) {
+      auto const dx = Lane::load(x + i) - vcx;
+      auto const dy = Lane::load(y + i) - vcy;
+      store_mask((dx * dx + dy * dy <= vr2).mask(), out + i);
+    },
+    [&](std::size_t i) {
+      auto const dx = x[i] - cx;
+      auto const dy = y[i] - cy;
+      out[i] = dx * dx + dy * dy <= r2;
+    });
+}
+
+/*
+ *  MARK: inside_edges()
+ *  out = 0 <= a[e] * x + b[e] * y + c[e] for every edge e  -  convex
+ *  polygons, one edge function per side.
+ */
+inline
+void inside_edges(double const * a, double const * b, double const * c, std::size_t edges,
+                  double const * x, double const * y, std::uint8_t * out, std::size_t n) {
+  auto const zero = Lane::set1(0);
+  for_each_lane(n,
+    [&](std::size_t i) {
+      auto const vx = Lane::load(x + i);
+      auto const vy = Lane::load(y + i);
+      auto in = zero <= Lane::set1(a[0]) * vx + Lane::set1(b[0]) * vy + Lane::set1(c[0]);
+      for (std::size_t e = 1; e < edges; ++e) {
+        in = in & (zero <= Lane::set1(a[e]) * vx + Lane::set1(b[e]) * vy + Lane::set1(c[e]));
+      }
+      store_mask(in.mask(), out + i);
+    },
+    [&](std::size_t i) {
+      bool in = true;
+      for (std::size_t e = 0; e < edges; ++e) {
+        in = in && 0 <= a[e] * x[i] + b[e] * y[i] + c[e];
+      }
+      out[i] = in;
+    });
+}
+
+/*
+ *  MARK: check_lengths()
+ *  out = out && 0 <= a && a <= max  -  NaN and infinities fail.
+ */
+inline
+void check_lengths(double const * a, std::uint8_t * out, std::size_t n) {
+  auto const zero = Lane::set1(0);
+  auto const max = Lane::set1(1.7976931348623157e308);
+  for_each_lane(n,
+    [&](std::size_t i) {
+      auto const x = Lane::load(a + i);
+      auto const m = ((zero <= x) & (x <= max)).mask();
+      for (std::size_t j = 0; j < Lane::width; ++j) {
+        out[i + j] &= static_cast<std::uint8_t>((m >> j) & 1);
+      }
+    },
+    [&](std::size_t i) { out[i] &= 0 <= a[i] && a[i] <= 1.7976931348623157e308; });
+}
+
+/*
+ *  MARK: ring_sums()
+ *  out[r] = the sum of term(i, offset[r]) for i from offset[r] over
+ *  length[r] terms.  Lane j sums terms j, j + width, ... of the full
+ *  vectors; the lanes are then added in order, then the terms left over
+ *  one by one.  The sum so depends on the lane width, as the float sums
+ *  do, but not on how many rings are summed at once.
+ */
+template <typename VecTerm, typename ScalarTerm>
+inline
+void ring_sums(std::size_t const * offset, std::size_t const * length,
+               double * out, std::size_t n, VecTerm vterm, ScalarTerm sterm) {
+  constexpr auto width = Lane::width;
+  for (std::size_t r = 0; r < n; ++r) {
+    auto const first = offset[r];
+    auto i = first;
+    auto const end = i + length[r];
+    double sum = 0;
+    if (length[r] >= width) {
+      auto part = vterm(i, first);
+      for (i += width; i + width <= end; i += width) {
+        part = part + vterm(i, first);
+      }
+      double lanes[width];
+      part.store(lanes);
+      sum = lanes[0];
+      for (std::size_t j = 1; j < width; ++j) {
+        sum += lanes[j];
+      }
+    }
+    for (; i < end; ++i) {
+      sum += sterm(i, first);
+    }
+    out[r] = sum;
+  }
+}
+
+/*
+ *  MARK: cross_sums()
+ *  ring sums of (x[i] - x0) * (y[i + 1] - y0) - (x[i + 1] - x0) *
+ *  (y[i] - y0), x0, y0 the ring's first vertex  -  Polygon::area()
+ *  before the halving.  Taken from the first vertex the products stay
+ *  the size of the polygon; on raw coordinates far from the origin
+ *  they cancel away.
+ */
+inline
+void cross_sums(double const * x, double const * y, std::size_t const * offset,
+                std::size_t const * length, double * out, std::size_t n) {
+  ring_sums(offset, length, out, n,
+    [&](std::size_t i, std::size_t first) {
+      auto const x0 = Lane::set1(x[first]);
+      auto const y0 = Lane::set1(y[first]);
+      return (Lane::load(x + i) - x0) * (Lane::load(y + i + 1) - y0)
+             - (Lane::load(x + i + 1) - x0) * (Lane::load(y + i) - y0);
+    },
+    [&](std::size_t i, std::size_t first) {
+      auto const x0 = x[first];
+      auto const y0 = y[first];
+      return (x[i] - x0) * (y[i + 1] - y0) - (x[i + 1] - x0) * (y[i] - y0);
+    });
+}
+
+/*
+ *  MARK: edge_sums()
+ *  ring sums of sqrt(dx * dx + dy * dy), dx = x[i + 1] - x[i]  -
+ *  Polygon::perimeter()
+ */
+inline
+void edge_sums(double const * x, double const * y, std::size_t const * offset,
+               std::size_t const * length, double * out, std::size_t n) {
+  ring_sums(offset, length, out, n,
+    [&](std::size_t i, std::size_t) {
+      auto const dx = Lane::load(x + i + 1) - Lane::load(x + i);
+      auto const dy = Lane::load(y + i + 1) - Lane::load(y + i);
+      return sqrt(dx * dx + dy * dy);
+    },
+    [&](std::size_t i, std::size_t) {
+      auto const dx = x[i + 1] - x[i];
+      auto const dy = y[i + 1] - y[i];
+      return std::sqrt(dx * dx + dy * dy);
+    });
+}
+
+/*
+ *  MARK: ring_measures()
+ *  cross_sums() and edge_sums() in one pass, each vertex loaded once;
+ *  the sums are theirs, bit for bit.
+ */
+inline
+void ring_measures(double const * x, double const * y, std::size_t const * offset,
+                   std::size_t const * length, double * cross, double * edge, std::size_t n) {
+  constexpr auto width = Lane::width;
+  auto const terms = [&](std::size_t i, Lane ox, Lane oy, Lane & c, Lane & e) {
+    auto const x0 = Lane::load(x + i);
+    auto const x1 = Lane::load(x + i + 1);
+    auto const y0 = Lane::load(y + i);
+    auto const y1 = Lane::load(y + i + 1);
+    auto const dx = x1 - x0;
+    auto const dy = y1 - y0;
+    c = (x0 - ox) * (y1 - oy) - (x1 - ox) * (y0 - oy);
+    e = sqrt(dx * dx + dy * dy);
+  };
+  auto const reduce = [](Lane part) {
+    double lanes[width];
+    part.store(lanes);
+    auto sum = lanes[0];
+    for (std::size_t j = 1; j < width; ++j) {
+      sum += lanes[j];
+    }
+    return sum;
+  };
+  for (std::size_t r = 0; r < n; ++r) {
+    auto i = offset[r];
+    auto const end = i + length[r];
+    auto const ox = x[i];
+    auto const oy = y[i];
+    double c = 0;
+    double e = 0;
+    if (length[r] >= width) {
+      auto const vox = Lane::set1(ox);
+      auto const voy = Lane::set1(oy);
+      Lane vc;
+      Lane ve;
+      terms(i, vox, voy, vc, ve);
+      for (i += width; i + width <= end; i += width) {
+        Lane tc;
+        Lane te;
+        terms(i, vox, voy, tc, te);
+        vc = vc + tc;
+        ve = ve + te;
+      }
+      c = reduce(vc);
+      e = reduce(ve);
+    }
+    for (; i < end; ++i) {
+      c += (x[i] - ox) * (y[i + 1] - oy) - (x[i + 1] - ox) * (y[i] - oy);
+      auto const dx = x[i + 1] - x[i];
+      auto const dy = y[i + 1] - y[i];
+      e += std::sqrt(dx * dx + dy * dy);
+    }
+    cross[r] = c;
+    edge[r] = e;
+  }
+}
+
+/*
+ *  MARK: classify_triangles()
+ *  flags = the triangle_ bits of sides a, b, c, and area by Heron's
+ *  formula in Kahan's form over the sides sorted, NaN unless valid.
+ *  Valid sides are positive and finite and meet the strict triangle
+ *  inequality; the other bits compare within tolerance times the
+ *  longest side (its square for right).  Right isosceles is right with
+ *  the two shorter sides, the legs, equal: a needle whose two long
+ *  sides are equal is right and isosceles but not that.
+ */
+constexpr std::uint8_t triangle_valid           = 1;
+constexpr std::uint8_t triangle_right           = 2;
+constexpr std::uint8_t triangle_isosceles       = 4;
+constexpr std::uint8_t triangle_equilateral     = 8;
+constexpr std::uint8_t triangle_right_isosceles = 16;
+
+inline
+void classify_triangles(double const * a, double const * b, double const * c, double tolerance,
+                        std::uint8_t * flags, double * area, std::size_t n) {
+  auto const finish = [&](std::size_t i, unsigned valid, unsigned right, unsigned isosceles,
+                          unsigned equilateral, unsigned legs) {
+    if (valid == 0) {
+      flags[i] = 0;
+      area[i] = NAN;
+      return;
+    }
+    flags[i] = static_cast<std::uint8_t>(triangle_valid | (right != 0 ? triangle_right : 0)
+                                         | (isosceles != 0 ? triangle_isosceles : 0)
+                                         | (equilateral != 0 ? triangle_equilateral : 0)
+                                         | (right != 0 && legs != 0 ? triangle_right_isosceles : 0));
+  };
+  auto const zero = Lane::set1(0);
+  auto const big = Lane::set1(1.7976931348623157e308);
+  auto const tol = Lane::set1(tolerance);
+  auto const quarter = Lane::set1(0.25);
+  for_each_lane(n,
+    [&](std::size_t i) {
+      auto const va = Lane::load(a + i);
+      auto const vb = Lane::load(b + i);
+      auto const vc = Lane::load(c + i);
+      auto const positive = (zero < va) & (va <= big) & (zero < vb) & (vb <= big)
+                            & (zero < vc) & (vc <= big);
+      auto const ab = min(va, vb);
+      auto const top = max(va, vb);
+      auto const hi = max(top, vc);
+      auto const rest = min(top, vc);
+      auto const mid = max(ab, rest);
+      auto const lo = min(ab, rest);
+      auto const valid = positive & (hi < lo + mid);
+      auto const eps = tol * hi;
+      auto const eps2 = tol * (hi * hi);
+      auto const d = lo * lo + mid * mid - hi * hi;
+      auto const right = (d <= eps2) & (zero - eps2 <= d);
+      auto const legs = mid - lo <= eps;
+      auto const isosceles = legs | (hi - mid <= eps);
+      auto const equilateral = hi - lo <= eps;
+      (quarter * sqrt((hi + (mid + lo)) * (lo - (hi - mid)) * (lo + (hi - mid))
+                      * (hi + (mid - lo)))).store(area + i);
+      auto const mv = valid.mask();
+      auto const mr = right.mask();
+      auto const mi = isosceles.mask();
+      auto const me = equilateral.mask();
+      auto const ml = legs.mask();
+      for (std::size_t j = 0; j < Lane::width; ++j) {
+        finish(i + j, (mv >> j) & 1, (mr >> j) & 1, (mi >> j) & 1, (me >> j) & 1, (ml >> j) & 1);
+      }
+    },
+    [&](std::size_t i) {
+      auto const positive = 0 < a[i] && a[i] <= 1.7976931348623157e308
+                            && 0 < b[i] && b[i] <= 1.7976931348623157e308
+                            && 0 < c[i] && c[i] <= 1.7976931348623157e308;
+      auto const ab = std::min(a[i], b[i]);
+      auto const top = std::max(a[i], b[i]);
+      auto const hi = std::max(top, c[i]);
+      auto const rest = std::min(top, c[i]);
+      auto const mid = std::max(ab, rest);
+      auto const lo = std::min(ab, rest);
+      auto const valid = positive && hi < lo + mid;
+      auto const eps = tolerance * hi;
+      auto const eps2 = tolerance * (hi * hi);
+      auto const d = lo * lo + mid * mid - hi * hi;
+      area[i] = 0.25 * std::sqrt((hi + (mid + lo)) * (lo - (hi - mid)) * (lo + (hi - mid))
+                                 * (hi + (mid - lo)));
+      auto const legs = mid - lo <= eps;
+      finish(i, valid, d <= eps2 && 0 - eps2 <= d, legs || hi - mid <= eps, hi - lo <= eps, legs);
+    });
+}
+
+//  MARK: - Single precision.
+/*
+ *  Float forms of the metric kernels for ShapeBatchFloat, in the same
+ *  evaluation order as the double forms.  Element by element the
+ *  vector and scalar paths agree bit for bit; the sums depend on the
+ *  lane width.
+ */
+
+/*
+ *  MARK: product()
+ */
+inline
+void product(float const * a, float const * b, float * out, std::size_t n) {
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) { (FloatLane::load(a + i) * FloatLane::load(b + i)).store(out + i); },
+    [&](std::size_t i) { out[i] = a[i] * b[i]; });
+}
+
+/*
+ *  MARK: half_product()
+ */
+inline
+void half_product(float const * a, float const * b, float * out, std::size_t n) {
+  auto const half = FloatLane::set1(0.5f);
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      (FloatLane::load(a + i) * half * FloatLane::load(b + i)).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = (a[i] / 2.0f) * b[i]; });
+}
+
+/*
+ *  MARK: scaled_product()
+ */
+inline
+void scaled_product(float k, float const * a, float const * b, float * out, std::size_t n) {
+  auto const kk = FloatLane::set1(k);
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      (kk * (FloatLane::load(a + i) * FloatLane::load(b + i))).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = k * (a[i] * b[i]); });
+}
+
+/*
+ *  MARK: scaled_sum()
+ */
+inline
+void scaled_sum(float k, float const * a, float const * b, float * out, std::size_t n) {
+  auto const kk = FloatLane::set1(k);
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      (kk * (FloatLane::load(a + i) + FloatLane::load(b + i))).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = k * (a[i] + b[i]); });
+}
+
+/*
+ *  MARK: sum3()
+ */
+inline
+void sum3(float const * a, float const * b, float const * c, float * out, std::size_t n) {
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      (FloatLane::load(a + i) + FloatLane::load(b + i) + FloatLane::load(c + i)).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = a[i] + b[i] + c[i]; });
+}
+
+/*
+ *  MARK: sum4()
+ */
+inline
+void sum4(float const * a, float const * b, float const * c, float const * d,
+          float * out, std::size_t n) {
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      (FloatLane::load(a + i) + FloatLane::load(b + i)
+        + FloatLane::load(c + i) + FloatLane::load(d + i)).store(out + i);
+    },
+    [&](std::size_t i) { out[i] = a[i] + b[i] + c[i] + d[i]; });
+}
+
+/*
+ *  MARK: scaled()
+ *  out = k * a  -  EquilateralTriangle::height_
+ */
+inline
+void scaled(float k, float const * a, float * out, std::size_t n) {
+  auto const kk = FloatLane::set1(k);
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) { (kk * FloatLane::load(a + i)).store(out + i); },
+    [&](std::size_t i) { out[i] = k * a[i]; });
+}
+
+/*
+ *  MARK: hypotenuse()
+ *  out = sqrt((k * a) * (k * a) + b * b)  -  the derived sides; no
+ *  rescaling as in std::hypot, so the squares must stay finite.
+ */
+inline
+void hypotenuse(float k, float const * a, float const * b, float * out, std::size_t n) {
+  auto const kk = FloatLane::set1(k);
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) {
+      auto const x = kk * FloatLane::load(a + i);
+      auto const y = FloatLane::load(b + i);
+      sqrt(x * x + y * y).store(out + i);
+    },
+    [&](std::size_t i) {
+      auto const x = k * a[i];
+      out[i] = std::sqrt(x * x + b[i] * b[i]);
+    });
+}
+
+/*
+ *  MARK: sum()
+ *  float accumulators, one per lane, added in lane order at the end.
+ */
+inline
+float sum(float const * a, std::size_t n) {
+  auto acc = FloatLane::set1(0);
+  float tail = 0;
+  for_each_lane<FloatLane>(n,
+    [&](std::size_t i) { acc = acc + FloatLane::load(a + i); },
+    [&](std::size_t i) { tail += a[i]; });
+  float lanes[FloatLane::width];
+  acc.store(lanes);
+  float total = 0;
+  for (auto const x : lanes) {
+    total += x;
+  }
+  return total + tail;
+}
+
+/*
+ *  MARK: widened_sum()
+ *  each value widened to double and added in double accumulators.
+ */
+inline
+double widened_sum(float const * a, std::size_t n) {
+  auto acc = Lane::set1(0);
+  double tail = 0;
+  for_each_lane(n,
+    [&](std::size_t i) { acc = acc + Lane::load(a + i); },
+    [&](std::size_t i) { tail += a[i]; });
+  double lanes[Lane::width];
+  acc.store(lanes);
+  double total = 0;
+  for (auto const x : lanes) {
+    total += x;
+  }
+  return total + tail;
+}
+
+} /* namespace shape_kernels */
+
+#endif /* ShapeKernels_hpp */
@@ -0,0 +1,510 @@
+//
+//  ShapeLoader.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 18:05:12.3306
+//
+
+#include "ShapeLoader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std::literals::string_literals;
+
+namespace shape_loader {
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr char file_magic[4] = { 'S', 'H', 'R', 'C' };
+
+//  below this a chunk is not worth a thread
+constexpr std::size_t min_chunk = std::size_t(256) << 10;
+
+/*
+ *  MARK: Span
+ *  bytes [first, last) that start at offset in the file.
+ */
+struct Span {
+  char const * first;
+  char const * last;
+  std::size_t offset;
+};
+
+[[noreturn]]
+void bad_record(std::string const & path, std::size_t offset) {
+  throw std::runtime_error(path + ": malformed shape record at byte "s
+                           + std::to_string(offset));
+}
+
+char const * skip_blanks(char const * p, char const * last) {
+  while (p != last && (*p == ' ' || *p == '\t')) {
+    ++p;
+  }
+  return p;
+}
+
+std::string_view trim(char const * first, char const * last) {
+  first = skip_blanks(first, last);
+  while (last != first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) {
+    --last;
+  }
+  return { first, static_cast<std::size_t>(last - first) };
+}
+
+bool parse_kind(std::string_view name, ShapeKind & kind) {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    if (name == shape_layouts[k].name) {
+      kind = static_cast<ShapeKind>(k);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse_number(std::string_view text, double & value) {
+  if (!text.empty() && text.front() == '+') {
+    text.remove_prefix(1);
+  }
+  auto const last = text.data() + text.size();
+  auto const r = std::from_chars(text.data(), last, value);
+  return r.ec == std::errc() && r.ptr == last;
+}
+
+/*
+ *  MARK: parse_line()
+ *  one CSV record, from its first non-blank to the newline.
+ */
+bool parse_line(char const * first, char const * last, ShapeBatch & out,
+                std::vector<ShapeKind> * kinds) {
+  auto comma = std::find(first, last, ',');
+  ShapeKind kind;
+  if (!parse_kind(trim(first, comma), kind)) {
+    return false;
+  }
+
+  double params[4];
+  std::size_t count = 0;
+  while (comma != last) {
+    auto const field = comma + 1;
+    comma = std::find(field, last, ',');
+    if (count == 4 || !parse_number(trim(field, comma), params[count])) {
+      return false;
+    }
+    ++count;
+  }
+  if (!out.append(kind, params, count)) {
+    return false;
+  }
+  if (kinds != nullptr) {
+    kinds->push_back(kind);
+  }
+  return true;
+}
+
+/*
+ *  MARK: parse_csv()
+ */
+void parse_csv(Span span, ShapeBatch & out, LoadStats & stats,
+               std::string const & path, bool strict,
+               std::vector<ShapeKind> * kinds = nullptr) {
+  auto p = span.first;
+  while (p != span.last) {
+    auto const eol = std::find(p, span.last, '\n');
+    auto const text = skip_blanks(p, eol);
+    if (text == eol || *text == '\r' || *text == '#') {
+      //  blank or comment
+    }
+    else if (parse_line(text, eol, out, kinds)) {
+      ++stats.records;
+    }
+    else if (strict) {
+      bad_record(path, span.offset + static_cast<std::size_t>(p - span.first));
+    }
+    else {
+      ++stats.rejected;
+    }
+    p = eol == span.last ? eol : eol + 1;
+  }
+}
+
+/*
+ *  MARK: parse_binary()
+ *  span holds whole records; memcpy keeps the reads alignment-safe.
+ */
+void parse_binary(Span span, ShapeBatch & out, LoadStats & stats,
+                  std::string const & path, bool strict) {
+  for (auto p = span.first; p != span.last; p += sizeof(Record)) {
+    Record record;
+    std::memcpy(&record, p, sizeof(Record));
+    if (record.kind < shape_kind_count
+        && out.append(static_cast<ShapeKind>(record.kind), record.params, record.count)) {
+      ++stats.records;
+    }
+    else if (strict) {
+      bad_record(path, span.offset + static_cast<std::size_t>(p - span.first));
+    }
+    else {
+      ++stats.rejected;
+    }
+  }
+}
+
+/*
+ *  MARK: Class Ingest
+ *
+ *  Parses mapped spans on up to `threads` threads.  The per-thread
+ *  batches live as long as the Ingest, so after the first window they
+ *  parse into storage that is already allocated.
+ */
+class Ingest {
+public:
+  Ingest(std::string const & path, RecordFormat format, LoadOptions const & options)
+    : path_(path), format_(format), strict_(options.strict),
+      threads_(options.threads != 0
+               ? options.threads
+               : std::max(1u, std::thread::hardware_concurrency())),
+      parts_(threads_), stats_(threads_), errors_(threads_) {}
+
+  void operator()(Span span, ShapeBatch & out, LoadStats & stats);
+
+protected:
+  //  hide implementation details from the interface
+  std::vector<Span> split(Span span) const;
+  void parse(Span span, ShapeBatch & out, LoadStats & stats) const;
+
+  std::string const & path_;
+  RecordFormat format_;
+  bool strict_;
+  unsigned threads_;
+  std::vector<ShapeBatch> parts_;
+  std::vector<LoadStats> stats_;
+  std::vector<std::exception_ptr> errors_;
+};
+
+/*
+ *  MARK: Ingest::split()
+ *  up to threads_ chunks, each ending on a record boundary.
+ */
+std::vector<Span> Ingest::split(Span span) const {
+  auto const length = static_cast<std::size_t>(span.last - span.first);
+  auto const n = std::max<std::size_t>(1, std::min<std::size_t>(threads_, length / min_chunk));
+
+  std::vector<Span> chunks;
+  chunks.reserve(n);
+  auto first = span.first;
+  for (std::size_t c = 1; c <= n && first != span.last; ++c) {
+    auto last = span.first + length / n * c;
+    if (c == n) {
+      last = span.last;
+    }
+    else if (format_ == RecordFormat::binary) {
+      last = first + (last - first) / sizeof(Record) * sizeof(Record);
+    }
+    else {
+      last = std::find(std::max(first, last), span.last, '\n');
+      last = last == span.last ? last : last + 1;
+    }
+    chunks.push_back({ first, last,
+                       span.offset + static_cast<std::size_t>(first - span.first) });
+    first = last;
+  }
+  return chunks;
+}
+
+/*
+ *  MARK: Ingest::parse()
+ */
+void Ingest::parse(Span span, ShapeBatch & out, LoadStats & stats) const {
+  if (format_ == RecordFormat::binary) {
+    parse_binary(span, out, stats, path_, strict_);
+  }
+  else {
+    parse_csv(span, out, stats, path_, strict_);
+  }
+}
+
+/*
+ *  MARK: Ingest::operator()()
+ *  chunk results are appended in file order, so the batch is the same
+ *  whatever the thread count.
+ */
+void Ingest::operator()(Span span, ShapeBatch & out, LoadStats & stats) {
+  auto const chunks = split(span);
+  if (chunks.size() <= 1) {
+    for (auto const & chunk : chunks) {
+      parse(chunk, out, stats);
+    }
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(chunks.size());
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    parts_[c].clear();
+    stats_[c] = {};
+    errors_[c] = nullptr;
+    workers.emplace_back([this, c, &chunks] {
+      try {
+        parse(chunks[c], parts_[c], stats_[c]);
+      }
+      catch (...) {
+        errors_[c] = std::current_exception();
+      }
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    if (errors_[c]) {
+      std::rethrow_exception(errors_[c]);
+    }
+  }
+  for (std::size_t c = 0; c < chunks.size(); ++c) {
+    out.append(parts_[c]);
+    stats.records += stats_[c].records;
+    stats.rejected += stats_[c].rejected;
+  }
+}
+
+/*
+ *  MARK: open_records()
+ *  the resolved format, and the offset of the first record.
+ */
+RecordFormat open_records(MappedFile & file, std::string const & path,
+                          RecordFormat format, std::size_t & start) {
+  FileHeader header {};
+  auto const has_header = file.size() >= sizeof(FileHeader);
+  if (has_header) {
+    std::memcpy(&header, file.map(0, sizeof(FileHeader)), sizeof(FileHeader));
+    file.unmap();
+  }
+  auto const magic = has_header
+                     && std::memcmp(header.magic, file_magic, sizeof(file_magic)) == 0;
+
+  if (format == RecordFormat::detect) {
+    format = magic ? RecordFormat::binary : RecordFormat::csv;
+  }
+  if (format == RecordFormat::csv) {
+    start = 0;
+    return format;
+  }
+
+  if (!magic || header.version != file_version || header.record_size != sizeof(Record)) {
+    throw std::runtime_error(path + ": not a shape record file"s);
+  }
+  if ((file.size() - sizeof(FileHeader)) % sizeof(Record) != 0) {
+    throw std::runtime_error(path + ": truncated shape record file"s);
+  }
+  start = sizeof(FileHeader);
+  return format;
+}
+
+/*
+ *  MARK: for_each_window()
+ *  maps [start, size) a window at a time, cut back to the last whole
+ *  record, and ingests each into out before calling done.
+ */
+template <typename Done>
+LoadStats for_each_window(std::string const & path, LoadOptions const & options,
+                          std::size_t window, ShapeBatch & out, Done done) {
+  MappedFile file(path);
+  std::size_t pos = 0;
+  auto const format = open_records(file, path, options.format, pos);
+  Ingest ingest(path, format, options);
+
+  if (format == RecordFormat::binary) {
+    window = std::max(window, sizeof(Record));
+  }
+
+  LoadStats stats;
+  while (pos < file.size()) {
+    auto length = std::min(window, file.size() - pos);
+    auto const first = file.map(pos, length);
+    auto const at_end = pos + length == file.size();
+
+    if (format == RecordFormat::binary) {
+      length -= length % sizeof(Record);
+    }
+    else if (!at_end) {
+      //  up to and including the last newline in the window
+      auto last = first + length;
+      while (last != first && last[-1] != '\n') {
+        --last;
+      }
+      if (last == first) {
+        throw std::runtime_error(path + ": shape record longer than the load window"s);
+      }
+      length = static_cast<std::size_t>(last - first);
+    }
+
+    ingest({ first, first + length, pos }, out, stats);
+    pos += length;
+    stats.bytes += length;
+    ++stats.windows;
+    file.unmap();
+    done(out);
+  }
+  return stats;
+}
+
+} /* namespace */
+
+//  MARK: - Class MappedFile Implementation.
+/*
+ *  MARK: MappedFile::MappedFile() - c'tor
+ */
+MappedFile::MappedFile(std::string const & path)
+  : fd_(::open(path.c_str(), O_RDONLY | O_CLOEXEC)), size_(0),
+    base_(nullptr), mapped_(0) {
+  if (fd_ < 0) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) {
+    auto const error = errno;
+    ::close(fd_);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+}
+
+/*
+ *  MARK: MappedFile::~MappedFile() - d'tor
+ */
+MappedFile::~MappedFile() {
+  unmap();
+  ::close(fd_);
+}
+
+/*
+ *  MARK: MappedFile::map()
+ */
+char const *
+MappedFile::map(std::size_t offset, std::size_t length) {
+  unmap();
+  static auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  auto const skip = offset % page;
+
+  auto const base = ::mmap(nullptr, length + skip, PROT_READ, MAP_PRIVATE, fd_,
+                           static_cast<off_t>(offset - skip));
+  if (base == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "mmap"s);
+  }
+  base_ = base;
+  mapped_ = length + skip;
+  ::madvise(base_, mapped_, MADV_SEQUENTIAL);
+  return static_cast<char const *>(base_) + skip;
+}
+
+/*
+ *  MARK: MappedFile::unmap()
+ */
+void
+MappedFile::unmap() noexcept {
+  if (base_ != nullptr) {
+    ::munmap(base_, mapped_);
+    base_ = nullptr;
+    mapped_ = 0;
+  }
+}
+
+//  MARK: - Implementation.
+/*
+ *  MARK: load_shapes()
+ *  the whole file as one window; address space, not memory, bounds it.
+ */
+LoadStats load_shapes(std::string const & path, ShapeBatch & batch,
+                      LoadOptions const & options) {
+  return for_each_window(path, options, SIZE_MAX, batch, [](ShapeBatch const &) {});
+}
+
+/*
+ *  MARK: stream_shapes()
+ */
+LoadStats stream_shapes(std::string const & path,
+                        std::function<void(ShapeBatch const &)> const & sink,
+                        LoadOptions const & options) {
+  ShapeBatch window;
+  return for_each_window(path, options, options.window, window,
+                         [&sink](ShapeBatch & out) {
+                           sink(out);
+                           out.clear();
+                         });
+}
+
+/*
+ *  MARK: parse_records()
+ */
+LoadStats parse_records(std::string_view text, ShapeBatch & batch,
+                        std::vector<ShapeKind> * kinds, bool strict,
+                        std::string const & name, std::size_t offset) {
+  LoadStats stats;
+  parse_csv({ text.data(), text.data() + text.size(), offset }, batch, stats, name, strict, kinds);
+  stats.bytes = text.size();
+  return stats;
+}
+
+/*
+ *  MARK: save_records()
+ */
+void save_records(std::string const & path, ShapeBatch const & batch) {
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::fopen(path.c_str(), "wb"),
+                                                        &std::fclose);
+  if (!file) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+
+  FileHeader header {};
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.record_size = sizeof(Record);
+  auto ok = std::fwrite(&header, sizeof(header), 1, file.get()) == 1;
+
+  //  a page of records at a time
+  Record buffer[102];
+  std::size_t buffered = 0;
+  for (std::size_t k = 0; k < shape_kind_count && ok; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const & layout = layout_of(kind);
+    for (std::size_t i = 0; i < batch.size(kind) && ok; ++i) {
+      auto & record = buffer[buffered++];
+      record = {};
+      record.kind = static_cast<std::uint8_t>(k);
+      record.count = layout.params;
+      for (std::size_t f = 0; f < layout.params; ++f) {
+        record.params[f] = batch.column(kind, f)[i];
+      }
+      if (buffered == std::size(buffer)) {
+        ok = std::fwrite(buffer, sizeof(Record), buffered, file.get()) == buffered;
+        buffered = 0;
+      }
+    }
+  }
+  ok = ok && std::fwrite(buffer, sizeof(Record), buffered, file.get()) == buffered;
+  ok = std::fflush(file.get()) == 0 && ok;
+  if (!ok) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+}
+
+} /* namespace shape_loader */
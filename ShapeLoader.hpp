@@ -0,0 +1,160 @@
+//
+//  ShapeLoader.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 18:05:12.3306
+//
+//  Memory-mapped ingestion of shape records into a ShapeBatch.
+//
+//  CSV records are one shape per line: the class name followed by the
+//  constructor arguments in constructor order,
+//
+//    Rectangle,3.0,4.0
+//    Parallelogram,2.0,5.0,3.0
+//    RightIsoscelesTriangle,7.0
+//
+//  Blank lines and lines starting with '#' are ignored.  Binary files
+//  are a FileHeader followed by fixed-size Records.
+//
+//  The mapped bytes are split into chunks on record boundaries and
+//  parsed by one thread per chunk straight into per-thread batches,
+//  which are appended to the output in file order.  Parsing works on
+//  the mapping in place; numbers go through std::from_chars, so no
+//  record allocates.
+//
+//  stream_shapes() maps one window at a time and hands each window's
+//  shapes to a callback before moving on, so memory stays bounded by
+//  the window size however large the file is.
+//
+//  MARK: - References.
+//  @see: https://pubs.opengroup.org/onlinepubs/9699919799/functions/mmap.html
+//  @see: https://en.cppreference.com/w/cpp/utility/from_chars
+//
+
+#ifndef ShapeLoader_hpp
+#define ShapeLoader_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+
+//  MARK: - Definitions.
+namespace shape_loader {
+
+/*
+ *  MARK: enum RecordFormat
+ *  detect picks binary when the file starts with the FileHeader magic.
+ */
+enum class RecordFormat : std::uint8_t {
+  detect,
+  csv,
+  binary,
+};
+
+/*
+ *  MARK: struct FileHeader
+ */
+struct FileHeader {
+  char          magic[4];   //  "SHRC"
+  std::uint16_t version;
+  std::uint16_t record_size;
+  std::uint64_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16, "record file layout is part of the file format");
+
+/*
+ *  MARK: struct Record
+ *  kind is a ShapeKind, count the number of params given.
+ */
+struct Record {
+  std::uint8_t kind;
+  std::uint8_t count;
+  std::uint8_t reserved[6];
+  double       params[4];
+};
+
+static_assert(sizeof(Record) == 40, "record file layout is part of the file format");
+
+constexpr std::uint16_t file_version = 1;
+
+/*
+ *  MARK: struct LoadOptions
+ *  threads == 0 uses every hardware thread.  Unless strict, malformed
+ *  records are counted and skipped instead of throwing.
+ */
+struct LoadOptions {
+  RecordFormat format  = RecordFormat::detect;
+  unsigned     threads = 0;
+  std::size_t  window  = std::size_t(64) << 20;
+  bool         strict  = true;
+};
+
+/*
+ *  MARK: struct LoadStats
+ */
+struct LoadStats {
+  std::size_t records  = 0;
+  std::size_t rejected = 0;
+  std::size_t bytes    = 0;
+  std::size_t windows  = 0;
+};
+
+/*
+ *  MARK: Class MappedFile
+ *
+ *  Read-only file with at most one mapped window.  map() accepts any
+ *  offset; the page alignment mmap() needs is handled internally.
+ *  Errors throw std::system_error.
+ */
+class MappedFile {
+public:
+  explicit MappedFile(std::string const & path);
+  ~MappedFile();
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile & operator=(MappedFile const &) = delete;
+
+  std::size_t size() const noexcept { return size_; }
+
+  //  map [offset, offset + length) and return its first byte
+  char const * map(std::size_t offset, std::size_t length);
+  void unmap() noexcept;
+
+protected:
+  //  hide implementation details from the interface
+  int fd_;
+  std::size_t size_;
+  void * base_;
+  std::size_t mapped_;
+};
+
+//  every shape in path appended to batch
+LoadStats load_shapes(std::string const & path, ShapeBatch & batch,
+                      LoadOptions const & options = {});
+
+//  shapes of each window of at most options.window bytes, in file
+//  order; the batch passed to sink is reused for the next window
+LoadStats stream_shapes(std::string const & path,
+                        std::function<void(ShapeBatch const &)> const & sink,
+                        LoadOptions const & options = {});
+
+//  the CSV records of text, whole lines, appended to batch; kinds, if
+//  given, receives each record's kind in text order.  Error messages
+//  name the source and the byte offset, text starting at offset.
+LoadStats parse_records(std::string_view text, ShapeBatch & batch,
+                        std::vector<ShapeKind> * kinds = nullptr, bool strict = true,
+                        std::string const & name = "CSV text", std::size_t offset = 0);
+
+//  binary record file of every shape in batch, kinds in ShapeKind order
+void save_records(std::string const & path, ShapeBatch const & batch);
+
+} /* namespace shape_loader */
+
+#endif /* ShapeLoader_hpp */
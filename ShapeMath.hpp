@@ -0,0 +1,260 @@
+//
+//  ShapeMath.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 22:36:05.4418
+//
+//  constexpr sqrt() and hypot().
+//
+//  At run time both forward to <cmath>.  In a constant expression they
+//  compute the correctly rounded result: a Newton estimate is nudged an
+//  ulp at a time until the exact residual puts it between the two
+//  rounding midpoints.  IEEE sqrt is correctly rounded, so sqrt() gives
+//  the same bits either way.  std::hypot is only faithfully rounded
+//  (glibc 2.36 misses the nearest double in roughly 1 call in 700), so
+//  a compile-time hypot() can sit an ulp from the run-time one; compare
+//  catalog values with a tolerance, not ==.  Subnormal hypot() results
+//  are rounded twice and may be an ulp off as well.
+//
+//  MARK: - References.
+//  @see: https://www.cs.cmu.edu/~quake/robust.html
+//  @see: https://en.cppreference.com/w/cpp/types/is_constant_evaluated
+//
+
+#ifndef ShapeMath_hpp
+#define ShapeMath_hpp
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+//  MARK: - Definitions.
+namespace shape_math {
+
+constexpr bool isnan(double x) noexcept {
+  return x != x;
+}
+
+constexpr double abs(double x) noexcept {
+  return x < 0 ? -x : x;
+}
+
+namespace detail {
+
+/*
+ *  MARK: Class Expansion
+ *  exact sum of doubles as non-overlapping terms, smallest first.
+ */
+class Expansion {
+public:
+  constexpr void add(double b) noexcept {
+    int n = 0;
+    for (int i = 0; i < size_; ++i) {
+      auto const s = b + term_[i];
+      auto const bv = s - b;
+      auto const e = (b - (s - bv)) + (term_[i] - bv);
+      if (e != 0) {
+        term_[n++] = e;
+      }
+      b = s;
+    }
+    if (b != 0) {
+      term_[n++] = b;
+    }
+    size_ = n;
+  }
+
+  constexpr int sign() const noexcept {
+    return size_ == 0 ? 0 : term_[size_ - 1] < 0 ? -1 : 1;
+  }
+
+  constexpr double estimate() const noexcept {
+    double sum = 0;
+    for (int i = 0; i < size_; ++i) {
+      sum += term_[i];
+    }
+    return sum;
+  }
+
+protected:
+  //  hide implementation details from the interface
+  double term_[8] {};
+  int size_ = 0;
+};
+
+/*
+ *  MARK: add_product()
+ *  adds a * b exactly, using Dekker's split (no fma in constexpr).
+ */
+constexpr void add_product(Expansion & e, double a, double b) noexcept {
+  auto const split = [](double x, double & hi, double & lo) {
+    auto const c = 134217729.0 * x;
+    hi = c - (c - x);
+    lo = x - hi;
+  };
+  double ah = 0, al = 0, bh = 0, bl = 0;
+  split(a, ah, al);
+  split(b, bh, bl);
+  auto const p = a * b;
+  e.add(p);
+  e.add(((ah * bh - p) + ah * bl + al * bh) + al * bl);
+}
+
+constexpr double pow2(int k) noexcept {
+  double r = 1;
+  for (; k > 0; --k) {
+    r *= 2;
+  }
+  for (; k < 0; ++k) {
+    r *= 0.5;
+  }
+  return r;
+}
+
+//  spacing above and below r, for r in [1, 4)
+constexpr double ulp_above(double r) noexcept {
+  return r < 2 ? 0x1p-52 : 0x1p-51;
+}
+
+constexpr double ulp_below(double r) noexcept {
+  return r <= 1 ? 0x1p-53 : r <= 2 ? 0x1p-52 : 0x1p-51;
+}
+
+/*
+ *  MARK: below_square()
+ *  sign of s - (r + d)^2; r * d and d * d are exact.
+ */
+constexpr int below_square(Expansion s, double r, double d) noexcept {
+  add_product(s, -r, r);
+  s.add(-2 * r * d);
+  s.add(-(d * d));
+  return s.sign();
+}
+
+/*
+ *  MARK: root()
+ *  correctly rounded square root of s, for s in [1, 8).
+ */
+constexpr double root(Expansion const & s) noexcept {
+  auto const x = s.estimate();
+  double r = (1 + x) / 2;
+  for (int i = 0; i < 8; ++i) {
+    r = (r + x / r) / 2;
+  }
+  for (int i = 0; i < 4; ++i) {
+    if (below_square(s, r, ulp_above(r) / 2) >= 0) {
+      r += ulp_above(r);
+    }
+    else if (below_square(s, r, -ulp_below(r) / 2) < 0) {
+      r -= ulp_below(r);
+    }
+    else {
+      break;
+    }
+  }
+  return r;
+}
+
+/*
+ *  MARK: sqrt()
+ */
+constexpr double sqrt(double x) noexcept {
+  if (isnan(x) || x < 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (x == 0 || x == std::numeric_limits<double>::infinity()) {
+    return x;
+  }
+  //  x = m * 4^k with m in [1, 4)
+  int k = 0;
+  for (; x >= 0x1p64; x *= 0x1p-64) {
+    k += 32;
+  }
+  for (; x < 0x1p-64; x *= 0x1p64) {
+    k -= 32;
+  }
+  for (; x >= 4; x *= 0.25) {
+    ++k;
+  }
+  for (; x < 1; x *= 4) {
+    --k;
+  }
+  Expansion s;
+  s.add(x);
+  return root(s) * pow2(k);
+}
+
+/*
+ *  MARK: hypot()
+ */
+constexpr double hypot(double a, double b) noexcept {
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  a = abs(a);
+  b = abs(b);
+  if (a == inf || b == inf) {
+    return inf;
+  }
+  if (isnan(a) || isnan(b)) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (a < b) {
+    auto const t = a;
+    a = b;
+    b = t;
+  }
+  if (a == 0) {
+    return 0;
+  }
+  //  a * 2^j in [1, 2); b follows, and only underflows when it is far
+  //  too small to change the result
+  int j = 0;
+  for (; a >= 0x1p64; j -= 64) {
+    a *= 0x1p-64;
+    b *= 0x1p-64;
+  }
+  for (; a < 0x1p-64; j += 64) {
+    a *= 0x1p64;
+    b *= 0x1p64;
+  }
+  for (; a >= 2; --j) {
+    a *= 0.5;
+    b *= 0.5;
+  }
+  for (; a < 1; ++j) {
+    a *= 2;
+    b *= 2;
+  }
+  Expansion s;
+  add_product(s, a, a);
+  add_product(s, b, b);
+  auto const r = root(s);
+  //  2^-j may not be representable in one step
+  return j > 0 ? r * pow2(-j / 2) * pow2(-(j - j / 2)) : r * pow2(-j);
+}
+
+} /* namespace detail */
+
+/*
+ *  MARK: sqrt()
+ */
+constexpr double sqrt(double x) noexcept {
+  if (std::is_constant_evaluated()) {
+    return detail::sqrt(x);
+  }
+  return std::sqrt(x);
+}
+
+/*
+ *  MARK: hypot()
+ */
+constexpr double hypot(double a, double b) noexcept {
+  if (std::is_constant_evaluated()) {
+    return detail::hypot(a, b);
+  }
+  return std::hypot(a, b);
+}
+
+} /* namespace shape_math */
+
+#endif /* ShapeMath_hpp */
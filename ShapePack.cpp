@@ -0,0 +1,393 @@
+//
+//  ShapePack.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 07:26:05.8841
+//
+
+#include "ShapePack.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+/*
+ *  MARK: struct Spot
+ *  where a w x h rectangle would go; lower scores are better.
+ */
+struct Spot {
+  double x;
+  double y;
+  double score;
+  double tie;
+  std::size_t at;   //  heuristic's own
+};
+
+bool better(Spot const & a, Spot const & b) noexcept {
+  return a.score < b.score || (a.score == b.score && a.tie < b.tie);
+}
+
+/*
+ *  MARK: Class SkylineSheet
+ *  the upper outline of what is placed, as level segments [x, end) at
+ *  height y, left to right and covering the sheet's width.
+ */
+class SkylineSheet {
+public:
+  SkylineSheet(double width, double height)
+    : height_(height), line_ { { 0, width, 0 } } {}
+
+  //  lowest top, then leftmost
+  bool find(double w, double h, Spot & spot) const noexcept {
+    bool found = false;
+    for (std::size_t i = 0; i < line_.size(); ++i) {
+      auto const x = line_[i].x;
+      auto const right = x + w;
+      if (right > line_.back().end) {
+        break;
+      }
+      auto y = line_[i].y;
+      for (auto j = i + 1; j < line_.size() && line_[j].x < right; ++j) {
+        y = std::max(y, line_[j].y);
+      }
+      if (y + h > height_) {
+        continue;
+      }
+      Spot const s { x, y, y + h, x, i };
+      if (!found || better(s, spot)) {
+        spot = s;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  void place(Spot const & spot, double w, double h) {
+    auto const i = spot.at;
+    auto const right = spot.x + w;
+    auto j = i;
+    while (j < line_.size() && line_[j].end <= right) {
+      ++j;
+    }
+    if (j < line_.size() && line_[j].x < right) {
+      line_[j].x = right;
+    }
+    line_.erase(line_.begin() + i, line_.begin() + j);
+    line_.insert(line_.begin() + i, { spot.x, right, spot.y + h });
+    //  level neighbours become one segment
+    if (i + 1 < line_.size() && line_[i + 1].y == line_[i].y) {
+      line_[i].end = line_[i + 1].end;
+      line_.erase(line_.begin() + i + 1);
+    }
+    if (i > 0 && line_[i - 1].y == line_[i].y) {
+      line_[i - 1].end = line_[i].end;
+      line_.erase(line_.begin() + i);
+    }
+  }
+
+protected:
+  //  hide implementation details from the interface
+  struct Segment {
+    double x;
+    double end;
+    double y;
+  };
+
+  double height_;
+  std::vector<Segment> line_;
+};
+
+/*
+ *  MARK: Class MaxRectsSheet
+ *  every maximal free rectangle, none inside another.
+ */
+class MaxRectsSheet {
+public:
+  MaxRectsSheet(double width, double height)
+    : free_ { { 0, 0, width, height } } {}
+
+  //  best short side fit, then best long side fit
+  bool find(double w, double h, Spot & spot) const noexcept {
+    bool found = false;
+    for (std::size_t i = 0; i < free_.size(); ++i) {
+      auto const & f = free_[i];
+      auto const dw = (f.x1 - f.x0) - w;
+      auto const dh = (f.y1 - f.y0) - h;
+      if (dw < 0 || dh < 0) {
+        continue;
+      }
+      Spot const s { f.x0, f.y0, std::min(dw, dh), std::max(dw, dh), i };
+      if (!found || better(s, spot)) {
+        spot = s;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  //  free rectangles the part overlaps split into the pieces left
+  //  around it; a piece inside another goes, as does an older
+  //  rectangle inside a piece
+  void place(Spot const & spot, double w, double h) {
+    Rect const r { spot.x, spot.y, spot.x + w, spot.y + h };
+    pieces_.clear();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < free_.size(); ++i) {
+      auto const f = free_[i];
+      if (!(r.x0 < f.x1 && f.x0 < r.x1 && r.y0 < f.y1 && f.y0 < r.y1)) {
+        free_[kept++] = f;
+        continue;
+      }
+      if (f.x0 < r.x0) {
+        pieces_.push_back({ f.x0, f.y0, r.x0, f.y1 });
+      }
+      if (r.x1 < f.x1) {
+        pieces_.push_back({ r.x1, f.y0, f.x1, f.y1 });
+      }
+      if (f.y0 < r.y0) {
+        pieces_.push_back({ f.x0, f.y0, f.x1, r.y0 });
+      }
+      if (r.y1 < f.y1) {
+        pieces_.push_back({ f.x0, r.y1, f.x1, f.y1 });
+      }
+    }
+    free_.resize(kept);
+
+    for (std::size_t p = 0; p < pieces_.size(); ++p) {
+      auto const & piece = pieces_[p];
+      bool inside = std::any_of(free_.begin(), free_.end(),
+                                [&](Rect const & f) { return f.contains(piece); });
+      for (std::size_t q = 0; !inside && q < pieces_.size(); ++q) {
+        //  of two equal pieces the first stays
+        inside = q != p && pieces_[q].contains(piece) && !(q > p && piece.contains(pieces_[q]));
+      }
+      if (!inside) {
+        pieces_[p].keep = true;
+      }
+    }
+    auto const old = free_.size();
+    for (auto const & piece : pieces_) {
+      if (piece.keep) {
+        free_.push_back(piece);
+      }
+    }
+    free_.erase(std::remove_if(free_.begin(), free_.begin() + old, [&](Rect const & f) {
+      return std::any_of(free_.begin() + old, free_.end(),
+                         [&](Rect const & piece) { return piece.contains(f); });
+    }), free_.begin() + old);
+  }
+
+protected:
+  //  hide implementation details from the interface
+  struct Rect {
+    double x0;
+    double y0;
+    double x1;
+    double y1;
+    bool keep = false;
+
+    bool contains(Rect const & o) const noexcept {
+      return x0 <= o.x0 && y0 <= o.y0 && o.x1 <= x1 && o.y1 <= y1;
+    }
+  };
+
+  std::vector<Rect> free_;
+  std::vector<Rect> pieces_;
+};
+
+/*
+ *  MARK: validate()
+ */
+void validate(std::size_t n, PackOptions const & o) {
+  auto const side = [](double s) { return 0 < s && s <= std::numeric_limits<double>::max(); };
+  if (!side(o.width) || !side(o.height)) {
+    throw std::invalid_argument("pack: sheet sides must be positive and finite, got "s
+                                + std::to_string(o.width) + " x "s + std::to_string(o.height));
+  }
+  if (o.open == 0) {
+    throw std::invalid_argument("pack: at least one sheet must be open"s);
+  }
+  if (n >= Packing::unpacked) {
+    throw std::length_error("pack: too many rectangles, "s + std::to_string(n));
+  }
+}
+
+/*
+ *  MARK: run()
+ *  the packing loop over one kind of sheet.
+ */
+template <typename Sheet>
+Packing run(std::span<RectDims const> rects, PackOptions const & o) {
+  auto const n = rects.size();
+  Packing result;
+  result.at.assign(n, Placement {});
+  result.sheet.assign(n, Packing::unpacked);
+  result.width = o.width;
+  result.height = o.height;
+
+  //  those that fit an empty sheet one way or the other
+  auto const fits = [&](double w, double h) { return w <= o.width && h <= o.height; };
+  std::vector<std::uint32_t> order;
+  order.reserve(n);
+  for (std::uint32_t i = 0; i < n; ++i) {
+    auto const & r = rects[i];
+    if (r.length >= 0 && r.breadth >= 0
+        && (fits(r.length, r.breadth) || (o.rotate && fits(r.breadth, r.length)))) {
+      order.push_back(i);
+    }
+  }
+  result.rejected = n - order.size();
+  if (o.sort) {
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+      auto const & ra = rects[a];
+      auto const & rb = rects[b];
+      auto const la = o.rotate ? std::max(ra.length, ra.breadth) : ra.breadth;
+      auto const lb = o.rotate ? std::max(rb.length, rb.breadth) : rb.breadth;
+      auto const sa = o.rotate ? std::min(ra.length, ra.breadth) : ra.length;
+      auto const sb = o.rotate ? std::min(rb.length, rb.breadth) : rb.length;
+      return la > lb || (la == lb && sa > sb);
+    });
+  }
+
+  //  oldest first.  A sheet only fills up, so a rectangle at least as
+  //  long and as broad as one that missed it will miss it too.
+  struct Open {
+    std::uint32_t index;
+    Sheet sheet;
+    double miss_length = std::numeric_limits<double>::infinity();
+    double miss_breadth = std::numeric_limits<double>::infinity();
+  };
+  std::deque<Open> open;
+  auto const open_sheet = [&] {
+    if (open.size() == o.open) {
+      open.pop_front();
+    }
+    open.push_back({ static_cast<std::uint32_t>(result.used.size()), Sheet(o.width, o.height) });
+    result.used.push_back(0);
+  };
+  for (auto const i : order) {
+    auto const & r = rects[i];
+    //  nothing to make room for: the origin of an open sheet, turned
+    //  if it only fits that way
+    if (r.length == 0 || r.breadth == 0) {
+      if (open.empty()) {
+        open_sheet();
+      }
+      if (!fits(r.length, r.breadth)) {
+        result.at[i] = { r.breadth, 0, M_PI / 2 };
+      }
+      result.sheet[i] = open.front().index;
+      continue;
+    }
+    for (bool placed = false; !placed;) {
+      for (auto & sheet : open) {
+        if (r.length >= sheet.miss_length && r.breadth >= sheet.miss_breadth) {
+          continue;
+        }
+        Spot spot {};
+        Spot turned {};
+        auto const upright = fits(r.length, r.breadth)
+                             && sheet.sheet.find(r.length, r.breadth, spot);
+        auto const rotated = o.rotate && fits(r.breadth, r.length)
+                             && sheet.sheet.find(r.breadth, r.length, turned);
+        if (rotated && (!upright || better(turned, spot))) {
+          sheet.sheet.place(turned, r.breadth, r.length);
+          result.at[i] = { turned.x + r.breadth, turned.y, M_PI / 2 };
+        }
+        else if (upright) {
+          sheet.sheet.place(spot, r.length, r.breadth);
+          result.at[i] = { spot.x, spot.y, 0 };
+        }
+        else {
+          sheet.miss_length = r.length;
+          sheet.miss_breadth = r.breadth;
+          continue;
+        }
+        result.sheet[i] = sheet.index;
+        result.used[sheet.index] += r.length * r.breadth;
+        placed = true;
+        break;
+      }
+      if (!placed) {
+        open_sheet();
+      }
+    }
+  }
+  return result;
+}
+
+} /* namespace */
+
+//  MARK: - Class Packing Implementation.
+/*
+ *  MARK: Packing::utilization()
+ */
+double
+Packing::utilization() const noexcept {
+  if (used.empty()) {
+    return 0;
+  }
+  double total = 0;
+  for (auto const u : used) {
+    total += u;
+  }
+  return total / (static_cast<double>(used.size()) * width * height);
+}
+
+double
+Packing::utilization(std::size_t s) const noexcept {
+  return used[s] / (width * height);
+}
+
+//  MARK: - Implementation.
+/*
+ *  MARK: pack()
+ */
+Packing
+pack(std::span<RectDims const> rectangles, PackOptions const & options) {
+  validate(rectangles.size(), options);
+  switch (options.heuristic) {
+  case PackHeuristic::skyline:
+    return run<SkylineSheet>(rectangles, options);
+
+  case PackHeuristic::maxrects:
+    return run<MaxRectsSheet>(rectangles, options);
+  }
+  throw std::invalid_argument("pack: unknown heuristic"s);
+}
+
+Packing
+pack(ShapeBatchView const & batch, PackOptions const & options) {
+  auto const rectangles = batch.size(ShapeKind::rectangle);
+  auto const squares = batch.size(ShapeKind::square);
+  std::vector<RectDims> rects(rectangles + squares);
+  batch.dims(rects.data());
+  auto const length = batch.column(ShapeKind::square, 0);
+  for (std::size_t i = 0; i < squares; ++i) {
+    rects[rectangles + i] = { length[i], length[i] };
+  }
+  return pack(rects, options);
+}
+
+/*
+ *  MARK: pack() - jobs
+ *  one task per job.
+ */
+std::vector<Packing>
+pack(std::span<PackJob const> jobs, ThreadPool & pool) {
+  std::vector<Packing> results(jobs.size());
+  pool.parallel_for(jobs.size(), [&](std::size_t j) {
+    results[j] = pack(jobs[j].rectangles, jobs[j].options);
+  });
+  return results;
+}
@@ -0,0 +1,120 @@
+//
+//  ShapePack.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 07:26:05.8841
+//
+//  Packing Rectangles and Squares onto sheets.
+//
+//  pack() places rectangles given as RectDims, length along x and
+//  breadth along y as Rectangle::dims() and the outlines of
+//  ShapeBounds.hpp have them, on as many width x height sheets as it
+//  takes, without overlap.  Each gets the sheet it is on and a Placement
+//  as outline() takes it: angle 0, or with rotation allowed pi / 2 for
+//  one turned to stand on its breadth, x then at its right edge, so
+//  bounds() gives the box it fills either way.
+//
+//  Rectangles are packed tallest first unless sort is off, in which
+//  case they go in span order.  A fixed number of sheets stay open:
+//  each rectangle goes on the first open sheet with room, at the best
+//  spot the heuristic finds there; when none has room a new sheet is
+//  opened and, past the limit, the oldest closed.
+//
+//    skyline   the sheet is kept as its upper outline, a list of level
+//              segments; the spot is the one with the lowest top, then
+//              the leftmost.  Fast, and good for parts of like height.
+//    maxrects  the free space is kept as every maximal free rectangle;
+//              the spot is the one leaving the shortest leftover side
+//              (best short side fit).  Denser, but the free list grows
+//              with the number of parts on a sheet.
+//
+//  Sheets are filled one after another, so one pack() runs on one
+//  thread; independent jobs run in parallel on a ThreadPool.
+//
+//  MARK: - References.
+//  @see: Jylänki, "A Thousand Ways to Pack the Bin - A Practical
+//        Approach to Two-Dimensional Rectangle Bin Packing", 2010.
+//
+
+#ifndef ShapePack_hpp
+#define ShapePack_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeBounds.hpp"
+#include "ShapeDims.hpp"
+
+class ThreadPool;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: enum PackHeuristic
+ */
+enum class PackHeuristic {
+  skyline,
+  maxrects,
+};
+
+/*
+ *  MARK: struct PackOptions
+ *  width and height are those of every sheet; open is the number of
+ *  sheets still taking rectangles.
+ */
+struct PackOptions {
+  double        width     = 0;
+  double        height    = 0;
+  PackHeuristic heuristic = PackHeuristic::skyline;
+  bool          rotate    = true;
+  bool          sort      = true;
+  unsigned      open      = 4;
+};
+
+/*
+ *  MARK: struct Packing
+ *  at and sheet hold one entry per rectangle, in span order; a
+ *  rectangle that fits no sheet, or has a negative or NaN side, is
+ *  left on sheet unpacked and counted in rejected.
+ */
+struct Packing {
+  static constexpr std::uint32_t unpacked = std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<Placement> at;
+  std::vector<std::uint32_t> sheet;
+  std::vector<double> used;     //  area covered, per sheet
+  double width = 0;
+  double height = 0;
+  std::size_t rejected = 0;
+
+  std::size_t sheets() const noexcept { return used.size(); }
+  //  area covered over the area of the sheets, 0 with no sheets
+  double utilization() const noexcept;
+  double utilization(std::size_t sheet) const noexcept;
+};
+
+/*
+ *  MARK: struct PackJob
+ */
+struct PackJob {
+  std::span<RectDims const> rectangles;
+  PackOptions options;
+};
+
+//  throws std::invalid_argument for a sheet side that is not positive
+//  and finite or for open == 0, std::length_error for 2^32 rectangles
+//  or more
+Packing pack(std::span<RectDims const> rectangles, PackOptions const & options);
+
+//  the batch's rectangles and then its squares: rows as in ShapeKind
+//  order
+Packing pack(ShapeBatchView const & batch, PackOptions const & options);
+
+//  one Packing per job
+std::vector<Packing> pack(std::span<PackJob const> jobs, ThreadPool & pool);
+
+#endif /* ShapePack_hpp */
@@ -0,0 +1,396 @@
+//
+//  ShapePipeline.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 03:12:44.5081
+//
+
+#include "ShapePipeline.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <system_error>
+
+#include "ShapeBatch.hpp"
+#include "ShapeLoader.hpp"
+#include "ShapeValue.hpp"
+
+namespace shape_pipeline {
+
+//  MARK: - Local Implementation.
+namespace {
+
+using File = std::unique_ptr<std::FILE, int (*)(std::FILE *)>;
+
+/*
+ *  MARK: struct Work
+ *  one block on its way through a lane; each stage fills in its part.
+ */
+struct Work {
+  std::size_t seq = 0;
+  std::size_t offset = 0;
+  std::string text;
+  ShapeBatch batch;
+  std::vector<ShapeKind> kinds;
+  shape_loader::LoadStats load;
+  double area = 0;
+  double perimeter = 0;
+};
+
+using Lane = Channel<Work>;
+
+File open(std::string const & path, char const * mode) {
+  File file(std::fopen(path.c_str(), mode), &std::fclose);
+  if (!file) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  return file;
+}
+
+/*
+ *  MARK: parse()
+ */
+void parse(Work & work, std::string const & path, bool strict) {
+  work.load = shape_loader::parse_records(work.text, work.batch, &work.kinds, strict,
+                                          path, work.offset);
+  work.text = {};
+}
+
+/*
+ *  MARK: compute()
+ *  totals through the column kernels.
+ */
+void compute(Work & work) {
+  auto const view = work.batch.view();
+  std::vector<double> values(view.size());
+  view.areas(values.data());
+  work.area = std::accumulate(values.begin(), values.end(), 0.0);
+  view.perimeters(values.data());
+  work.perimeter = std::accumulate(values.begin(), values.end(), 0.0);
+}
+
+/*
+ *  MARK: format()
+ *  one line per record in text order, each kind's rows taken in turn.
+ */
+void format(Work & work) {
+  auto const view = work.batch.view();
+  std::array<std::size_t, shape_kind_count> next {};
+  for (auto const kind : work.kinds) {
+    auto const row = next[static_cast<std::size_t>(kind)]++;
+    double params[4];
+    for (std::size_t f = 0; f < layout_of(kind).params; ++f) {
+      params[f] = view.column(kind, f)[row];
+    }
+    work.text += layout_of(kind).name;
+    work.text += ": ";
+    work.text += display(make_value(kind, params));
+    work.text += '\n';
+  }
+  work.batch = {};
+  work.kinds = {};
+}
+
+void write(std::FILE * out, std::string const & text, std::string const & path) {
+  if (std::fwrite(text.data(), 1, text.size(), out) != text.size()) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+}
+
+void add(PipelineStats & stats, Work const & work) {
+  stats.records += work.load.records;
+  stats.rejected += work.load.rejected;
+  stats.bytes_out += work.text.size();
+  stats.area += work.area;
+  stats.perimeter += work.perimeter;
+  ++stats.blocks;
+}
+
+void close_all(std::vector<std::unique_ptr<Lane>> & lanes) noexcept {
+  for (auto & lane : lanes) {
+    lane->close();
+  }
+}
+
+/*
+ *  MARK: read_stage()
+ *  blocks of whole lines dealt to the lanes in turn; a block with no
+ *  newline grows until it has one or the file ends.
+ */
+Task read_stage(std::FILE * in, std::string path, std::size_t block,
+                std::vector<std::unique_ptr<Lane>> & lanes, std::size_t & bytes) {
+  try {
+    std::string carry;
+    std::size_t seq = 0;
+    std::size_t offset = 0;
+    bool more = true;
+    while (more) {
+      Work work;
+      work.seq = seq;
+      work.offset = offset;
+      work.text = std::move(carry);
+      carry = {};
+      std::size_t cut = std::string::npos;
+      while (more && cut == std::string::npos) {
+        auto const have = work.text.size();
+        work.text.resize(have + block);
+        auto const got = std::fread(work.text.data() + have, 1, block, in);
+        work.text.resize(have + got);
+        if (got < block) {
+          if (std::ferror(in)) {
+            throw std::system_error(errno, std::generic_category(), path);
+          }
+          more = false;
+        }
+        cut = work.text.rfind('\n');
+      }
+      if (more) {
+        carry.assign(work.text, cut + 1);
+        work.text.resize(cut + 1);
+      }
+      bytes += work.text.size();
+      offset += work.text.size();
+      if (work.text.empty()) {
+        break;
+      }
+      if (!co_await lanes[seq % lanes.size()]->push(std::move(work))) {
+        break;
+      }
+      ++seq;
+    }
+  }
+  catch (...) {
+    close_all(lanes);
+    throw;
+  }
+  close_all(lanes);
+}
+
+/*
+ *  MARK: lane_stage()
+ *  fn on each block from in, passed on to out.  Either end closing
+ *  ends the stage; so does fn throwing, after closing both.
+ */
+template <typename Fn>
+Task lane_stage(Lane & in, Lane & out, Fn fn) {
+  try {
+    while (auto work = co_await in.pop()) {
+      fn(*work);
+      if (!co_await out.push(std::move(*work))) {
+        break;
+      }
+    }
+  }
+  catch (...) {
+    in.close();
+    out.close();
+    throw;
+  }
+  in.close();
+  out.close();
+}
+
+/*
+ *  MARK: write_stage()
+ *  blocks taken from the lanes in the order they were dealt.
+ */
+Task write_stage(std::FILE * out, std::string path,
+                 std::vector<std::unique_ptr<Lane>> & lanes, PipelineStats & stats) {
+  try {
+    for (std::size_t seq = 0; ; ++seq) {
+      auto work = co_await lanes[seq % lanes.size()]->pop();
+      if (!work) {
+        break;
+      }
+      write(out, work->text, path);
+      add(stats, *work);
+    }
+  }
+  catch (...) {
+    close_all(lanes);
+    throw;
+  }
+  close_all(lanes);
+}
+
+} /* namespace */
+
+//  MARK: - Class Scheduler Implementation.
+/*
+ *  MARK: Scheduler::Scheduler()
+ */
+Scheduler::Scheduler(unsigned threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads_.reserve(threads);
+  for (unsigned t = 0; t < threads; ++t) {
+    threads_.emplace_back([this] { work(); });
+  }
+}
+
+/*
+ *  MARK: Scheduler::~Scheduler()
+ *  tasks still suspended are leaked, not resumed.
+ */
+Scheduler::~Scheduler() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  ready_cv_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+/*
+ *  MARK: Scheduler::spawn()
+ */
+void
+Scheduler::spawn(Task task) {
+  auto const handle = std::exchange(task.handle_, nullptr);
+  handle.promise().scheduler = this;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++live_;
+  }
+  schedule(handle);
+}
+
+/*
+ *  MARK: Scheduler::schedule()
+ */
+void
+Scheduler::schedule(std::coroutine_handle<> handle) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ready_.push_back(handle);
+  }
+  ready_cv_.notify_one();
+}
+
+/*
+ *  MARK: Scheduler::wait()
+ */
+void
+Scheduler::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return live_ == 0; });
+  if (auto error = std::exchange(error_, nullptr)) {
+    std::rethrow_exception(error);
+  }
+}
+
+/*
+ *  MARK: Scheduler::finished()
+ */
+void
+Scheduler::finished(std::exception_ptr error) noexcept {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (error && !error_) {
+    error_ = std::move(error);
+  }
+  if (--live_ == 0) {
+    done_cv_.notify_all();
+  }
+}
+
+/*
+ *  MARK: Scheduler::work()
+ */
+void
+Scheduler::work() {
+  for (;;) {
+    std::coroutine_handle<> handle;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_cv_.wait(lock, [this] { return stop_ || !ready_.empty(); });
+      if (ready_.empty()) {
+        return;
+      }
+      handle = ready_.front();
+      ready_.pop_front();
+    }
+    handle.resume();
+  }
+}
+
+//  MARK: - Implementation.
+/*
+ *  MARK: run_pipeline()
+ */
+PipelineStats
+run_pipeline(std::string const & in, std::string const & out, PipelineOptions const & options) {
+  auto const input = open(in, "rb");
+  auto const output = open(out, "wb");
+
+  Scheduler scheduler(options.threads);
+  auto const lanes = options.lanes != 0 ? options.lanes
+                   : options.threads != 0 ? options.threads
+                   : std::max(1u, std::thread::hardware_concurrency());
+  auto const block = std::max<std::size_t>(options.block, 1);
+
+  //  per lane: reader -> parse -> compute -> format -> writer
+  std::vector<std::unique_ptr<Lane>> parse_in, compute_in, format_in, write_in;
+  for (unsigned l = 0; l < lanes; ++l) {
+    parse_in.push_back(std::make_unique<Lane>(scheduler, options.depth));
+    compute_in.push_back(std::make_unique<Lane>(scheduler, options.depth));
+    format_in.push_back(std::make_unique<Lane>(scheduler, options.depth));
+    write_in.push_back(std::make_unique<Lane>(scheduler, options.depth));
+  }
+
+  PipelineStats stats;
+  auto const strict = options.strict;
+  scheduler.spawn(read_stage(input.get(), in, block, parse_in, stats.bytes_in));
+  for (unsigned l = 0; l < lanes; ++l) {
+    scheduler.spawn(lane_stage(*parse_in[l], *compute_in[l],
+                               [in, strict](Work & work) { parse(work, in, strict); }));
+    scheduler.spawn(lane_stage(*compute_in[l], *format_in[l], compute));
+    scheduler.spawn(lane_stage(*format_in[l], *write_in[l], format));
+  }
+  scheduler.spawn(write_stage(output.get(), out, write_in, stats));
+  scheduler.wait();
+
+  if (std::fflush(output.get()) != 0) {
+    throw std::system_error(errno, std::generic_category(), out);
+  }
+  return stats;
+}
+
+/*
+ *  MARK: run_sequential()
+ */
+PipelineStats
+run_sequential(std::string const & in, std::string const & out, PipelineOptions const & options) {
+  auto const input = open(in, "rb");
+  auto const output = open(out, "wb");
+
+  Work work;
+  char buffer[1 << 16];
+  while (auto const got = std::fread(buffer, 1, sizeof(buffer), input.get())) {
+    work.text.append(buffer, got);
+  }
+  if (std::ferror(input.get())) {
+    throw std::system_error(errno, std::generic_category(), in);
+  }
+
+  PipelineStats stats;
+  stats.bytes_in = work.text.size();
+  parse(work, in, options.strict);
+  compute(work);
+  format(work);
+  write(output.get(), work.text, out);
+  add(stats, work);
+
+  if (std::fflush(output.get()) != 0) {
+    throw std::system_error(errno, std::generic_category(), out);
+  }
+  return stats;
+}
+
+} /* namespace shape_pipeline */
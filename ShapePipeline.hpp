@@ -0,0 +1,351 @@
+//
+//  ShapePipeline.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 03:12:44.5081
+//
+//  The shape report job, read -> parse -> compute -> format -> write,
+//  as a pipeline of C++20 coroutines.
+//
+//  Each stage is a Task: a coroutine run by a Scheduler on a few
+//  threads.  Stages pass blocks of work through Channels, bounded
+//  single-producer / single-consumer rings with lock-free push and
+//  pop.  co_await push() on a full channel, or pop() on an empty one,
+//  suspends the stage and frees its thread for another stage; the
+//  other end reschedules it when there is room or data.  A fast
+//  producer therefore runs at most depth blocks ahead of its consumer.
+//
+//  run_pipeline() reads the CSV file (see ShapeLoader.hpp) in blocks of
+//  whole lines and deals them round-robin to lanes, each a parse, a
+//  compute and a format stage.  Compute runs the ShapeBatch area and
+//  perimeter kernels; format renders each record as "Name: display()"
+//  in file order.  The writer takes the blocks back in the same
+//  round-robin order, so the output is the same for every thread and
+//  lane count, and the same as run_sequential(), which runs each stage
+//  over the whole file in turn.
+//
+//  A stage that throws closes its channels.  The stages on either side
+//  then see a closed channel and stop too, and the exception is
+//  rethrown from run_pipeline().
+//
+//  MARK: - References.
+//  @see: https://en.cppreference.com/w/cpp/language/coroutines
+//  @see: Lewis Baker, "C++ Coroutines: Understanding the promise
+//        type", 2018.
+//
+
+#ifndef ShapePipeline_hpp
+#define ShapePipeline_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//  MARK: - Definitions.
+namespace shape_pipeline {
+
+class Scheduler;
+
+/*
+ *  MARK: Class Task
+ *
+ *  A coroutine that starts suspended.  Once spawned on a Scheduler it
+ *  belongs to the scheduler, runs on its threads, and frees its frame
+ *  when it finishes.
+ */
+class Task {
+public:
+  struct promise_type {
+    Scheduler * scheduler = nullptr;
+    std::exception_ptr error;
+
+    Task get_return_object() noexcept {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    auto final_suspend() noexcept;
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+  };
+
+  Task(Task && other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  Task & operator=(Task &&) = delete;
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+protected:
+  //  hide implementation details from the interface
+  friend class Scheduler;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/*
+ *  MARK: Class Scheduler
+ *
+ *  threads == 0 starts one per hardware thread.  Ready coroutines wait
+ *  in a FIFO; a thread resumes one until it suspends or finishes.
+ */
+class Scheduler {
+public:
+  explicit Scheduler(unsigned threads = 0);
+  ~Scheduler();
+
+  Scheduler(Scheduler const &) = delete;
+  Scheduler & operator=(Scheduler const &) = delete;
+
+  void spawn(Task task);
+  void schedule(std::coroutine_handle<> handle);
+
+  //  blocks until every spawned task has finished; rethrows the first
+  //  exception a task let escape
+  void wait();
+
+protected:
+  //  hide implementation details from the interface
+  friend class Task;
+
+  void finished(std::exception_ptr error) noexcept;
+  void work();
+
+  std::mutex mutex_;
+  std::condition_variable ready_cv_;
+  std::condition_variable done_cv_;
+  std::deque<std::coroutine_handle<>> ready_;
+  std::size_t live_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+  std::vector<std::thread> threads_;
+};
+
+/*
+ *  MARK: Task::promise_type::final_suspend()
+ *  the frame is destroyed before the scheduler hears it finished.
+ */
+inline
+auto Task::promise_type::final_suspend() noexcept {
+  struct Done {
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+      auto * const scheduler = handle.promise().scheduler;
+      auto error = std::move(handle.promise().error);
+      handle.destroy();
+      scheduler->finished(std::move(error));
+    }
+    void await_resume() noexcept {}
+  };
+  return Done {};
+}
+
+/*
+ *  MARK: Class Channel
+ *
+ *  Bounded ring of at least capacity slots, rounded up to a power of
+ *  two, between one producing and one consuming coroutine.  Either end
+ *  may close() it: push() then returns false, and pop() returns the
+ *  values still queued and then std::nullopt.
+ *
+ *  A coroutine that must wait arms the waiter slot for its end with its
+ *  handle, checks the ring again, and only then parks.  The other end
+ *  looks at the slot after each push or pop and, if the waiter can go
+ *  on, takes a parked handle out and schedules it, or marks an armed
+ *  one notified so that it checks again instead of parking.  Nothing
+ *  resumes a coroutine that is still arming, so a waiter is resumed
+ *  once, at the point it parked, and never missed.
+ */
+template <typename T>
+class Channel {
+public:
+  Channel(Scheduler & scheduler, std::size_t capacity)
+    : scheduler_(scheduler),
+      slots_(std::bit_ceil(std::max<std::size_t>(capacity, 1))),
+      mask_(slots_.size() - 1) {}
+
+  Channel(Channel const &) = delete;
+  Channel & operator=(Channel const &) = delete;
+
+  struct Push {
+    Channel & channel;
+    T value;
+    bool done = false;
+
+    bool await_ready() {
+      if (channel.closed()) {
+        return true;
+      }
+      if (!channel.full()) {
+        channel.put(std::move(value));
+        done = true;
+      }
+      return done;
+    }
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+      return channel.park(channel.producer_, handle, &Channel::full);
+    }
+    bool await_resume() {
+      if (!done && !channel.closed()) {
+        channel.put(std::move(value));
+        done = true;
+      }
+      return done;
+    }
+  };
+
+  struct Pop {
+    Channel & channel;
+
+    bool await_ready() noexcept { return !channel.empty() || channel.closed(); }
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+      return channel.park(channel.consumer_, handle, &Channel::empty);
+    }
+    std::optional<T> await_resume() {
+      if (channel.empty()) {
+        return std::nullopt;
+      }
+      return channel.take();
+    }
+  };
+
+  //  co_await: false if the channel was closed and value dropped
+  Push push(T value) { return { *this, std::move(value) }; }
+  //  co_await: the next value, or std::nullopt once closed and drained
+  Pop pop() noexcept { return { *this }; }
+
+  void close() noexcept {
+    closed_.store(true);
+    wake(producer_, &Channel::full);
+    wake(consumer_, &Channel::empty);
+  }
+  bool closed() const noexcept { return closed_.load(); }
+
+protected:
+  //  hide implementation details from the interface
+  bool full() const noexcept { return head_.load() - tail_.load() == slots_.size(); }
+  bool empty() const noexcept { return head_.load() == tail_.load(); }
+
+  void put(T && value) {
+    auto const head = head_.load(std::memory_order_relaxed);
+    slots_[head & mask_] = std::move(value);
+    head_.store(head + 1);
+    wake(consumer_, &Channel::empty);
+  }
+
+  T take() {
+    auto const tail = tail_.load(std::memory_order_relaxed);
+    T value = std::move(slots_[tail & mask_]);
+    tail_.store(tail + 1);
+    wake(producer_, &Channel::full);
+    return value;
+  }
+
+  //  slot states: empty, a parked handle's address, that address | armed
+  //  while its coroutine is still checking, or notified
+  static constexpr std::uintptr_t armed = 1;
+  static constexpr std::uintptr_t notified = armed;
+
+  //  a waiter waits for blocked() to be false or the channel closed; the
+  //  other end wakes it only then, so a wake outrun by the waiter's own
+  //  progress does not resume it early
+  void wake(std::atomic<std::uintptr_t> & waiter,
+            bool (Channel::*blocked)() const noexcept) noexcept {
+    auto state = waiter.load();
+    while (state != 0 && state != notified && (!(this->*blocked)() || closed())) {
+      auto const next = (state & armed) != 0 ? notified : 0;
+      if (waiter.compare_exchange_weak(state, next)) {
+        if (next == 0) {
+          scheduler_.schedule(std::coroutine_handle<>::from_address(
+            reinterpret_cast<void *>(state)));
+        }
+        return;
+      }
+    }
+  }
+
+  //  true when parked; false to carry on, the wait being over.  A
+  //  notification may be stale, so it only sends the waiter round to
+  //  check again.
+  bool park(std::atomic<std::uintptr_t> & waiter, std::coroutine_handle<> handle,
+            bool (Channel::*blocked)() const noexcept) noexcept {
+    auto const address = reinterpret_cast<std::uintptr_t>(handle.address());
+    for (;;) {
+      waiter.store(address | armed);
+      if (!(this->*blocked)() || closed()) {
+        waiter.store(0);
+        return false;
+      }
+      auto expected = address | armed;
+      if (waiter.compare_exchange_strong(expected, address)) {
+        return true;
+      }
+    }
+  }
+
+  Scheduler & scheduler_;
+  std::vector<T> slots_;
+  std::size_t mask_;
+  alignas(64) std::atomic<std::size_t> head_ { 0 };
+  alignas(64) std::atomic<std::size_t> tail_ { 0 };
+  std::atomic<std::uintptr_t> producer_ { 0 };
+  std::atomic<std::uintptr_t> consumer_ { 0 };
+  std::atomic<bool> closed_ { false };
+};
+
+/*
+ *  MARK: struct PipelineOptions
+ *  threads == 0 uses every hardware thread, lanes == 0 one lane per
+ *  thread.  Blocks are cut back to the last newline, so a block holds
+ *  whole records.  Unless strict, malformed records are counted and
+ *  skipped instead of throwing.
+ */
+struct PipelineOptions {
+  unsigned    threads = 0;
+  unsigned    lanes   = 0;
+  std::size_t block   = std::size_t(1) << 20;
+  std::size_t depth   = 4;
+  bool        strict  = true;
+};
+
+/*
+ *  MARK: struct PipelineStats
+ *  area and perimeter are totals over the records.
+ */
+struct PipelineStats {
+  std::size_t records   = 0;
+  std::size_t rejected  = 0;
+  std::size_t bytes_in  = 0;
+  std::size_t bytes_out = 0;
+  std::size_t blocks    = 0;
+  double      area      = 0;
+  double      perimeter = 0;
+};
+
+//  every record of the CSV file in, written to out as a line of text;
+//  errors throw as load_shapes() does
+PipelineStats run_pipeline(std::string const & in, std::string const & out,
+                           PipelineOptions const & options = {});
+
+//  the same job, each stage over the whole file before the next
+PipelineStats run_sequential(std::string const & in, std::string const & out,
+                             PipelineOptions const & options = {});
+
+} /* namespace shape_pipeline */
+
+#endif /* ShapePipeline_hpp */
@@ -0,0 +1,265 @@
+//
+//  ShapePolygon.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:48:20.5127
+//
+
+#include "ShapePolygon.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "ShapeFormat.hpp"
+#include "ShapeKernels.hpp"
+#include "ShapeStats.hpp"
+
+using namespace std::literals::string_literals;
+using namespace std::literals::string_view_literals;
+using shape_stats::Class;
+using shape_stats::Method;
+using shape_stats::Stats;
+
+//  MARK: - Class PolygonBuffer Implementation.
+/*
+ *  MARK: PolygonBuffer::add()
+ */
+std::size_t
+PolygonBuffer::add(std::span<Point const> vertices) {
+  if (vertices.size() < 3) {
+    throw std::invalid_argument("PolygonBuffer::add: a polygon needs at least 3 vertices, got "s
+                                + std::to_string(vertices.size()));
+  }
+  offset_.push_back(x_.size());
+  length_.push_back(vertices.size());
+  for (auto const & v : vertices) {
+    x_.push_back(v.x);
+    y_.push_back(v.y);
+  }
+  x_.push_back(vertices.front().x);
+  y_.push_back(vertices.front().y);
+  return offset_.size() - 1;
+}
+
+/*
+ *  MARK: PolygonBuffer::reserve()
+ *  vertices as given to add(), not counting the closing ones.
+ */
+void
+PolygonBuffer::reserve(std::size_t polygons, std::size_t vertices) {
+  x_.reserve(vertices + polygons);
+  y_.reserve(vertices + polygons);
+  offset_.reserve(polygons);
+  length_.reserve(polygons);
+}
+
+/*
+ *  MARK: PolygonBuffer::clear()
+ */
+void
+PolygonBuffer::clear() noexcept {
+  x_.clear();
+  y_.clear();
+  offset_.clear();
+  length_.clear();
+}
+
+/*
+ *  MARK: PolygonBuffer::vertex()
+ */
+Point
+PolygonBuffer::vertex(std::size_t polygon, std::size_t v) const noexcept {
+  auto const i = offset_[polygon] + v;
+  return { x_[i], y_[i] };
+}
+
+/*
+ *  MARK: PolygonBuffer::area()
+ *  shoelace.
+ */
+double
+PolygonBuffer::area(std::size_t polygon) const noexcept {
+  double sum;
+  shape_kernels::cross_sums(x_.data(), y_.data(), &offset_[polygon], &length_[polygon], &sum, 1);
+  return std::abs(sum) / 2.0;
+}
+
+/*
+ *  MARK: PolygonBuffer::perimeter()
+ */
+double
+PolygonBuffer::perimeter(std::size_t polygon) const noexcept {
+  double sum;
+  shape_kernels::edge_sums(x_.data(), y_.data(), &offset_[polygon], &length_[polygon], &sum, 1);
+  return sum;
+}
+
+/*
+ *  MARK: PolygonBuffer::bounds()
+ */
+Box
+PolygonBuffer::bounds(std::size_t polygon) const noexcept {
+  Box box;
+  for (std::size_t i = offset_[polygon]; i < offset_[polygon] + length_[polygon]; ++i) {
+    box.merge(x_[i], y_[i]);
+  }
+  return box;
+}
+
+/*
+ *  MARK: PolygonBuffer::scale()
+ *  about the origin, the closing vertex with the rest.
+ */
+void
+PolygonBuffer::scale(std::size_t polygon, double factor) noexcept {
+  for (std::size_t i = offset_[polygon]; i <= offset_[polygon] + length_[polygon]; ++i) {
+    x_[i] *= factor;
+    y_[i] *= factor;
+  }
+}
+
+/*
+ *  MARK: PolygonBuffer::areas()
+ */
+void
+PolygonBuffer::areas(double * out) const {
+  shape_kernels::cross_sums(x_.data(), y_.data(), offset_.data(), length_.data(), out, size());
+  for (std::size_t p = 0; p < size(); ++p) {
+    out[p] = std::abs(out[p]) / 2.0;
+  }
+}
+
+/*
+ *  MARK: PolygonBuffer::perimeters()
+ */
+void
+PolygonBuffer::perimeters(double * out) const {
+  shape_kernels::edge_sums(x_.data(), y_.data(), offset_.data(), length_.data(), out, size());
+}
+
+/*
+ *  MARK: PolygonBuffer::measure()
+ */
+void
+PolygonBuffer::measure(double * areas, double * perimeters) const {
+  shape_kernels::ring_measures(x_.data(), y_.data(), offset_.data(), length_.data(),
+                               areas, perimeters, size());
+  for (std::size_t p = 0; p < size(); ++p) {
+    areas[p] = std::abs(areas[p]) / 2.0;
+  }
+}
+
+//  MARK: - Class Polygon Implementation.
+/*
+ *  MARK: Polygon::Polygon() - c'tor
+ */
+Polygon::Polygon(std::span<Point const> vertices)
+  : buffer_(std::make_shared<PolygonBuffer>()), index_(0) {
+  Stats::Scope scope(Class::polygon, Method::construct);
+  buffer_->add(vertices);
+}
+
+Polygon::Polygon(std::shared_ptr<PolygonBuffer> buffer, std::size_t index)
+  : buffer_(std::move(buffer)), index_(index) {
+  Stats::Scope scope(Class::polygon, Method::construct);
+  if (!buffer_ || index_ >= buffer_->size()) {
+    throw std::out_of_range("Polygon: no polygon "s + std::to_string(index_) + " in the buffer"s);
+  }
+}
+
+/*
+ *  MARK: Polygon::scale()
+ */
+void
+Polygon::scale(double factor) {
+  buffer_->scale(index_, factor);
+}
+
+/*
+ *  MARK: Polygon::dimensions()
+ */
+std::tuple<double, double, double, double>
+Polygon::dimensions() const {
+  Stats::Scope scope(Class::polygon, Method::dimensions);
+  auto const box = bounds();
+  auto rt = std::make_tuple(box.max_x - box.min_x, box.max_y - box.min_y,
+                            static_cast<double>(vertices()), NAN);
+  return rt;
+}
+
+/*
+ *  MARK: Polygon::display()
+ */
+std::string
+Polygon::display() const {
+  Stats::Scope scope(Class::polygon, Method::display);
+  std::ostringstream disp;
+  disp << "vertices "s << vertices()
+       << ", perimeter "s << perimeter()
+       << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Polygon::format_to()
+ */
+std::size_t
+Polygon::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::polygon, Method::format_to);
+  //  the count in full, as the stream writes it
+  char digits[20];
+  auto const end = std::to_chars(digits, digits + sizeof digits, vertices()).ptr;
+  TextAppender out(buf, n);
+  out << "vertices "sv << std::string_view(digits, end - digits)
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: Polygon::area()
+ */
+double
+Polygon::area() const {
+  Stats::Scope scope(Class::polygon, Method::area);
+  return buffer_->area(index_);
+}
+
+/*
+ *  MARK: Polygon::perimeter()
+ */
+double
+Polygon::perimeter() const {
+  Stats::Scope scope(Class::polygon, Method::perimeter);
+  return buffer_->perimeter(index_);
+}
+
+/*
+ *  MARK: Polygon::vertices()
+ */
+std::size_t
+Polygon::vertices() const noexcept {
+  return buffer_->length(index_);
+}
+
+/*
+ *  MARK: Polygon::vertex()
+ */
+Point
+Polygon::vertex(std::size_t v) const noexcept {
+  return buffer_->vertex(index_, v);
+}
+
+/*
+ *  MARK: Polygon::bounds()
+ */
+Box
+Polygon::bounds() const noexcept {
+  return buffer_->bounds(index_);
+}
@@ -0,0 +1,120 @@
+//
+//  ShapePolygon.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:48:20.5127
+//
+//  Polygons of any number of sides.
+//
+//  A PolygonBuffer keeps the vertices of many polygons in two flat
+//  coordinate columns, x and y, each polygon a run of the columns given
+//  by its offset and length.  Every run is closed by a copy of its first
+//  vertex, so vertex i + 1 can always be read for vertex i and the
+//  kernels load whole vectors of consecutive vertices with no
+//  wrap-around.  The shoelace cross terms and the edge lengths are
+//  summed a vector at a time, the lanes then added in order (see
+//  shape_kernels::ring_sums()).  Cross terms are taken relative to the
+//  polygon's first vertex, so a polygon far from the origin keeps its
+//  area.  measure() works out areas and perimeters of every polygon in
+//  one pass over the columns.
+//
+//  A Polygon is a Shape over one polygon of a buffer.  It goes through
+//  the same kernels, so its results are those of the batch, bit for
+//  bit.
+//
+//  Edge lengths are sqrt(dx * dx + dy * dy) rather than std::hypot, so
+//  that the vector and scalar forms agree; coordinates beyond about
+//  1e154 overflow.  Vertices may go either way round; self-crossing
+//  polygons get the shoelace area, parts of opposite winding cancelling.
+//
+//  MARK: - References.
+//  @see: https://en.wikipedia.org/wiki/Shoelace_formula
+//
+
+#ifndef ShapePolygon_hpp
+#define ShapePolygon_hpp
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ShapeBounds.hpp"
+#include "Shapes.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class PolygonBuffer
+ *
+ *  add() throws std::invalid_argument for fewer than three vertices.
+ *  Not thread-safe while polygons are added or scaled.
+ */
+class PolygonBuffer {
+public:
+  //  the index of the new polygon
+  std::size_t add(std::span<Point const> vertices);
+  void reserve(std::size_t polygons, std::size_t vertices);
+  void clear() noexcept;
+
+  std::size_t size() const noexcept { return offset_.size(); }
+  std::size_t offset(std::size_t polygon) const noexcept { return offset_[polygon]; }
+  std::size_t length(std::size_t polygon) const noexcept { return length_[polygon]; }
+  Point vertex(std::size_t polygon, std::size_t v) const noexcept;
+  //  both columns, closing vertices included
+  double const * x() const noexcept { return x_.data(); }
+  double const * y() const noexcept { return y_.data(); }
+
+  double area(std::size_t polygon) const noexcept;
+  double perimeter(std::size_t polygon) const noexcept;
+  Box bounds(std::size_t polygon) const noexcept;
+  void scale(std::size_t polygon, double factor) noexcept;
+
+  //  out holds size() entries
+  void areas(double * out) const;
+  void perimeters(double * out) const;
+  //  both, in one pass
+  void measure(double * areas, double * perimeters) const;
+
+protected:
+  //  hide implementation details from the interface
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<std::size_t> offset_;
+  std::vector<std::size_t> length_;
+};
+
+/*
+ *  MARK: Class Polygon.
+ *
+ *  Polygons made from the same buffer entry share their vertices;
+ *  scale() on one moves them all.  dimensions() is the width and
+ *  height of the bounding box and the number of vertices.
+ */
+class Polygon final : public virtual Shape {
+public:
+  //  in a buffer of its own
+  Polygon(std::span<Point const> vertices);
+  Polygon(std::shared_ptr<PolygonBuffer> buffer, std::size_t index);
+  virtual ~Polygon() = default;
+  virtual void scale(double factor) override;
+  std::string display() const override;
+  std::size_t format_to(char * buf, std::size_t n) const override;
+  double area() const override;
+  double perimeter() const override;
+  std::tuple<double, double, double, double>
+    dimensions() const override;
+
+  std::size_t vertices() const noexcept;
+  Point vertex(std::size_t v) const noexcept;
+  Box bounds() const noexcept;
+
+protected:
+  //  hide implementation details from the interface
+  std::shared_ptr<PolygonBuffer> buffer_;
+  std::size_t index_;
+};
+
+#endif /* ShapePolygon_hpp */
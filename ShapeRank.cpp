@@ -0,0 +1,389 @@
+//
+//  ShapeRank.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 02:24:50.1736
+//
+
+#include "ShapeRank.hpp"
+#include "Shapes.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr std::size_t digits = 256;
+constexpr std::size_t passes = 8;
+constexpr std::size_t block = 256;
+
+using Counts = std::array<std::size_t, digits>;
+
+/*
+ *  MARK: chunk_count()
+ */
+std::size_t chunk_count(std::size_t n) {
+  return (n + rank_grain - 1) / rank_grain;
+}
+
+/*
+ *  MARK: check_size()
+ */
+void check_size(std::size_t n, char const * fn) {
+  if (n > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::length_error(fn + ": too many shapes for 32-bit positions"s);
+  }
+}
+
+/*
+ *  MARK: digit()
+ */
+std::size_t digit(std::uint64_t key, std::size_t pass) {
+  return static_cast<std::size_t>(key >> (8 * pass)) & (digits - 1);
+}
+
+/*
+ *  MARK: count()
+ */
+void count(RankKey const * keys, std::size_t n, std::size_t pass, Counts & counts) {
+  counts.fill(0);
+  for (std::size_t i = 0; i < n; ++i) {
+    ++counts[digit(keys[i].key, pass)];
+  }
+}
+
+/*
+ *  MARK: metric_of()
+ */
+double metric_of(Shape const & shape, Metric metric) {
+  return metric == Metric::area ? shape.area() : shape.perimeter();
+}
+
+/*
+ *  MARK: positions()
+ */
+std::vector<std::uint32_t> positions(std::span<RankKey const> keys) {
+  std::vector<std::uint32_t> out(keys.size());
+  std::transform(keys.begin(), keys.end(), out.begin(),
+                 [](RankKey const & k) { return k.index; });
+  return out;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: rank_key()
+ *  flipping the sign bit of a positive double, or every bit of a
+ *  negative one, gives an integer in the double's order.
+ */
+std::uint64_t
+rank_key(double value, Order order) noexcept {
+  if (std::isnan(value)) {
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+  if (value == 0) {
+    value = 0;
+  }
+  auto const bits = std::bit_cast<std::uint64_t>(value);
+  auto const key = (bits >> 63) ? ~bits : bits | (std::uint64_t { 1 } << 63);
+  //  neither complement of a number's key reaches the NaN key
+  return order == Order::ascending ? key : ~key;
+}
+
+/*
+ *  MARK: rank_keys() - values
+ */
+std::vector<RankKey>
+rank_keys(std::span<double const> values, Order order, ThreadPool & pool) {
+  check_size(values.size(), "rank_keys");
+  std::vector<RankKey> keys(values.size());
+  pool.parallel_for(chunk_count(values.size()), [&](std::size_t c) {
+    auto const end = std::min(values.size(), (c + 1) * rank_grain);
+    for (auto i = c * rank_grain; i < end; ++i) {
+      keys[i] = { rank_key(values[i], order), static_cast<std::uint32_t>(i) };
+    }
+  });
+  return keys;
+}
+
+/*
+ *  MARK: rank_keys() - ShapeBatchView
+ *  chunks never span kinds, so each block is one kernel call.
+ */
+std::vector<RankKey>
+rank_keys(ShapeBatchView const & batch, Metric metric, Order order, ThreadPool & pool) {
+  check_size(batch.size(), "rank_keys");
+  struct Chunk {
+    ShapeKind kind;
+    std::size_t first;
+    std::size_t count;
+    std::size_t row;
+  };
+  std::vector<Chunk> chunks;
+  std::size_t row = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const n = batch.size(kind);
+    for (std::size_t first = 0; first < n; first += rank_grain) {
+      chunks.push_back({ kind, first, std::min(rank_grain, n - first), row + first });
+    }
+    row += n;
+  }
+
+  std::vector<RankKey> keys(batch.size());
+  pool.parallel_for(chunks.size(), [&](std::size_t c) {
+    auto const & chunk = chunks[c];
+    double values[block];
+    for (std::size_t done = 0; done < chunk.count; done += block) {
+      auto const n = std::min(block, chunk.count - done);
+      auto const rows = batch.slice(chunk.kind, chunk.first + done, n);
+      if (metric == Metric::area) {
+        rows.areas(chunk.kind, values);
+      }
+      else {
+        rows.perimeters(chunk.kind, values);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        auto const at = chunk.row + done + i;
+        keys[at] = { rank_key(values[i], order), static_cast<std::uint32_t>(at) };
+      }
+    }
+  });
+  return keys;
+}
+
+/*
+ *  MARK: rank_keys() - Shape pointers
+ *  one virtual call per shape.
+ */
+std::vector<RankKey>
+rank_keys(std::span<Shape const * const> shapes, Metric metric, Order order, ThreadPool & pool) {
+  check_size(shapes.size(), "rank_keys");
+  std::vector<RankKey> keys(shapes.size());
+  pool.parallel_for(chunk_count(shapes.size()), [&](std::size_t c) {
+    auto const end = std::min(shapes.size(), (c + 1) * rank_grain);
+    for (auto i = c * rank_grain; i < end; ++i) {
+      keys[i] = { rank_key(metric_of(*shapes[i], metric), order), static_cast<std::uint32_t>(i) };
+    }
+  });
+  return keys;
+}
+
+/*
+ *  MARK: radix_sort()
+ *  the first pass counts every byte at once; a byte whose count for
+ *  one digit is all the keys needs no pass, and the first pass that
+ *  runs reuses its counts.  Later passes recount, since the order has
+ *  changed.
+ */
+void
+radix_sort(std::span<RankKey> keys, ThreadPool & pool) {
+  auto const n = keys.size();
+  if (n < 2) {
+    return;
+  }
+  auto const chunks = chunk_count(n);
+  auto const chunk_size = [n](std::size_t c) { return std::min(rank_grain, n - c * rank_grain); };
+
+  std::vector<std::array<Counts, passes>> first(chunks);
+  pool.parallel_for(chunks, [&](std::size_t c) {
+    auto & counts = first[c];
+    for (auto & pass : counts) {
+      pass.fill(0);
+    }
+    auto const * in = keys.data() + c * rank_grain;
+    for (std::size_t i = 0; i < chunk_size(c); ++i) {
+      for (std::size_t p = 0; p < passes; ++p) {
+        ++counts[p][digit(in[i].key, p)];
+      }
+    }
+  });
+  std::vector<std::size_t> needed;
+  for (std::size_t p = 0; p < passes; ++p) {
+    for (std::size_t d = 0; d < digits; ++d) {
+      std::size_t total = 0;
+      for (auto const & counts : first) {
+        total += counts[p][d];
+      }
+      if (total == n) {
+        break;
+      }
+      if (total > 0) {
+        needed.push_back(p);
+        break;
+      }
+    }
+  }
+
+  std::vector<RankKey> buffer(needed.empty() ? 0 : n);
+  auto * from = keys.data();
+  auto * to = buffer.data();
+  std::vector<Counts> offsets(chunks);
+  for (std::size_t step = 0; step < needed.size(); ++step) {
+    auto const pass = needed[step];
+    if (step == 0) {
+      for (std::size_t c = 0; c < chunks; ++c) {
+        offsets[c] = first[c][pass];
+      }
+    }
+    else {
+      pool.parallel_for(chunks, [&](std::size_t c) {
+        count(from + c * rank_grain, chunk_size(c), pass, offsets[c]);
+      });
+    }
+    //  digit-major, then chunk order: where each chunk's run of a digit starts
+    std::size_t at = 0;
+    for (std::size_t d = 0; d < digits; ++d) {
+      for (std::size_t c = 0; c < chunks; ++c) {
+        auto const size = offsets[c][d];
+        offsets[c][d] = at;
+        at += size;
+      }
+    }
+    pool.parallel_for(chunks, [&](std::size_t c) {
+      auto & next = offsets[c];
+      auto const * in = from + c * rank_grain;
+      for (std::size_t i = 0; i < chunk_size(c); ++i) {
+        to[next[digit(in[i].key, pass)]++] = in[i];
+      }
+    });
+    std::swap(from, to);
+  }
+  if (from != keys.data()) {
+    pool.parallel_for(chunks, [&](std::size_t c) {
+      std::copy_n(from + c * rank_grain, chunk_size(c), keys.data() + c * rank_grain);
+    });
+  }
+}
+
+/*
+ *  MARK: top_k()
+ *  a quarter or more of the keys is cheaper sorted whole.
+ */
+std::vector<RankKey>
+top_k(std::span<RankKey const> keys, std::size_t k, ThreadPool & pool) {
+  k = std::min(k, keys.size());
+  if (k == 0) {
+    return {};
+  }
+  if (k >= keys.size() / 4) {
+    std::vector<RankKey> all(keys.begin(), keys.end());
+    radix_sort(all, pool);
+    all.resize(k);
+    return all;
+  }
+
+  //  each chunk's k best, as a max-heap: the worst kept key on top
+  auto const chunks = chunk_count(keys.size());
+  std::vector<std::vector<RankKey>> best(chunks);
+  pool.parallel_for(chunks, [&](std::size_t c) {
+    auto & heap = best[c];
+    auto const chunk = keys.subspan(c * rank_grain, std::min(rank_grain, keys.size() - c * rank_grain));
+    heap.reserve(std::min(k, chunk.size()));
+    for (auto const & key : chunk) {
+      if (heap.size() < k) {
+        heap.push_back(key);
+        std::push_heap(heap.begin(), heap.end());
+      }
+      else if (key < heap.front()) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = key;
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+    std::sort_heap(heap.begin(), heap.end());
+  });
+
+  //  k-way merge: a min-heap of each chunk's next key
+  struct Head {
+    RankKey key;
+    std::size_t chunk;
+    std::size_t next;
+  };
+  auto const later = [](Head const & a, Head const & b) { return b.key < a.key; };
+  std::vector<Head> heads;
+  for (std::size_t c = 0; c < chunks; ++c) {
+    if (!best[c].empty()) {
+      heads.push_back({ best[c][0], c, 1 });
+    }
+  }
+  std::make_heap(heads.begin(), heads.end(), later);
+  std::vector<RankKey> out;
+  out.reserve(k);
+  while (out.size() < k) {
+    std::pop_heap(heads.begin(), heads.end(), later);
+    auto & head = heads.back();
+    out.push_back(head.key);
+    if (head.next < best[head.chunk].size()) {
+      head.key = best[head.chunk][head.next++];
+      std::push_heap(heads.begin(), heads.end(), later);
+    }
+    else {
+      heads.pop_back();
+    }
+  }
+  return out;
+}
+
+/*
+ *  MARK: sort_by()
+ */
+std::vector<std::uint32_t>
+sort_by(ShapeBatchView const & batch, Metric metric, Order order, ThreadPool & pool) {
+  auto keys = rank_keys(batch, metric, order, pool);
+  radix_sort(keys, pool);
+  return positions(keys);
+}
+
+std::vector<std::uint32_t>
+sort_by(std::span<Shape const * const> shapes, Metric metric, Order order, ThreadPool & pool) {
+  auto keys = rank_keys(shapes, metric, order, pool);
+  radix_sort(keys, pool);
+  return positions(keys);
+}
+
+std::vector<std::uint32_t>
+sort_by(ShapeBatchView const & batch, Metric metric, Order order) {
+  return sort_by(batch, metric, order, ThreadPool::shared());
+}
+
+std::vector<std::uint32_t>
+sort_by(std::span<Shape const * const> shapes, Metric metric, Order order) {
+  return sort_by(shapes, metric, order, ThreadPool::shared());
+}
+
+/*
+ *  MARK: top_k() - positions
+ */
+std::vector<std::uint32_t>
+top_k(ShapeBatchView const & batch, Metric metric, std::size_t k, Order order, ThreadPool & pool) {
+  return positions(top_k(rank_keys(batch, metric, order, pool), k, pool));
+}
+
+std::vector<std::uint32_t>
+top_k(std::span<Shape const * const> shapes, Metric metric, std::size_t k, Order order,
+      ThreadPool & pool) {
+  return positions(top_k(rank_keys(shapes, metric, order, pool), k, pool));
+}
+
+std::vector<std::uint32_t>
+top_k(ShapeBatchView const & batch, Metric metric, std::size_t k, Order order) {
+  return top_k(batch, metric, k, order, ThreadPool::shared());
+}
+
+std::vector<std::uint32_t>
+top_k(std::span<Shape const * const> shapes, Metric metric, std::size_t k, Order order) {
+  return top_k(shapes, metric, k, order, ThreadPool::shared());
+}
@@ -0,0 +1,111 @@
+//
+//  ShapeRank.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 02:24:50.1736
+//
+//  Ordering large collections by area() or perimeter(): a full sort
+//  and the k first.
+//
+//  The metric is computed once per shape, by rank_keys(), into packed
+//  RankKeys: the value mapped to an unsigned integer that orders the
+//  same way (descending order is the complement), and the shape's
+//  position in the collection.  NaN values come last in either order,
+//  and -0 ranks with +0.
+//
+//  radix_sort() is an LSD radix sort of the keys, one byte per pass,
+//  skipping bytes every key shares.  Each pass counts digits per chunk
+//  of rank_grain keys, turns the counts into per-chunk offsets, and
+//  scatters the chunks in parallel; chunks scatter in chunk order, so
+//  the sort is stable.  top_k() keeps the k best of each chunk in a
+//  heap and merges the chunk results through a heap of chunk heads.
+//
+//  Both order ties by position, so results are stable permutations of
+//  the collection and the same on every pool size.
+//
+//  MARK: - References.
+//  @see: Knuth, "The Art of Computer Programming", vol. 3, 5.2.5, 1998.
+//  @see: Satish, Harris & Garland, "Designing Efficient Sorting
+//        Algorithms for Manycore GPUs", IPDPS 2009.
+//
+
+#ifndef ShapeRank_hpp
+#define ShapeRank_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+
+class Shape;
+class ThreadPool;
+
+//  MARK: - Definitions.
+enum class Metric {
+  area,
+  perimeter,
+};
+
+enum class Order {
+  ascending,
+  descending,
+};
+
+/*
+ *  MARK: struct RankKey
+ *  key orders as the metric does in the requested order; index is the
+ *  shape's position in the collection.
+ */
+struct RankKey {
+  std::uint64_t key;
+  std::uint32_t index;
+
+  friend constexpr bool operator<(RankKey const & a, RankKey const & b) noexcept {
+    return a.key < b.key || (a.key == b.key && a.index < b.index);
+  }
+};
+
+//  keys per chunk
+constexpr std::size_t rank_grain = 65536;
+
+//  the key of one value
+std::uint64_t rank_key(double value, Order order) noexcept;
+
+//  one key per shape, in collection order; throws std::length_error
+//  for 2^32 shapes or more.  Batch positions are rows in ShapeKind
+//  order.
+std::vector<RankKey> rank_keys(std::span<double const> values, Order order, ThreadPool & pool);
+std::vector<RankKey> rank_keys(ShapeBatchView const & batch, Metric metric, Order order,
+                               ThreadPool & pool);
+std::vector<RankKey> rank_keys(std::span<Shape const * const> shapes, Metric metric,
+                               Order order, ThreadPool & pool);
+
+void radix_sort(std::span<RankKey> keys, ThreadPool & pool);
+
+//  the min(k, size) first keys, sorted
+std::vector<RankKey> top_k(std::span<RankKey const> keys, std::size_t k, ThreadPool & pool);
+
+//  positions of the shapes in order
+std::vector<std::uint32_t> sort_by(ShapeBatchView const & batch, Metric metric, Order order,
+                                   ThreadPool & pool);
+std::vector<std::uint32_t> sort_by(std::span<Shape const * const> shapes, Metric metric,
+                                   Order order, ThreadPool & pool);
+std::vector<std::uint32_t> sort_by(ShapeBatchView const & batch, Metric metric,
+                                   Order order = Order::ascending);
+std::vector<std::uint32_t> sort_by(std::span<Shape const * const> shapes, Metric metric,
+                                   Order order = Order::ascending);
+
+//  positions of the k first shapes in order
+std::vector<std::uint32_t> top_k(ShapeBatchView const & batch, Metric metric, std::size_t k,
+                                 Order order, ThreadPool & pool);
+std::vector<std::uint32_t> top_k(std::span<Shape const * const> shapes, Metric metric,
+                                 std::size_t k, Order order, ThreadPool & pool);
+std::vector<std::uint32_t> top_k(ShapeBatchView const & batch, Metric metric, std::size_t k,
+                                 Order order = Order::descending);
+std::vector<std::uint32_t> top_k(std::span<Shape const * const> shapes, Metric metric,
+                                 std::size_t k, Order order = Order::descending);
+
+#endif /* ShapeRank_hpp */
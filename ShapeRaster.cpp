@@ -0,0 +1,387 @@
+//
+//  ShapeRaster.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 00:41:37.9264
+//
+
+#include "ShapeRaster.hpp"
+#include "ShapeCollide.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr std::size_t tile = CoverageGrid::tile;
+
+/*
+ *  MARK: struct Cells
+ *  inclusive cell range.
+ */
+struct Cells {
+  std::size_t col0;
+  std::size_t col1;
+  std::size_t row0;
+  std::size_t row1;
+};
+
+/*
+ *  MARK: cells()
+ *  the grid cells box touches; false if none.
+ */
+bool cells(CoverageGrid const & grid, Box const & box, Cells & out) {
+  if (box.empty()) {
+    return false;
+  }
+  auto const c0 = std::floor((box.min_x - grid.origin().x) / grid.cell());
+  auto const c1 = std::floor((box.max_x - grid.origin().x) / grid.cell());
+  auto const r0 = std::floor((box.min_y - grid.origin().y) / grid.cell());
+  auto const r1 = std::floor((box.max_y - grid.origin().y) / grid.cell());
+  auto const w = static_cast<double>(grid.width());
+  auto const h = static_cast<double>(grid.height());
+  if (!(c1 >= 0 && c0 < w && r1 >= 0 && r0 < h)) {
+    return false;
+  }
+  out = { static_cast<std::size_t>(std::max(c0, 0.0)), static_cast<std::size_t>(std::min(c1, w - 1)),
+          static_cast<std::size_t>(std::max(r0, 0.0)), static_cast<std::size_t>(std::min(r1, h - 1)) };
+  return true;
+}
+
+/*
+ *  MARK: chord_integral()
+ *  integral of sqrt(r^2 - u^2) du.
+ */
+double chord_integral(double u, double r) {
+  auto const h = std::sqrt(std::max(0.0, r * r - u * u));
+  return (u * h + r * r * std::asin(std::clamp(u / r, -1.0, 1.0))) / 2;
+}
+
+/*
+ *  MARK: corner_area()
+ *  area of the disk of radius r about the origin with X <= x, Y <= y.
+ *  Integrated over X in three runs: where the chord at X lies wholly
+ *  below y, where y cuts it, and again wholly below.
+ */
+double corner_area(double x, double y, double r) {
+  if (x <= -r || y <= -r) {
+    return 0;
+  }
+  auto const to = std::min(x, r);
+  auto const base = chord_integral(-r, r);
+  if (y >= r) {
+    return 2 * (chord_integral(to, r) - base);
+  }
+  auto const w = std::sqrt(r * r - y * y);
+  double area = 0;
+  if (y >= 0) {
+    area += 2 * (chord_integral(std::min(to, -w), r) - base);
+  }
+  if (to > -w) {
+    auto const end = std::min(to, w);
+    area += chord_integral(end, r) - chord_integral(-w, r) + y * (end + w);
+  }
+  if (to > w && y >= 0) {
+    area += 2 * (chord_integral(to, r) - chord_integral(w, r));
+  }
+  return area;
+}
+
+/*
+ *  MARK: circle_area()
+ *  area of a circle inside [x0, x1] x [y0, y1].
+ */
+double circle_area(Outline const & c, double x0, double y0, double x1, double y1) {
+  x0 -= c.centre.x;
+  x1 -= c.centre.x;
+  y0 -= c.centre.y;
+  y1 -= c.centre.y;
+  return corner_area(x1, y1, c.radius) - corner_area(x0, y1, c.radius)
+         - corner_area(x1, y0, c.radius) + corner_area(x0, y0, c.radius);
+}
+
+/*
+ *  MARK: struct Polygon
+ *  a convex polygon being clipped; four sides clipped by four lines
+ *  have at most eight corners.
+ */
+struct Polygon {
+  std::array<Point, 8> corners;
+  std::size_t size = 0;
+
+  explicit Polygon(Outline const & o) : size(o.size) {
+    std::copy(o.corners.begin(), o.corners.begin() + size, corners.begin());
+  }
+
+  //  keeps the part where inside(p) >= 0 (Sutherland-Hodgman)
+  template <typename Inside>
+  void clip(Inside inside) {
+    std::array<Point, 8> kept;
+    std::size_t m = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const & p = corners[i];
+      auto const & q = corners[(i + 1) % size];
+      auto const dp = inside(p);
+      auto const dq = inside(q);
+      if (dp >= 0) {
+        kept[m++] = p;
+      }
+      if ((dp >= 0) != (dq >= 0)) {
+        auto const t = dp / (dp - dq);
+        kept[m++] = { p.x + t * (q.x - p.x), p.y + t * (q.y - p.y) };
+      }
+    }
+    corners = kept;
+    size = m;
+  }
+
+  void clip_band(double y0, double y1) {
+    clip([y0](Point const & p) { return p.y - y0; });
+    clip([y1](Point const & p) { return y1 - p.y; });
+  }
+
+  double area() const {
+    double area = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const & p = corners[i];
+      auto const & q = corners[(i + 1) % size];
+      area += p.x * q.y - q.x * p.y;
+    }
+    return std::abs(area) / 2;
+  }
+};
+
+/*
+ *  MARK: band_extent()
+ *  the x range of the shape between y0 and y1; false if it misses.
+ */
+bool band_extent(Outline const & o, double y0, double y1, double & lo, double & hi) {
+  if (o.size == 0) {
+    auto const dy = std::max({ y0 - o.centre.y, 0.0, o.centre.y - y1 });
+    if (!(dy <= o.radius)) {
+      return false;
+    }
+    auto const w = std::sqrt(o.radius * o.radius - dy * dy);
+    lo = o.centre.x - w;
+    hi = o.centre.x + w;
+    return true;
+  }
+  Polygon band(o);
+  band.clip_band(y0, y1);
+  if (band.size == 0) {
+    return false;
+  }
+  lo = hi = band.corners[0].x;
+  for (std::size_t i = 1; i < band.size; ++i) {
+    lo = std::min(lo, band.corners[i].x);
+    hi = std::max(hi, band.corners[i].x);
+  }
+  return true;
+}
+
+/*
+ *  MARK: draw_centres()
+ */
+void draw_centres(Outline const & o, CoverageGrid & grid, Cells const & c) {
+  auto const n = c.col1 - c.col0 + 1;
+  std::array<double, tile> x;
+  std::array<double, tile> y;
+  std::array<std::uint8_t, tile> in;
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = grid.origin().x + (static_cast<double>(c.col0 + i) + 0.5) * grid.cell();
+  }
+  for (auto row = c.row0; row <= c.row1; ++row) {
+    y.fill(grid.origin().y + (static_cast<double>(row) + 0.5) * grid.cell());
+    contains(o, x.data(), y.data(), in.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      grid.at(c.col0 + i, row) += in[i];
+    }
+  }
+}
+
+/*
+ *  MARK: draw_areas()
+ *  corner flags are kept for the row of corners below and above each
+ *  row of cells; a cell with all four inside is covered whole.  The
+ *  polygon is clipped to each row's band once, and cells beyond the
+ *  band's x range are skipped.
+ */
+void draw_areas(Outline const & o, CoverageGrid & grid, Cells const & c) {
+  auto const n = c.col1 - c.col0 + 1;
+  auto const cell = grid.cell();
+  auto const unit = 1 / (cell * cell);
+  std::array<double, tile + 1> x;
+  std::array<double, tile + 1> y;
+  std::array<std::uint8_t, tile + 1> below;
+  std::array<std::uint8_t, tile + 1> above;
+  for (std::size_t i = 0; i <= n; ++i) {
+    x[i] = grid.origin().x + static_cast<double>(c.col0 + i) * cell;
+  }
+  auto const corner_row = [&](std::size_t row, std::uint8_t * flags) {
+    y.fill(grid.origin().y + static_cast<double>(row) * cell);
+    contains(o, x.data(), y.data(), flags, n + 1);
+  };
+
+  corner_row(c.row0, below.data());
+  for (auto row = c.row0; row <= c.row1; ++row) {
+    corner_row(row + 1, above.data());
+    auto const y0 = grid.origin().y + static_cast<double>(row) * cell;
+    auto const y1 = y0 + cell;
+    double lo = 0;
+    double hi = 0;
+    if (!band_extent(o, y0, y1, lo, hi)) {
+      below = above;
+      continue;
+    }
+    Polygon band(o);
+    if (o.size > 0) {
+      band.clip_band(y0, y1);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      if (x[i + 1] <= lo || x[i] >= hi) {
+        continue;
+      }
+      if (below[i] && below[i + 1] && above[i] && above[i + 1]) {
+        grid.at(c.col0 + i, row) += 1;
+        continue;
+      }
+      double area = 0;
+      if (o.size == 0) {
+        area = circle_area(o, x[i], y0, x[i + 1], y1);
+      }
+      else {
+        auto piece = band;
+        auto const x0 = x[i];
+        auto const x1 = x[i + 1];
+        piece.clip([x0](Point const & p) { return p.x - x0; });
+        piece.clip([x1](Point const & p) { return x1 - p.x; });
+        area = piece.area();
+      }
+      grid.at(c.col0 + i, row) += static_cast<float>(area * unit);
+    }
+    below = above;
+  }
+}
+
+} /* namespace */
+
+//  MARK: - Class CoverageGrid Implementation.
+/*
+ *  MARK: CoverageGrid::CoverageGrid() - c'tor
+ */
+CoverageGrid::CoverageGrid(std::size_t width, std::size_t height, double cell, Point origin)
+  : width_(width), height_(height), cell_(cell), origin_(origin) {
+  if (!(cell > 0) || std::isinf(cell)) {
+    throw std::invalid_argument("CoverageGrid: cell must be positive and finite"s);
+  }
+  if (height > 0 && width > std::numeric_limits<std::size_t>::max() / height) {
+    throw std::length_error("CoverageGrid: grid too large"s);
+  }
+  cover_.assign(width * height, 0.0f);
+}
+
+/*
+ *  MARK: CoverageGrid::covered()
+ */
+std::size_t
+CoverageGrid::covered() const {
+  return static_cast<std::size_t>(
+    std::count_if(cover_.begin(), cover_.end(), [](float v) { return v > 0; }));
+}
+
+/*
+ *  MARK: CoverageGrid::clear()
+ */
+void
+CoverageGrid::clear() {
+  std::fill(cover_.begin(), cover_.end(), 0.0f);
+}
+
+//  MARK: - Implementation.
+/*
+ *  MARK: rasterize()
+ *  shapes are filed per tile in compressed rows (start / list), in
+ *  span order.
+ */
+void
+rasterize(std::span<Outline const> shapes, CoverageGrid & grid, Coverage mode,
+          ThreadPool & pool) {
+  auto const tiles_x = (grid.width() + tile - 1) / tile;
+  auto const tiles_y = (grid.height() + tile - 1) / tile;
+  auto const tiles = tiles_x * tiles_y;
+  if (tiles == 0) {
+    return;
+  }
+
+  std::vector<Cells> covers(shapes.size());
+  std::vector<std::uint8_t> drawn(shapes.size());
+  std::vector<std::size_t> start(tiles + 1, 0);
+  for (std::size_t s = 0; s < shapes.size(); ++s) {
+    drawn[s] = cells(grid, bounds(shapes[s]), covers[s]);
+    if (!drawn[s]) {
+      continue;
+    }
+    auto const & c = covers[s];
+    for (auto ty = c.row0 / tile; ty <= c.row1 / tile; ++ty) {
+      for (auto tx = c.col0 / tile; tx <= c.col1 / tile; ++tx) {
+        ++start[ty * tiles_x + tx + 1];
+      }
+    }
+  }
+  for (std::size_t t = 0; t < tiles; ++t) {
+    start[t + 1] += start[t];
+  }
+  std::vector<std::size_t> list(start.back());
+  auto fill = start;
+  for (std::size_t s = 0; s < shapes.size(); ++s) {
+    if (!drawn[s]) {
+      continue;
+    }
+    auto const & c = covers[s];
+    for (auto ty = c.row0 / tile; ty <= c.row1 / tile; ++ty) {
+      for (auto tx = c.col0 / tile; tx <= c.col1 / tile; ++tx) {
+        list[fill[ty * tiles_x + tx]++] = s;
+      }
+    }
+  }
+
+  pool.parallel_for(tiles, [&](std::size_t t) {
+    if (start[t] == start[t + 1]) {
+      return;
+    }
+    Cells const area { (t % tiles_x) * tile, std::min(grid.width(), (t % tiles_x + 1) * tile) - 1,
+                       (t / tiles_x) * tile, std::min(grid.height(), (t / tiles_x + 1) * tile) - 1 };
+    for (auto i = start[t]; i < start[t + 1]; ++i) {
+      auto const s = list[i];
+      auto const & c = covers[s];
+      Cells const clipped { std::max(c.col0, area.col0), std::min(c.col1, area.col1),
+                            std::max(c.row0, area.row0), std::min(c.row1, area.row1) };
+      if (mode == Coverage::centre) {
+        draw_centres(shapes[s], grid, clipped);
+      }
+      else {
+        draw_areas(shapes[s], grid, clipped);
+      }
+    }
+    for (auto row = area.row0; row <= area.row1; ++row) {
+      for (auto col = area.col0; col <= area.col1; ++col) {
+        grid.at(col, row) = std::min(grid.at(col, row), 1.0f);
+      }
+    }
+  });
+}
+
+void
+rasterize(std::span<Outline const> shapes, CoverageGrid & grid, Coverage mode) {
+  rasterize(shapes, grid, mode, ThreadPool::shared());
+}
@@ -0,0 +1,86 @@
+//
+//  ShapeRaster.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 00:41:37.9264
+//
+//  Coverage grids: which cells of a regular grid placed shapes cover,
+//  and by how much.
+//
+//  The grid is cut into tile x tile cell tiles (16 KiB of coverage
+//  each).  rasterize() first files every shape under the tiles its
+//  bounding box touches, then runs the tiles on a ThreadPool; a tile
+//  task writes only its own cells, so there are no locks and no shared
+//  cache lines between workers.  Within a tile shapes are drawn in
+//  span order, so results do not depend on the pool size.
+//
+//  Coverage::centre marks a cell 1 when the shape contains its centre,
+//  through the containment kernels (ShapeCollide.hpp).  Coverage::area
+//  adds the exact fraction of the cell the shape covers: cells whose
+//  corners are all inside count 1, boundary cells clip the polygon to
+//  the cell, or integrate the circle over it.  Overlapping shapes add,
+//  and a cell is capped at 1.
+//
+
+#ifndef ShapeRaster_hpp
+#define ShapeRaster_hpp
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "ShapeBounds.hpp"
+
+class ThreadPool;
+
+//  MARK: - Definitions.
+/*
+ *  MARK: enum Coverage
+ */
+enum class Coverage {
+  centre,
+  area,
+};
+
+/*
+ *  MARK: Class CoverageGrid
+ *
+ *  width x height square cells of side cell; cell (0, 0) has its
+ *  lower left corner at origin, rows run up in y.
+ */
+class CoverageGrid {
+public:
+  static constexpr std::size_t tile = 64;
+
+  CoverageGrid(std::size_t width, std::size_t height, double cell = 1, Point origin = { 0, 0 });
+
+  std::size_t width() const noexcept { return width_; }
+  std::size_t height() const noexcept { return height_; }
+  double cell() const noexcept { return cell_; }
+  Point origin() const noexcept { return origin_; }
+
+  float at(std::size_t col, std::size_t row) const { return cover_[row * width_ + col]; }
+  float & at(std::size_t col, std::size_t row) { return cover_[row * width_ + col]; }
+  std::span<float const> row(std::size_t r) const { return { cover_.data() + r * width_, width_ }; }
+
+  //  cells with any coverage
+  std::size_t covered() const;
+  void clear();
+
+protected:
+  //  hide implementation details from the interface
+  std::size_t width_;
+  std::size_t height_;
+  double cell_;
+  Point origin_;
+  std::vector<float> cover_;
+};
+
+//  adds shapes to grid
+void rasterize(std::span<Outline const> shapes, CoverageGrid & grid, Coverage mode,
+               ThreadPool & pool);
+void rasterize(std::span<Outline const> shapes, CoverageGrid & grid,
+               Coverage mode = Coverage::centre);
+
+#endif /* ShapeRaster_hpp */
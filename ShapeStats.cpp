@@ -0,0 +1,214 @@
+//
+//  ShapeStats.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 01:37:12.4418
+//
+
+#include "ShapeStats.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr char const * class_names[] = {
+  "Quadrilateral",
+  "Rectangle",
+  "Square",
+  "Parallelogram",
+  "Triangle",
+  "RightTriangle",
+  "IsoscelesTriangle",
+  "EquilateralTriangle",
+  "RightIsoscelesTriangle",
+  "Circle",
+  "Polygon",
+};
+
+constexpr char const * method_names[] = {
+  "construct",
+  "area",
+  "perimeter",
+  "dimensions",
+  "display",
+  "format_to",
+};
+
+static_assert(std::size(class_names) == shape_stats::class_count);
+static_assert(std::size(method_names) == shape_stats::method_count);
+
+/*
+ *  MARK: registry()
+ *  every block ever created; blocks outlive their threads so counts
+ *  from finished threads stay in the snapshot.
+ */
+struct Registry {
+  std::mutex lock;
+  std::vector<std::shared_ptr<shape_stats::Block>> blocks;
+};
+
+Registry & registry() {
+  static Registry instance;
+  return instance;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: shape_stats::local_block()
+ */
+shape_stats::Block &
+shape_stats::local_block() {
+  thread_local std::shared_ptr<Block> const block = [] {
+    auto b = std::make_shared<Block>();
+    std::lock_guard<std::mutex> guard(registry().lock);
+    registry().blocks.push_back(b);
+    return b;
+  }();
+  return *block;
+}
+
+/*
+ *  MARK: shape_stats::Site::percentile()
+ */
+std::uint64_t
+shape_stats::Site::percentile(double p) const noexcept {
+  auto const rank = static_cast<std::uint64_t>(p * static_cast<double>(calls));
+  std::uint64_t seen = 0;
+  for (std::size_t b = 0; b < buckets; ++b) {
+    seen += histogram[b];
+    if (seen > rank) {
+      return bucket_floor(b);
+    }
+  }
+  return max;
+}
+
+/*
+ *  MARK: shape_stats::snapshot()
+ *  counters still being written may be a call behind; each value is
+ *  read whole.
+ */
+shape_stats::Snapshot
+shape_stats::snapshot() {
+#if defined(__x86_64__) || defined(__i386__)
+  Snapshot snap { "tsc", 0, {} };
+#else
+  Snapshot snap { "ns", 0, {} };
+#endif
+  if constexpr (!enabled) {
+    return snap;
+  }
+
+  std::lock_guard<std::mutex> guard(registry().lock);
+  snap.threads = registry().blocks.size();
+  for (std::size_t c = 0; c < class_count; ++c) {
+    for (std::size_t m = 0; m < method_count; ++m) {
+      Site site { static_cast<Class>(c), static_cast<Method>(m), 0, 0, 0, 0, {} };
+      for (auto const & block : registry().blocks) {
+        auto const & counters = block->counters[c][m];
+        site.calls += counters.calls.load(std::memory_order_relaxed);
+        site.allocations += counters.allocations.load(std::memory_order_relaxed);
+        site.ticks += counters.ticks.load(std::memory_order_relaxed);
+        site.max = std::max(site.max, counters.max.load(std::memory_order_relaxed));
+        for (std::size_t b = 0; b < buckets; ++b) {
+          site.histogram[b] += counters.histogram[b].load(std::memory_order_relaxed);
+        }
+      }
+      if (site.calls > 0) {
+        snap.sites.push_back(site);
+      }
+    }
+  }
+  return snap;
+}
+
+/*
+ *  MARK: shape_stats::name()
+ */
+char const *
+shape_stats::name(Class c) noexcept {
+  return class_names[static_cast<std::size_t>(c)];
+}
+
+char const *
+shape_stats::name(Method m) noexcept {
+  return method_names[static_cast<std::size_t>(m)];
+}
+
+/*
+ *  MARK: shape_stats::write_json()
+ *  the histogram lists its non-empty buckets as [floor, count] pairs.
+ */
+void
+shape_stats::write_json(std::ostream & out, Snapshot const & snap) {
+  auto const flags = out.flags();
+  auto const precision = out.precision();
+  out << "{\n  \"enabled\": " << (enabled ? "true" : "false")
+      << ",\n  \"unit\": \"" << snap.unit << '"'
+      << ",\n  \"threads\": " << snap.threads
+      << ",\n  \"sites\": [";
+  for (std::size_t s = 0; s < snap.sites.size(); ++s) {
+    auto const & site = snap.sites[s];
+    out << (s == 0 ? "\n" : ",\n")
+        << "    { \"class\": \"" << name(site.cls) << "\", \"method\": \"" << name(site.method) << '"'
+        << ", \"calls\": " << site.calls
+        << ", \"allocations\": " << site.allocations
+        << ", \"ticks\": " << site.ticks
+        << ", \"mean\": " << std::fixed << std::setprecision(1)
+        << static_cast<double>(site.ticks) / static_cast<double>(site.calls)
+        << ", \"p50\": " << site.percentile(0.50)
+        << ", \"p90\": " << site.percentile(0.90)
+        << ", \"p99\": " << site.percentile(0.99)
+        << ", \"max\": " << site.max
+        << ",\n      \"histogram\": [";
+    bool first = true;
+    for (std::size_t b = 0; b < buckets; ++b) {
+      if (site.histogram[b] > 0) {
+        out << (first ? "" : ", ") << '[' << bucket_floor(b) << ", " << site.histogram[b] << ']';
+        first = false;
+      }
+    }
+    out << "] }";
+  }
+  out << (snap.sites.empty() ? "]\n}\n" : "\n  ]\n}\n");
+  out.flags(flags);
+  out.precision(precision);
+}
+
+#if SHAPE_STATS
+//  MARK: - Replacement operators.
+/*
+ *  MARK: operator new()
+ *  counts into the calling thread's allocations; the thread_local is
+ *  a plain integer, usable from any point in a thread's life.
+ */
+namespace {
+
+void * counted_alloc(std::size_t size) {
+  ++shape_stats::allocations;
+  if (auto * p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+} /* namespace */
+
+void * operator new(std::size_t size) { return counted_alloc(size); }
+void * operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void * p, std::size_t) noexcept { std::free(p); }
+#endif
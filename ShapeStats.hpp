@@ -0,0 +1,247 @@
+//
+//  ShapeStats.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 01:37:12.4418
+//
+//  Compile-time switchable call statistics for the Shape hierarchy.
+//
+//  Build with -DSHAPE_STATS=1 to count.  Otherwise Stats is
+//  Policy<false>, whose Scope is an empty struct with an empty inline
+//  constructor, and the instrumented functions compile to the same code
+//  as without it.
+//
+//  When enabled, a Scope at the top of a constructor, area(),
+//  perimeter(), dimensions(), display() or format_to() counts the call,
+//  adds its duration to a log-linear (HDR-style) histogram and counts
+//  the operator new calls made during it, nested calls included.  A
+//  call is counted against the class whose implementation ran: a
+//  Square's area() is Rectangle::area(), and constructing a Square runs
+//  the Quadrilateral and Rectangle constructors too.  Durations are in
+//  time stamp counter ticks on x86, steady_clock nanoseconds elsewhere.
+//
+//  Every thread writes its own block of counters with plain relaxed
+//  stores; nothing is shared on the recording path.  snapshot() merges
+//  the blocks of all threads, running or finished, on demand, and
+//  write_json() dumps a snapshot.  Counting allocations replaces the
+//  global operator new, so a stats build cannot also link
+//  bench/AllocCounter.cpp.
+//
+
+#ifndef ShapeStats_hpp
+#define ShapeStats_hpp
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef SHAPE_STATS
+#define SHAPE_STATS 0
+#endif
+
+//  MARK: - Definitions.
+namespace shape_stats {
+
+constexpr bool enabled = SHAPE_STATS != 0;
+
+/*
+ *  MARK: enum Class
+ */
+enum class Class : std::uint8_t {
+  quadrilateral,
+  rectangle,
+  square,
+  parallelogram,
+  triangle,
+  right_triangle,
+  isosceles_triangle,
+  equilateral_triangle,
+  right_isosceles_triangle,
+  circle,
+  polygon,
+};
+
+constexpr std::size_t class_count = 11;
+
+/*
+ *  MARK: enum Method
+ */
+enum class Method : std::uint8_t {
+  construct,
+  area,
+  perimeter,
+  dimensions,
+  display,
+  format_to,
+};
+
+constexpr std::size_t method_count = 6;
+
+/*
+ *  MARK: histogram buckets
+ *  values below 2 * sub_buckets have a bucket each; above that every
+ *  power of two is split into sub_buckets, so a bucket is within 1/8
+ *  of its values.  Values of max_bits bits or more share the last.
+ */
+constexpr unsigned sub_bits = 3;
+constexpr std::uint64_t sub_buckets = 1u << sub_bits;
+constexpr unsigned max_bits = 40;
+constexpr std::size_t buckets = (max_bits - sub_bits + 1) * sub_buckets;
+
+constexpr std::size_t bucket_of(std::uint64_t value) noexcept {
+  if (value < 2 * sub_buckets) {
+    return static_cast<std::size_t>(value);
+  }
+  auto const shift = static_cast<unsigned>(std::bit_width(value)) - (sub_bits + 1);
+  auto const b = (shift + 1) * sub_buckets + ((value >> shift) - sub_buckets);
+  return b < buckets ? static_cast<std::size_t>(b) : buckets - 1;
+}
+
+//  smallest value in bucket b
+constexpr std::uint64_t bucket_floor(std::size_t b) noexcept {
+  if (b < 2 * sub_buckets) {
+    return b;
+  }
+  auto const shift = b / sub_buckets - 1;
+  return (sub_buckets + b % sub_buckets) << shift;
+}
+
+static_assert(bucket_of(bucket_floor(buckets - 1)) == buckets - 1);
+static_assert(bucket_of(bucket_floor(100)) == 100 && bucket_of(bucket_floor(101) - 1) == 100);
+
+/*
+ *  MARK: ticks()
+ */
+inline
+std::uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/*
+ *  MARK: struct Counters
+ *  one class and method.  Written only by the owning thread, so a
+ *  relaxed load and store stand in for a locked increment.
+ */
+struct Counters {
+  std::atomic<std::uint64_t> calls { 0 };
+  std::atomic<std::uint64_t> allocations { 0 };
+  std::atomic<std::uint64_t> ticks { 0 };
+  std::atomic<std::uint64_t> max { 0 };
+  std::array<std::atomic<std::uint64_t>, buckets> histogram {};
+
+  static void add(std::atomic<std::uint64_t> & counter, std::uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  void record(std::uint64_t elapsed, std::uint64_t allocated) noexcept {
+    add(calls, 1);
+    add(allocations, allocated);
+    add(ticks, elapsed);
+    add(histogram[bucket_of(elapsed)], 1);
+    if (elapsed > max.load(std::memory_order_relaxed)) {
+      max.store(elapsed, std::memory_order_relaxed);
+    }
+  }
+};
+
+/*
+ *  MARK: struct Block
+ *  a thread's counters.
+ */
+struct Block {
+  std::array<std::array<Counters, method_count>, class_count> counters;
+};
+
+//  the calling thread's block, registered for snapshot() on first use
+Block & local_block();
+
+//  operator new calls made by the calling thread (stats builds only)
+inline thread_local std::uint64_t allocations = 0;
+
+/*
+ *  MARK: Policy
+ */
+template <bool Enabled>
+struct Policy {
+  struct Scope {
+    constexpr Scope(Class, Method) noexcept {}
+  };
+};
+
+template <>
+struct Policy<true> {
+  class Scope {
+  public:
+    Scope(Class c, Method m) noexcept
+      : counters_(local_block().counters[static_cast<std::size_t>(c)][static_cast<std::size_t>(m)]),
+        allocations_(allocations), start_(ticks()) {}
+    ~Scope() {
+      counters_.record(ticks() - start_, allocations - allocations_);
+    }
+    Scope(Scope const &) = delete;
+    Scope & operator=(Scope const &) = delete;
+
+  protected:
+    //  hide implementation details from the interface
+    Counters & counters_;
+    std::uint64_t allocations_;
+    std::uint64_t start_;
+  };
+};
+
+using Stats = Policy<enabled>;
+
+/*
+ *  MARK: struct Site
+ *  merged counters of one class and method.
+ */
+struct Site {
+  Class cls;
+  Method method;
+  std::uint64_t calls;
+  std::uint64_t allocations;
+  std::uint64_t ticks;
+  std::uint64_t max;
+  std::array<std::uint64_t, buckets> histogram;
+
+  //  lower bound of the bucket holding the p-th fraction of calls
+  std::uint64_t percentile(double p) const noexcept;
+};
+
+/*
+ *  MARK: struct Snapshot
+ *  sites with at least one call, in Class then Method order.
+ */
+struct Snapshot {
+  char const * unit;
+  std::size_t threads;
+  std::vector<Site> sites;
+};
+
+//  empty in a build without SHAPE_STATS
+Snapshot snapshot();
+
+char const * name(Class c) noexcept;
+char const * name(Method m) noexcept;
+
+void write_json(std::ostream & out, Snapshot const & snap);
+
+} /* namespace shape_stats */
+
+#endif /* ShapeStats_hpp */
@@ -0,0 +1,144 @@
+//
+//  ShapeStore.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 19:12:44.0218
+//
+
+#include "ShapeStore.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+using namespace std::literals::string_literals;
+
+namespace shape_store {
+
+//  MARK: - Local Implementation.
+namespace {
+
+constexpr char file_magic[4] = { 'S', 'H', 'C', 'L' };
+
+constexpr std::size_t table_size = sizeof(FileHeader) + shape_kind_count * sizeof(KindBlock);
+
+constexpr std::uint64_t align_up(std::uint64_t offset) {
+  return (offset + column_alignment - 1) / column_alignment * column_alignment;
+}
+
+[[noreturn]]
+void bad_file(std::string const & path, char const * what) {
+  throw std::runtime_error(path + ": "s + what);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: write_columns()
+ *  the table first, then the columns in kind and field order.
+ */
+void write_columns(std::string const & path, ShapeBatchView const & batch) {
+  FileHeader header {};
+  std::memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.version = file_version;
+  header.kind_count = shape_kind_count;
+  header.byte_order = byte_order_mark;
+  header.alignment = column_alignment;
+
+  std::array<KindBlock, shape_kind_count> blocks {};
+  std::uint64_t offset = table_size;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto & block = blocks[k];
+    block.count = batch.size(kind);
+    block.fields = layout_of(kind).fields;
+    for (std::size_t f = 0; f < block.fields && block.count != 0; ++f) {
+      offset = align_up(offset);
+      block.offset[f] = offset;
+      offset += block.count * sizeof(double);
+    }
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::fopen(path.c_str(), "wb"),
+                                                        &std::fclose);
+  if (!file) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+
+  auto ok = std::fwrite(&header, sizeof(header), 1, file.get()) == 1
+            && std::fwrite(blocks.data(), sizeof(KindBlock), blocks.size(), file.get())
+               == blocks.size();
+  std::uint64_t at = table_size;
+  char const padding[column_alignment] = {};
+  for (std::size_t k = 0; k < shape_kind_count && ok; ++k) {
+    auto const & block = blocks[k];
+    for (std::size_t f = 0; f < block.fields && block.count != 0 && ok; ++f) {
+      auto const pad = static_cast<std::size_t>(block.offset[f] - at);
+      auto const column = batch.column(static_cast<ShapeKind>(k), f);
+      ok = std::fwrite(padding, 1, pad, file.get()) == pad
+           && std::fwrite(column.data(), sizeof(double), column.size(), file.get())
+              == column.size();
+      at = block.offset[f] + column.size_bytes();
+    }
+  }
+  ok = std::fflush(file.get()) == 0 && ok;
+  if (!ok) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+}
+
+//  MARK: - Class ColumnFile Implementation.
+/*
+ *  MARK: ColumnFile::ColumnFile() - c'tor
+ *  maps the whole file; only the table is read here.
+ */
+ColumnFile::ColumnFile(std::string const & path)
+  : file_(path) {
+  if (file_.size() < table_size) {
+    bad_file(path, "not a shape column file");
+  }
+  auto const base = file_.map(0, file_.size());
+
+  FileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0
+      || header.kind_count != shape_kind_count) {
+    bad_file(path, "not a shape column file");
+  }
+  if (header.version != file_version) {
+    bad_file(path, "unsupported shape column file version");
+  }
+  if (header.byte_order != byte_order_mark) {
+    bad_file(path, "shape column file has foreign byte order");
+  }
+
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    KindBlock block;
+    std::memcpy(&block, base + sizeof(FileHeader) + k * sizeof(KindBlock), sizeof(block));
+    if (block.fields != layout_of(kind).fields
+        || block.count > file_.size() / sizeof(double)) {
+      bad_file(path, "corrupt shape column file");
+    }
+
+    std::array<double const *, 4> fields {};
+    for (std::size_t f = 0; f < block.fields && block.count != 0; ++f) {
+      auto const offset = block.offset[f];
+      if (offset % alignof(double) != 0 || offset < table_size
+          || offset > file_.size() - block.count * sizeof(double)) {
+        bad_file(path, "corrupt shape column file");
+      }
+      //  mmap() returns page-aligned memory, so the column is aligned too
+      fields[f] = reinterpret_cast<double const *>(base + offset);
+    }
+    view_.set(kind, static_cast<std::size_t>(block.count), fields);
+  }
+}
+
+} /* namespace shape_store */
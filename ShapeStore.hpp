@@ -0,0 +1,96 @@
+//
+//  ShapeStore.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 19:12:44.0218
+//
+//  Columnar shape files.
+//
+//  A column file holds a ShapeBatch as it sits in memory: a FileHeader,
+//  one KindBlock per ShapeKind, then every field column of every kind
+//  as raw native doubles, each starting on a column_alignment boundary.
+//  Derived fields (hypotenuse_, the isosceles sides, the equilateral
+//  height_) are stored, so nothing is recomputed on open.
+//
+//  ColumnFile maps the file and points a ShapeBatchView straight at the
+//  mapped columns.  Opening reads and checks the header and the block
+//  table only; the column pages are faulted in when they are first
+//  used, so open time does not depend on the number of shapes.
+//
+
+#ifndef ShapeStore_hpp
+#define ShapeStore_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ShapeBatch.hpp"
+#include "ShapeLoader.hpp"
+
+//  MARK: - Definitions.
+namespace shape_store {
+
+/*
+ *  MARK: struct FileHeader
+ *  byte_order is byte_order_mark as written; a file from a machine of
+ *  the other endianness reads back swapped and is refused.
+ */
+struct FileHeader {
+  char          magic[4];     //  "SHCL"
+  std::uint16_t version;
+  std::uint16_t kind_count;
+  std::uint32_t byte_order;
+  std::uint32_t alignment;    //  of every column
+};
+
+static_assert(sizeof(FileHeader) == 16, "column file layout is part of the file format");
+
+/*
+ *  MARK: struct KindBlock
+ *  offset[f] is the file offset of field f, 0 for an empty column.
+ */
+struct KindBlock {
+  std::uint64_t count;
+  std::uint8_t  fields;
+  std::uint8_t  reserved[7];
+  std::uint64_t offset[4];
+};
+
+static_assert(sizeof(KindBlock) == 48, "column file layout is part of the file format");
+
+constexpr std::uint16_t file_version = 1;
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+constexpr std::size_t column_alignment = 64;
+
+//  column file of every shape in batch
+void write_columns(std::string const & path, ShapeBatchView const & batch);
+
+/*
+ *  MARK: Class ColumnFile
+ *
+ *  Read-only, zero-copy view of a column file.  view() and the spans it
+ *  hands out stay valid for the lifetime of the ColumnFile.  A file
+ *  that is not a valid column file throws std::runtime_error.
+ */
+class ColumnFile {
+public:
+  explicit ColumnFile(std::string const & path);
+
+  ShapeBatchView const & view() const noexcept { return view_; }
+  std::size_t size() const { return view_.size(); }
+  std::size_t size(ShapeKind kind) const { return view_.size(kind); }
+  ShapeBatchView::Column column(ShapeKind kind, std::size_t field) const {
+    return view_.column(kind, field);
+  }
+
+protected:
+  //  hide implementation details from the interface
+  shape_loader::MappedFile file_;
+  ShapeBatchView view_;
+};
+
+} /* namespace shape_store */
+
+#endif /* ShapeStore_hpp */
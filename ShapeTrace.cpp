@@ -0,0 +1,89 @@
+//
+//  ShapeTrace.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 14:21:36.7405
+//
+
+#include "ShapeTrace.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: struct EventFormat
+ *  how the old debug output laid out each event: field width and the
+ *  number of arguments printed before the " - " separator (-1: none).
+ */
+struct EventFormat {
+  char const * name;
+  int width;
+  int split;
+};
+
+constexpr EventFormat formats[] = {
+  { "Quadrilateral::Quadrilateral",                   6,  4 },
+  { "Rectangle::Rectangle",                           6,  2 },
+  { "Square::Square",                                 6,  1 },
+  { "Parallelogram::Parallelogram",                   6, -1 },
+  { "Triangle::Triangle",                             8,  4 },
+  { "RightTriangle::RightTriangle",                   8,  2 },
+  { "EquilateralTriangle::EquilateralTriangle",       8,  1 },
+  { "IsoscelesTriangle::IsoscelesTriangle",           8,  2 },
+  { "RightIsoscelesTriangle::RightIsoscelesTriangle", 8,  1 },
+  { "Rectangle::dimensions",                          0, -1 },
+  { "Square::dimensions",                             0, -1 },
+  { "Parallelogram::dimensions",                      0, -1 },
+  { "Triangle::dimensions",                           0, -1 },
+  { "IsoscelesTriangle::dimensions",                  0, -1 },
+  { "Circle::dimensions",                             0, -1 },
+};
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: shape_trace::decode()
+ */
+bool
+shape_trace::decode(std::istream & in, std::ostream & text, bool annotate) {
+  FileHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header))
+      || std::memcmp(header.magic, "SHTR", 4) != 0
+      || header.version != file_version
+      || header.record_size != sizeof(Record)) {
+    return false;
+  }
+
+  Record record;
+  while (in.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+    if (annotate) {
+      text << '[' << record.thread << ' ' << record.stamp << "] ";
+    }
+    if (record.event >= std::size(formats)) {
+      text << "event " << record.event << '\n';
+      continue;
+    }
+    auto const & format = formats[record.event];
+    text << format.name;
+    for (int i = 0; i < record.argc; ++i) {
+      if (i == format.split) {
+        text << " - ";
+      }
+      text << std::setw(format.width) << record.args[i];
+    }
+    text << '\n';
+  }
+
+  if (header.dropped != 0) {
+    text << header.dropped << " records dropped\n";
+  }
+  return true;
+}
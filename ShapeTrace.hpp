@@ -0,0 +1,232 @@
+//
+//  ShapeTrace.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 14:21:36.7405
+//
+//  Compile-time switchable tracing for the Shape hierarchy.
+//
+//  Build with -DSHAPE_TRACE=1 to record.  Otherwise Tracer is
+//  Policy<false>, whose record() is an empty inline function, and no
+//  trace code is generated at the call sites.
+//
+//  When enabled, every thread appends fixed-size binary records to its
+//  own single-producer ring; nothing is formatted on the recording
+//  path.  dump() drains all rings into a binary stream which decode()
+//  (or tools/TraceDecode.cpp) turns back into the text the constructors
+//  and dimensions() used to print.
+//
+
+#ifndef ShapeTrace_hpp
+#define ShapeTrace_hpp
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#ifndef SHAPE_TRACE
+#define SHAPE_TRACE 0
+#endif
+
+//  MARK: - Definitions.
+namespace shape_trace {
+
+constexpr bool enabled = SHAPE_TRACE != 0;
+
+/*
+ *  MARK: enum Event
+ */
+enum class Event : std::uint16_t {
+  quadrilateral,
+  rectangle,
+  square,
+  parallelogram,
+  triangle,
+  right_triangle,
+  equilateral_triangle,
+  isosceles_triangle,
+  right_isosceles_triangle,
+  rectangle_dimensions,
+  square_dimensions,
+  parallelogram_dimensions,
+  triangle_dimensions,
+  isosceles_triangle_dimensions,
+  circle_dimensions,
+};
+
+/*
+ *  MARK: struct Record
+ *  args are the values the old debug output printed, in print order.
+ */
+struct Record {
+  std::uint64_t stamp;      //  steady_clock nanoseconds
+  std::uint16_t event;
+  std::uint8_t  argc;
+  std::uint8_t  reserved;
+  std::uint32_t thread;     //  ring index, filled in by dump()
+  double        args[8];
+};
+
+static_assert(sizeof(Record) == 80, "trace record layout is part of the file format");
+
+/*
+ *  MARK: struct FileHeader
+ */
+struct FileHeader {
+  char          magic[4];   //  "SHTR"
+  std::uint16_t version;
+  std::uint16_t record_size;
+  std::uint64_t dropped;    //  records lost to full rings
+};
+
+constexpr std::uint16_t file_version = 1;
+
+/*
+ *  MARK: Class Ring
+ *  lock-free single-producer / single-consumer ring.  The owning
+ *  thread pushes; dump() is the only consumer.  A full ring drops the
+ *  new record rather than stall the producer.
+ */
+class Ring {
+public:
+  static constexpr std::size_t capacity = 4096;
+  static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+  bool push(Record const & record) noexcept {
+    auto const head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == capacity) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slots_[head & (capacity - 1)] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename Fn>
+  std::size_t drain(Fn && fn) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    auto const head = head_.load(std::memory_order_acquire);
+    auto const n = static_cast<std::size_t>(head - tail);
+    for (; tail != head; ++tail) {
+      fn(slots_[tail & (capacity - 1)]);
+    }
+    tail_.store(tail, std::memory_order_release);
+    return n;
+  }
+
+  std::uint64_t dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+protected:
+  //  hide implementation details from the interface
+  alignas(64) std::atomic<std::uint64_t> head_ { 0 };
+  alignas(64) std::atomic<std::uint64_t> tail_ { 0 };
+  alignas(64) std::atomic<std::uint64_t> dropped_ { 0 };
+  std::array<Record, capacity> slots_;
+};
+
+/*
+ *  MARK: registry()
+ *  every ring ever created; rings outlive their threads so records
+ *  from finished threads can still be dumped.
+ */
+struct Registry {
+  std::mutex lock;
+  std::vector<std::shared_ptr<Ring>> rings;
+};
+
+inline
+Registry & registry() {
+  static Registry instance;
+  return instance;
+}
+
+/*
+ *  MARK: local_ring()
+ */
+inline
+Ring & local_ring() {
+  thread_local std::shared_ptr<Ring> const ring = [] {
+    auto r = std::make_shared<Ring>();
+    std::lock_guard<std::mutex> guard(registry().lock);
+    registry().rings.push_back(r);
+    return r;
+  }();
+  return *ring;
+}
+
+/*
+ *  MARK: Policy
+ */
+template <bool Enabled>
+struct Policy {
+  template <typename... Args>
+  static void record(Event, Args...) noexcept {}
+};
+
+template <>
+struct Policy<true> {
+  template <typename... Args>
+  static void record(Event event, Args... args) noexcept {
+    static_assert(sizeof...(Args) <= 8, "at most eight trace arguments");
+    Record r {};
+    r.stamp = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    r.event = static_cast<std::uint16_t>(event);
+    r.argc = static_cast<std::uint8_t>(sizeof...(Args));
+    std::uint8_t i = 0;
+    ((r.args[i++] = static_cast<double>(args)), ...);
+    local_ring().push(r);
+  }
+};
+
+using Tracer = Policy<enabled>;
+
+/*
+ *  MARK: dump()
+ *  drain every ring into out as a binary trace file; returns the number
+ *  of records written.
+ */
+inline
+std::size_t dump(std::ostream & out) {
+  std::lock_guard<std::mutex> guard(registry().lock);
+
+  FileHeader header { { 'S', 'H', 'T', 'R' }, file_version,
+                      static_cast<std::uint16_t>(sizeof(Record)), 0 };
+  for (auto const & ring : registry().rings) {
+    header.dropped += ring->dropped();
+  }
+  out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+
+  std::size_t written = 0;
+  for (std::size_t t = 0; t < registry().rings.size(); ++t) {
+    written += registry().rings[t]->drain([&](Record record) {
+      record.thread = static_cast<std::uint32_t>(t);
+      out.write(reinterpret_cast<char const *>(&record), sizeof(record));
+    });
+  }
+  return written;
+}
+
+/*
+ *  MARK: decode()
+ *  offline: binary trace in, one text line per record out.  With
+ *  annotate each line is prefixed by thread and timestamp.  Returns
+ *  false if in is not a trace file.
+ */
+bool decode(std::istream & in, std::ostream & text, bool annotate = false);
+
+} /* namespace shape_trace */
+
+#endif /* ShapeTrace_hpp */
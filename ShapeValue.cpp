@@ -0,0 +1,175 @@
+//
+//  ShapeValue.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 11:02:40.8127
+//
+
+#include "ShapeValue.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Conversion.
+/*
+ *  MARK: to_shape_value()
+ *  most derived classes are tested first: Square is-a Rectangle,
+ *  EquilateralTriangle and RightIsoscelesTriangle are IsoscelesTriangles.
+ */
+ShapeValue
+to_shape_value(Shape const & shape) {
+  if (auto s = dynamic_cast<Square const *>(&shape)) {
+    return SquareValue(s->dims().length);
+  }
+  if (auto s = dynamic_cast<Rectangle const *>(&shape)) {
+    auto const d = s->dims();
+    return RectangleValue(d.length, d.breadth);
+  }
+  if (auto s = dynamic_cast<Parallelogram const *>(&shape)) {
+    auto const d = s->dims();
+    return ParallelogramValue(d.height, d.base, d.side);
+  }
+  if (auto s = dynamic_cast<Circle const *>(&shape)) {
+    return CircleValue(s->dims().radius);
+  }
+  if (auto s = dynamic_cast<RightIsoscelesTriangle const *>(&shape)) {
+    return RightIsoscelesTriangleValue(s->dims().height);
+  }
+  if (auto s = dynamic_cast<EquilateralTriangle const *>(&shape)) {
+    return EquilateralTriangleValue(s->dims().base);
+  }
+  if (auto s = dynamic_cast<IsoscelesTriangle const *>(&shape)) {
+    auto const d = s->dims();
+    return IsoscelesTriangleValue(d.base, d.height);
+  }
+  if (auto s = dynamic_cast<RightTriangle const *>(&shape)) {
+    auto const d = s->dims();
+    return RightTriangleValue(d.base, d.height);
+  }
+  if (auto s = dynamic_cast<Triangle const *>(&shape)) {
+    auto const d = s->dims();
+    return TriangleValue(d.base, d.height, d.sideA, d.sideB);
+  }
+  throw std::invalid_argument("to_shape_value: unknown Shape class"s);
+}
+
+/*
+ *  MARK: make_value()
+ */
+ShapeValue
+make_value(ShapeKind kind, double const * p) {
+  switch (kind) {
+  case ShapeKind::rectangle:                return RectangleValue(p[0], p[1]);
+  case ShapeKind::square:                   return SquareValue(p[0]);
+  case ShapeKind::parallelogram:            return ParallelogramValue(p[0], p[1], p[2]);
+  case ShapeKind::circle:                   return CircleValue(p[0]);
+  case ShapeKind::triangle:                 return TriangleValue(p[0], p[1], p[2], p[3]);
+  case ShapeKind::right_triangle:           return RightTriangleValue(p[0], p[1]);
+  case ShapeKind::isosceles_triangle:       return IsoscelesTriangleValue(p[0], p[1]);
+  case ShapeKind::equilateral_triangle:     return EquilateralTriangleValue(p[0]);
+  case ShapeKind::right_isosceles_triangle: return RightIsoscelesTriangleValue(p[0]);
+  }
+  throw std::invalid_argument("make_value: unknown kind "s
+                              + std::to_string(static_cast<unsigned>(kind)));
+}
+
+//  MARK: - display()
+/*
+ *  MARK: display() - text is identical to the matching member function
+ */
+std::string
+display(RectangleValue const & s) {
+  std::ostringstream disp;
+  disp << "length "s << s.length
+       << ", breadth "s << s.breadth
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(SquareValue const & s) {
+  std::ostringstream disp;
+  disp << "length "s << s.length
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(ParallelogramValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.base
+       << ", side "s << s.side
+       << ", height "s << s.height
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(CircleValue const & s) {
+  std::ostringstream disp;
+  disp << "radius "s << s.radius
+       << ", circumference "s << perimeter(s)
+       << ", area "s << area(s);
+  return disp.str();
+}
+
+std::string
+display(TriangleValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.base
+       << ", height "s << s.height
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(RightTriangleValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.base
+       << ", height "s << s.height
+       << ", hypotenuse "s << s.hypotenuse
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(IsoscelesTriangleValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.base
+       << ", height "s << s.height
+       << ", side length "s << s.side
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(EquilateralTriangleValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.base
+       << ", height "s << s.height
+       << ", perimeter "s << perimeter(s)
+       << ", area "s << std::fixed << area(s);
+  return disp.str();
+}
+
+std::string
+display(RightIsoscelesTriangleValue const & s) {
+  std::ostringstream disp;
+  disp << "base "s << s.height
+       << ", height "s << s.height
+       << ", (sides "s << s.height << ", " << s.hypotenuse << ")"
+       << ", hypotenuse "s << s.hypotenuse
+       << ", (height 2) "s << s.height2
+       << ", perimiter "s << perimeter(s)
+       << ", area "s << area(s);
+  return disp.str();
+}
@@ -0,0 +1,269 @@
+//
+//  ShapeValue.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 11:02:40.8127
+//
+//  MARK: - References.
+//  @see: https://en.cppreference.com/w/cpp/utility/variant/visit
+//
+
+#ifndef ShapeValue_hpp
+#define ShapeValue_hpp
+
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <variant>
+
+#include "ShapeBatch.hpp"
+#include "ShapeMath.hpp"
+#include "Shapes.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  Closed-set value types, one per concrete class of the Shape hierarchy.
+ *  They hold the constructor arguments plus the members the matching
+ *  constructor derives, with no vptr or virtual-base offsets, so the
+ *  free functions below inline.  Results match the member functions of
+ *  the classes bit for bit.
+ *
+ *  Construction, area(), perimeter() and dimensions() are constexpr, so
+ *  fixed shapes can be worked out at compile time (see ShapeCatalog.hpp;
+ *  a compile-time hypotenuse may sit an ulp off, see ShapeMath.hpp).
+ *  The polymorphic classes cannot be: a class with virtual bases has no
+ *  constexpr constructor.
+ */
+
+/*
+ *  MARK: struct RectangleValue
+ */
+struct RectangleValue {
+  constexpr RectangleValue(double length = 0, double breadth = 0)
+    : length(length), breadth(breadth) {}
+
+  double length;
+  double breadth;
+};
+
+/*
+ *  MARK: struct SquareValue
+ */
+struct SquareValue {
+  constexpr SquareValue(double length = 0)
+    : length(length) {}
+
+  double length;
+};
+
+/*
+ *  MARK: struct ParallelogramValue
+ */
+struct ParallelogramValue {
+  constexpr ParallelogramValue(double height = 0, double base = 0, double side = 0)
+    : height(height), base(base), side(side) {}
+
+  double height;
+  double base;
+  double side;
+};
+
+/*
+ *  MARK: struct CircleValue
+ */
+struct CircleValue {
+  constexpr CircleValue(double radius = 0)
+    : radius(radius) {}
+
+  double radius;
+};
+
+/*
+ *  MARK: struct TriangleValue
+ */
+struct TriangleValue {
+  constexpr TriangleValue(double base = 0, double height = 0,
+                double sideA = NAN, double sideB = NAN)
+    : base(base), height(height), sideA(sideA), sideB(sideB) {}
+
+  double base;
+  double height;
+  double sideA;
+  double sideB;
+};
+
+/*
+ *  MARK: struct RightTriangleValue
+ */
+struct RightTriangleValue {
+  constexpr RightTriangleValue(double base = 0, double height = 0)
+    : base(base), height(height), hypotenuse(shape_math::hypot(base, height)) {}
+
+  double base;
+  double height;
+  double hypotenuse;
+};
+
+/*
+ *  MARK: struct IsoscelesTriangleValue
+ */
+struct IsoscelesTriangleValue {
+  constexpr IsoscelesTriangleValue(double base = 0, double height = 0)
+    : base(base), height(height), side(shape_math::hypot(base / 2., height)) {}
+
+  double base;
+  double height;
+  double side;
+};
+
+/*
+ *  MARK: struct EquilateralTriangleValue
+ */
+struct EquilateralTriangleValue {
+  constexpr EquilateralTriangleValue(double base = 0)
+    : base(base), height(shape_math::sqrt(3.0) / 2 * base) {}
+
+  double base;
+  double height;
+};
+
+/*
+ *  MARK: struct RightIsoscelesTriangleValue
+ *  height is both legs, height2 the height over the hypotenuse.
+ */
+struct RightIsoscelesTriangleValue {
+  constexpr RightIsoscelesTriangleValue(double height = 0)
+    : height(height), hypotenuse(shape_math::hypot(height, height)),
+      height2(shape_math::sqrt((height * height) - (hypotenuse * hypotenuse / 4.0))) {}
+
+  double height;
+  double hypotenuse;
+  double height2;
+};
+
+/*
+ *  MARK: ShapeValue
+ *  alternatives are in ShapeKind order.
+ */
+using ShapeValue = std::variant<RectangleValue,
+                                SquareValue,
+                                ParallelogramValue,
+                                CircleValue,
+                                TriangleValue,
+                                RightTriangleValue,
+                                IsoscelesTriangleValue,
+                                EquilateralTriangleValue,
+                                RightIsoscelesTriangleValue>;
+
+using ShapeDimensions = std::tuple<double, double, double, double>;
+
+ShapeValue to_shape_value(Shape const & shape);
+//  from the constructor arguments of kind, in layout_of(kind) order;
+//  params holds layout_of(kind).params of them
+ShapeValue make_value(ShapeKind kind, double const * params);
+
+//  MARK: - area()
+constexpr double area(RectangleValue const & s) { return s.length * s.breadth; }
+constexpr double area(SquareValue const & s) { return s.length * s.length; }
+constexpr double area(ParallelogramValue const & s) { return s.base * s.height; }
+constexpr double area(CircleValue const & s) { return M_PI * (s.radius * s.radius); }
+constexpr double area(TriangleValue const & s) { return (s.base / 2.0) * s.height; }
+constexpr double area(RightTriangleValue const & s) { return (s.base / 2.0) * s.height; }
+constexpr double area(IsoscelesTriangleValue const & s) { return (s.base / 2.0) * s.height; }
+constexpr double area(EquilateralTriangleValue const & s) {
+  return shape_math::sqrt(3.0) / 4 * (s.base * s.base);
+}
+constexpr double area(RightIsoscelesTriangleValue const & s) {
+  return (s.height / 2.0) * s.height;
+}
+
+//  MARK: - perimeter()
+constexpr double perimeter(RectangleValue const & s) {
+  return s.length + s.breadth + s.length + s.breadth;
+}
+constexpr double perimeter(SquareValue const & s) {
+  return s.length + s.length + s.length + s.length;
+}
+constexpr double perimeter(ParallelogramValue const & s) {
+  return s.base + s.side + s.base + s.side;
+}
+constexpr double perimeter(CircleValue const & s) { return M_PI * (s.radius * 2.0); }
+constexpr double perimeter(TriangleValue const & s) {
+  if (shape_math::isnan(s.base) || shape_math::isnan(s.sideA) || shape_math::isnan(s.sideB)) {
+    return NAN;
+  }
+  return s.base + s.sideA + s.sideB;
+}
+constexpr double perimeter(RightTriangleValue const & s) {
+  return s.base + s.height + s.hypotenuse;
+}
+constexpr double perimeter(IsoscelesTriangleValue const & s) {
+  return s.base + s.side + s.side;
+}
+constexpr double perimeter(EquilateralTriangleValue const & s) {
+  return s.base + s.base + s.base;
+}
+constexpr double perimeter(RightIsoscelesTriangleValue const & s) {
+  return s.height + s.height + s.hypotenuse;
+}
+
+//  MARK: - dimensions()
+//  same tuples as the member functions, without the trace output
+constexpr ShapeDimensions dimensions(RectangleValue const & s) {
+  return { s.length, s.breadth, NAN, NAN };
+}
+constexpr ShapeDimensions dimensions(SquareValue const & s) {
+  return { s.length, NAN, NAN, NAN };
+}
+constexpr ShapeDimensions dimensions(ParallelogramValue const & s) {
+  return { s.base, s.height, s.side, NAN };
+}
+constexpr ShapeDimensions dimensions(CircleValue const & s) {
+  return { s.radius, NAN, NAN, NAN };
+}
+constexpr ShapeDimensions dimensions(TriangleValue const & s) {
+  return { s.base, s.height, s.sideA, s.sideB };
+}
+constexpr ShapeDimensions dimensions(RightTriangleValue const & s) {
+  return { s.base, s.height, s.height, s.hypotenuse };
+}
+constexpr ShapeDimensions dimensions(IsoscelesTriangleValue const & s) {
+  return { s.base, s.height, s.side, s.side };
+}
+constexpr ShapeDimensions dimensions(EquilateralTriangleValue const & s) {
+  return { s.base, s.height, s.base, s.base };
+}
+constexpr ShapeDimensions dimensions(RightIsoscelesTriangleValue const & s) {
+  return { s.hypotenuse, s.height2, s.height, s.height };
+}
+
+//  MARK: - display()
+std::string display(RectangleValue const & s);
+std::string display(SquareValue const & s);
+std::string display(ParallelogramValue const & s);
+std::string display(CircleValue const & s);
+std::string display(TriangleValue const & s);
+std::string display(RightTriangleValue const & s);
+std::string display(IsoscelesTriangleValue const & s);
+std::string display(EquilateralTriangleValue const & s);
+std::string display(RightIsoscelesTriangleValue const & s);
+
+//  MARK: - ShapeValue dispatch.
+constexpr double area(ShapeValue const & v) {
+  return std::visit([](auto const & s) { return area(s); }, v);
+}
+
+constexpr double perimeter(ShapeValue const & v) {
+  return std::visit([](auto const & s) { return perimeter(s); }, v);
+}
+
+constexpr ShapeDimensions dimensions(ShapeValue const & v) {
+  return std::visit([](auto const & s) { return dimensions(s); }, v);
+}
+
+inline std::string display(ShapeValue const & v) {
+  return std::visit([](auto const & s) { return display(s); }, v);
+}
+
+#endif /* ShapeValue_hpp */
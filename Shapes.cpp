@@ -0,0 +1,881 @@
+//
+//  Shapes.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 2/2/21.
+//  2021-02-02 03:23:35.0492
+//
+//  MARK: - References.
+//  @see: https://www.cprogramming.com/tutorial/virtual_inheritance.html
+//
+
+#include "Shapes.hpp"
+#include "ShapeTrace.hpp"
+#include "ShapeStats.hpp"
+#include "ShapeFormat.hpp"
+
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <cmath>
+
+using namespace std::literals::string_literals;
+using namespace std::literals::string_view_literals;
+using shape_trace::Event;
+using shape_trace::Tracer;
+using shape_stats::Class;
+using shape_stats::Method;
+using shape_stats::Stats;
+
+//  MARK: - Class Quadrilateral Implementation.
+/*
+ *  MARK: Quadrilateral::Quadrilateral() - default c'tor
+ */
+Quadrilateral::Quadrilateral(double baseA, double sideA, double baseB, double sideB)
+  : baseA_(baseA), sideA_(sideA), baseB_(baseB), sideB_(sideB) {
+  Stats::Scope scope(Class::quadrilateral, Method::construct);
+  Tracer::record(Event::quadrilateral,
+                 sideA, baseA, sideB, baseB,
+                 sideA_, baseA_, sideB_, baseB_);
+}
+
+/*
+ *  MARK: Quadrilateral::perimeter()
+ */
+double Quadrilateral::perimeter() const {
+  Stats::Scope scope(Class::quadrilateral, Method::perimeter);
+  return baseA_ + sideA_ + baseB_ + sideB_;
+}
+
+/*
+ *  MARK: Quadrilateral::scale()
+ */
+void Quadrilateral::scale(double factor) {
+  baseA_ *= factor;
+  sideA_ *= factor;
+  baseB_ *= factor;
+  sideB_ *= factor;
+}
+
+//  MARK: - Class Rectangle Implementation.
+/*
+ *  MARK: Rectangle::Rectangle() - default c'tor
+ */
+Rectangle::Rectangle(double length, double breadth)
+  : Quadrilateral(length, breadth, length, breadth) {
+  Stats::Scope scope(Class::rectangle, Method::construct);
+  Tracer::record(Event::rectangle,
+                 length, breadth,
+                 sideA_, baseA_, sideB_, baseB_);
+}
+
+/*
+ *  MARK: Rectangle::resize()
+ */
+void Rectangle::resize(double length, double breadth) {
+  baseA_ = baseB_ = length;
+  sideA_ = sideB_ = breadth;
+}
+
+/*
+ *  MARK: Rectangle::dimensions()
+ */
+std::tuple<double, double, double, double>
+Rectangle::dimensions() const {
+  Stats::Scope scope(Class::rectangle, Method::dimensions);
+  Tracer::record(Event::rectangle_dimensions);
+  auto const d = dims();
+  auto rt = std::make_tuple(d.length, d.breadth, NAN, NAN);
+  return rt;
+}
+
+/*
+ *  MARK: Rectangle::display()
+ */
+std::string
+Rectangle::display() const {
+  Stats::Scope scope(Class::rectangle, Method::display);
+  std::ostringstream disp;
+  disp << "length "s << baseA_
+        << ", breadth "s << sideA_
+        << ", perimeter "s << perimeter()
+        << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Rectangle::format_to()
+ *  display() text into buf, see TextAppender
+ */
+std::size_t
+Rectangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::rectangle, Method::format_to);
+  TextAppender out(buf, n);
+  out << "length "sv << baseA_
+      << ", breadth "sv << sideA_
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: Rectangle::area()
+ */
+double
+Rectangle::area() const {
+  Stats::Scope scope(Class::rectangle, Method::area);
+  return baseA_ * sideA_;
+}
+
+//  MARK: - Class Square Implementation.
+/*
+ *  MARK: Square::Square() - default c'tor
+ */
+Square::Square(double length)
+  : Rectangle(length, length)
+  , Quadrilateral(length, length, length, length) {
+  Stats::Scope scope(Class::square, Method::construct);
+  Tracer::record(Event::square,
+                 length,
+                 sideA_, baseA_, sideB_, baseB_);
+}
+
+/*
+ *  MARK: Square::resize()
+ */
+void Square::resize(double length) {
+  Rectangle::resize(length, length);
+}
+
+void Square::resize(double length, double breadth) {
+  if (length != breadth && !(std::isnan(length) && std::isnan(breadth))) {
+    throw std::invalid_argument("Square::resize: length and breadth differ"s);
+  }
+  resize(length);
+}
+
+/*
+ *  MARK: Square::dimensions()
+ */
+std::tuple<double, double, double, double>
+Square::dimensions() const {
+  Stats::Scope scope(Class::square, Method::dimensions);
+  Tracer::record(Event::square_dimensions);
+  auto const d = dims();
+  auto rt = std::make_tuple(d.length, NAN, NAN, NAN);
+  return rt;
+}
+
+/*
+ *  MARK: Square::display()
+ */
+std::string
+Square::display() const {
+  Stats::Scope scope(Class::square, Method::display);
+  std::ostringstream disp;
+  disp << "length "s << baseA_
+        << ", perimeter "s << perimeter()
+        << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Square::format_to()
+ */
+std::size_t
+Square::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::square, Method::format_to);
+  TextAppender out(buf, n);
+  out << "length "sv << baseA_
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+//  MARK: - Class Parallelogram Implementation.
+/*
+ *  MARK: Parallelogram::Parallelogram() = default c'tor
+ */
+Parallelogram::Parallelogram(double height, double base, double side)
+  : Quadrilateral(base, side, base, side), height_(height) {
+  Stats::Scope scope(Class::parallelogram, Method::construct);
+  Tracer::record(Event::parallelogram,
+                 sideA_, baseA_, sideB_, baseB_);
+}
+
+/*
+ *  MARK: Parallelogram::resize()
+ */
+void Parallelogram::resize(double height, double base, double side) {
+  baseA_ = baseB_ = base;
+  sideA_ = sideB_ = side;
+  height_ = height;
+}
+
+/*
+ *  MARK: Parallelogram::scale()
+ */
+void Parallelogram::scale(double factor) {
+  Quadrilateral::scale(factor);
+  height_ *= factor;
+}
+
+std::string Parallelogram::display() const {
+  Stats::Scope scope(Class::parallelogram, Method::display);
+  std::ostringstream disp;
+  disp << "base "s << baseA_
+       << ", side "s << sideA_
+       << ", height "s << height_
+       << ", perimeter "s << perimeter()
+       << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Parallelogram::format_to()
+ */
+std::size_t
+Parallelogram::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::parallelogram, Method::format_to);
+  TextAppender out(buf, n);
+  out << "base "sv << baseA_
+      << ", side "sv << sideA_
+      << ", height "sv << height_
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: Parallelogram::area()
+ */
+double Parallelogram::area() const {
+  Stats::Scope scope(Class::parallelogram, Method::area);
+  return baseA_ * height_;
+}
+
+/*
+ *  MARK: Parallelogram::dimensions()
+ */
+std::tuple<double, double, double, double>
+Parallelogram::dimensions() const {
+  Stats::Scope scope(Class::parallelogram, Method::dimensions);
+  Tracer::record(Event::parallelogram_dimensions);
+  auto const d = dims();
+  auto rt = std::make_tuple(d.base, d.height, d.side, NAN);
+  return rt;
+}
+
+
+//  MARK: - Class Triangle Implementation.
+/*
+ *  MARK: Triangle::Triangle() - default c'tor
+ */
+Triangle::Triangle(double base, double height, double sideA, double sideB)
+  : base_(base), height_(height), sideA_(sideA), sideB_(sideB), state_(stale) {
+  Stats::Scope scope(Class::triangle, Method::construct);
+  Tracer::record(Event::triangle,
+                 height, base, sideA, sideB,
+                 height_, base_, sideA_, sideB_);
+}
+
+/*
+ *  MARK: Triangle::Triangle() - copy c'tor
+ *  other is derived first, so its members are settled when copied.
+ */
+Triangle::Triangle(Triangle const & other)
+  : Shape(other) {
+  other.derive();
+  base_ = other.base_;
+  height_ = other.height_;
+  sideA_ = other.sideA_;
+  sideB_ = other.sideB_;
+  state_.store(derived, std::memory_order_relaxed);
+}
+
+/*
+ *  MARK: Triangle::operator=()
+ */
+Triangle &
+Triangle::operator=(Triangle const & other) {
+  other.derive();
+  base_ = other.base_;
+  height_ = other.height_;
+  sideA_ = other.sideA_;
+  sideB_ = other.sideB_;
+  state_.store(derived, std::memory_order_relaxed);
+  return *this;
+}
+
+/*
+ *  MARK: Triangle::derive_once()
+ *  the first caller derives, concurrent callers wait for it.
+ */
+void
+Triangle::derive_once() const noexcept {
+  auto expected = static_cast<std::uint8_t>(stale);
+  if (state_.compare_exchange_strong(expected, deriving, std::memory_order_acquire)) {
+    derive_members();
+    state_.store(derived, std::memory_order_release);
+    return;
+  }
+  while (state_.load(std::memory_order_acquire) != derived) {
+    std::this_thread::yield();
+  }
+}
+
+/*
+ *  MARK: Triangle::resize()
+ */
+void
+Triangle::resize(double base, double height, double sideA, double sideB) {
+  base_ = base;
+  height_ = height;
+  sideA_ = sideA;
+  sideB_ = sideB;
+  invalidate();
+}
+
+/*
+ *  MARK: Triangle::scale()
+ *  derived members are recomputed from the scaled arguments.
+ */
+void
+Triangle::scale(double factor) {
+  base_ *= factor;
+  height_ *= factor;
+  sideA_ *= factor;
+  sideB_ *= factor;
+  invalidate();
+}
+
+/*
+ *  MARK: Triangle::dimensions()
+ */
+std::tuple<double, double, double, double>
+Triangle::dimensions() const {
+  Stats::Scope scope(Class::triangle, Method::dimensions);
+  Tracer::record(Event::triangle_dimensions);
+  auto const d = dims();
+  auto rt = std::make_tuple(d.base, d.height, d.sideA, d.sideB);
+  return rt;
+}
+
+/*
+ *  MARK: Triangle::display()
+ */
+std::string
+Triangle::display() const {
+  Stats::Scope scope(Class::triangle, Method::display);
+  derive();
+  std::ostringstream disp;
+  disp << "base "s << base_
+        << ", height "s << height_
+        << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Triangle::format_to()
+ */
+std::size_t
+Triangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::triangle, Method::format_to);
+  derive();
+  TextAppender out(buf, n);
+  out << "base "sv << base_
+      << ", height "sv << height_
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: Triangle::perimeter()
+ */
+double
+Triangle::perimeter() const {
+  Stats::Scope scope(Class::triangle, Method::perimeter);
+  //  TODO: calculate perimeter
+  derive();
+  double perim;
+  if (std::isnan(base_) || std::isnan(sideA_) || std::isnan(sideB_)) {
+    perim = NAN;
+  }
+  else {
+    perim = base_ + sideA_ + sideB_;
+  }
+  return perim;
+}
+
+/*
+ *  MARK: Triangle::area()
+ */
+double
+Triangle::area() const {
+  Stats::Scope scope(Class::triangle, Method::area);
+  return (base_ / 2.0) * height_;
+}
+
+//  MARK: - Class RightTriangle Implementation.
+/*
+ *  MARK: RightTriangle::RightTriangle() - default c'tor
+ */
+RightTriangle::RightTriangle(double base, double height)
+: Triangle(base, height, height) {
+  Stats::Scope scope(Class::right_triangle, Method::construct);
+//  base_  = base;
+//  sideA_ = height_ = height;
+  if constexpr (shape_trace::enabled) {
+    invalidate();
+    derive();
+    Tracer::record(Event::right_triangle,
+                   height, base,
+                   height_, base_, sideA_, sideB_, hypotenuse_);
+  }
+}
+
+/*
+ *  MARK: RightTriangle::derive_members()
+ */
+void
+RightTriangle::derive_members() const noexcept {
+  adopt_members(std::hypot(base_, height_));
+}
+
+/*
+ *  MARK: RightTriangle::adopt_members()
+ */
+void
+RightTriangle::adopt_members(double value) const noexcept {
+  sideB_ = hypotenuse_ = value;
+}
+
+/*
+ *  MARK: RightTriangle::resize()
+ */
+void
+RightTriangle::resize(double base, double height) {
+  Triangle::resize(base, height, height);
+}
+
+void
+RightTriangle::resize(double base, double height, double sideA, double sideB) {
+  if (!std::isnan(sideA) || !std::isnan(sideB)) {
+    throw std::invalid_argument("RightTriangle::resize: sides follow from base and height"s);
+  }
+  resize(base, height);
+}
+
+/*
+ *  MARK: RightTriangle::display()
+ */
+std::string
+RightTriangle::display() const {
+  Stats::Scope scope(Class::right_triangle, Method::display);
+  derive();
+  std::ostringstream disp;
+  disp << "base "s << base_
+       << ", height "s << height_
+       << ", hypotenuse "s << hypotenuse_
+       << ", perimeter "s << perimeter()
+       << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: RightTriangle::format_to()
+ */
+std::size_t
+RightTriangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::right_triangle, Method::format_to);
+  derive();
+  TextAppender out(buf, n);
+  out << "base "sv << base_
+      << ", height "sv << height_
+      << ", hypotenuse "sv << hypotenuse_
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+//  MARK: - Class EquilateralTriangle Implementation.
+/*
+ *  MARK: EquilateralTriangle::EquilateralTriangle() - default c'tor
+ */
+EquilateralTriangle::EquilateralTriangle(double base)
+  : Triangle(base, NAN, base, base),
+    IsoscelesTriangle(base, NAN) {
+  Stats::Scope scope(Class::equilateral_triangle, Method::construct);
+  sideA_ = sideB_ = base_;
+  if constexpr (shape_trace::enabled) {
+    invalidate();
+    derive();
+    Tracer::record(Event::equilateral_triangle,
+                   base,
+                   height_, base_, sideA_, sideB_);
+  }
+}
+
+/*
+ *  MARK: EquilateralTriangle::derive_members()
+ */
+void
+EquilateralTriangle::derive_members() const noexcept {
+  adopt_members(std::sqrt(3.0) / 2 * base_);
+  //  TODO: there's more than one way to do it (tmtowtdi]
+  //height_ = std::sqrt( (base * base) - ((base / 2) * (base / 2)) );
+  //height_ = std::sqrt( (base * base) - (base * base / 4) );
+}
+
+/*
+ *  MARK: EquilateralTriangle::adopt_members()
+ */
+void
+EquilateralTriangle::adopt_members(double value) const noexcept {
+  height_ = value;
+}
+
+/*
+ *  MARK: EquilateralTriangle::resize()
+ */
+void
+EquilateralTriangle::resize(double base) {
+  Triangle::resize(base, NAN, base, base);
+}
+
+void
+EquilateralTriangle::resize(double, double) {
+  throw std::invalid_argument("EquilateralTriangle::resize: height follows from base"s);
+}
+
+/*
+ *  MARK: EquilateralTriangle::display()
+ */
+std::string
+EquilateralTriangle::display() const {
+  Stats::Scope scope(Class::equilateral_triangle, Method::display);
+  derive();
+  std::ostringstream disp;
+  disp << "base "s << base_
+        << ", height "s << height_
+        << ", perimeter "s << perimeter()
+        << ", area "s << std::fixed << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: EquilateralTriangle::format_to()
+ */
+std::size_t
+EquilateralTriangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::equilateral_triangle, Method::format_to);
+  derive();
+  TextAppender out(buf, n);
+  out << "base "sv << base_
+      << ", height "sv << height_
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: EquilateralTriangle::area()
+ */
+double
+EquilateralTriangle::area() const {
+  Stats::Scope scope(Class::equilateral_triangle, Method::area);
+  return std::sqrt(3.0) / 4 * (base_ * base_);
+}
+
+//  MARK: - Class IsoscelesTriangle Implementation.
+/*
+ *  MARK: IsoscelesTriangle::IsoscelesTriangle() - default c'tor
+ */
+IsoscelesTriangle::IsoscelesTriangle(double base, double height)
+  : Triangle(base, height, NAN, NAN) {
+  Stats::Scope scope(Class::isosceles_triangle, Method::construct);
+  ibase_ = iheight_ = iside_ = NAN;
+  if constexpr (shape_trace::enabled) {
+    invalidate();
+    derive();
+    Tracer::record(Event::isosceles_triangle,
+                   height, base,
+                   height_, base_, sideA_, sideB_);
+  }
+}
+
+/*
+ *  MARK: IsoscelesTriangle::derive_members()
+ */
+void
+IsoscelesTriangle::derive_members() const noexcept {
+  adopt_members(std::hypot(base_ / 2., height_));
+  //  std::sqrt((base_ * base_ / 4) + (height_ * height_));
+}
+
+/*
+ *  MARK: IsoscelesTriangle::adopt_members()
+ */
+void
+IsoscelesTriangle::adopt_members(double value) const noexcept {
+  sideA_ = sideB_ = value;
+}
+
+/*
+ *  MARK: IsoscelesTriangle::resize()
+ */
+void
+IsoscelesTriangle::resize(double base, double height) {
+  Triangle::resize(base, height);
+}
+
+void
+IsoscelesTriangle::resize(double base, double height, double sideA, double sideB) {
+  if (!std::isnan(sideA) || !std::isnan(sideB)) {
+    throw std::invalid_argument("IsoscelesTriangle::resize: sides follow from base and height"s);
+  }
+  resize(base, height);
+}
+
+/*
+ *  MARK: IsoscelesTriangle::display()
+ */
+std::string
+IsoscelesTriangle::display() const {
+  Stats::Scope scope(Class::isosceles_triangle, Method::display);
+  derive();
+  std::ostringstream disp;
+  if (std::isnan(ibase_) && std::isnan(iheight_) && std::isnan(iside_)) {
+    disp << "base "s << base_
+         << ", height "s << height_
+         << ", side length "s << sideA_
+         << ", perimeter "s << perimeter()
+         << ", area "s << std::fixed << area();
+  }
+  else {
+    disp << "base "s << ibase_
+         << ", height "s << iheight_
+         << ", side length "s << iside_
+         << ", perimeter "s << perimeter()
+         << ", area "s << std::fixed << area();
+  }
+  return disp.str();
+
+}
+
+/*
+ *  MARK: IsoscelesTriangle::format_to()
+ */
+std::size_t
+IsoscelesTriangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::isosceles_triangle, Method::format_to);
+  TextAppender out(buf, n);
+  auto const d = dims();
+  out << "base "sv << d.base
+      << ", height "sv << d.height
+      << ", side length "sv << d.side
+      << ", perimeter "sv << perimeter()
+      << ", area "sv << fixed(area());
+  return out.size();
+}
+
+/*
+ *  MARK: IsoscelesTriangle::dimensions()
+ */
+std::tuple<double, double, double, double>
+IsoscelesTriangle::dimensions() const {
+  Stats::Scope scope(Class::isosceles_triangle, Method::dimensions);
+  Tracer::record(Event::isosceles_triangle_dimensions);
+  //  both sides are equal, whichever set of members dims() reports
+  auto const d = dims();
+  auto rt = std::make_tuple(d.base, d.height, d.side, d.side);
+  return rt;
+}
+
+//  MARK: - Class RightIsoscelesTriangle Implementation.
+/*
+ *  MARK: RightIsoscelesTriangle::RightIsoscelesTriangle() - default c'tor
+ */
+RightIsoscelesTriangle::RightIsoscelesTriangle(double height)
+: Triangle(height, height, height, NAN),
+  RightTriangle(height, height),
+  IsoscelesTriangle(NAN, NAN)
+{
+  Stats::Scope scope(Class::right_isosceles_triangle, Method::construct);
+  if constexpr (shape_trace::enabled) {
+    invalidate();
+    derive();
+    Tracer::record(Event::right_isosceles_triangle,
+                   height,
+                   height_, base_, sideA_, sideB_, iheight_, ibase_, iside_);
+  }
+}
+
+/*
+ *  MARK: RightIsoscelesTriangle::derive_members()
+ */
+void
+RightIsoscelesTriangle::derive_members() const noexcept {
+  adopt_members(std::hypot(base_, height_));
+}
+
+/*
+ *  MARK: RightIsoscelesTriangle::adopt_members()
+ */
+void
+RightIsoscelesTriangle::adopt_members(double value) const noexcept {
+  ibase_ = hypotenuse_ = sideB_ = value;
+  iside_ = sideA_ = height_;
+  iheight_ = std::sqrt((height_ * height_) - (sideB_ * sideB_ / 4.0));
+}
+
+/*
+ *  MARK: RightIsoscelesTriangle::resize()
+ */
+void
+RightIsoscelesTriangle::resize(double height) {
+  Triangle::resize(height, height, height);
+}
+
+void
+RightIsoscelesTriangle::resize(double base, double height) {
+  if (base != height && !(std::isnan(base) && std::isnan(height))) {
+    throw std::invalid_argument("RightIsoscelesTriangle::resize: base and height differ"s);
+  }
+  resize(height);
+}
+
+void
+RightIsoscelesTriangle::resize(double base, double height, double sideA, double sideB) {
+  if (!std::isnan(sideA) || !std::isnan(sideB)) {
+    throw std::invalid_argument("RightIsoscelesTriangle::resize: sides follow from height"s);
+  }
+  resize(base, height);
+}
+
+/*
+ *  MARK: display()
+ */
+std::string RightIsoscelesTriangle::display() const {
+  Stats::Scope scope(Class::right_isosceles_triangle, Method::display);
+  derive();
+  std::ostringstream disp;
+  disp << "base "s << base_
+       << ", height "s << height_
+       << ", (sides "s << sideA_ << ", " << sideB_ << ")"
+       << ", hypotenuse "s << hypotenuse_
+       << ", (height 2) "s << iheight_
+       << ", perimiter "s << perimeter()
+       << ", area "s << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: RightIsoscelesTriangle::format_to()
+ */
+std::size_t
+RightIsoscelesTriangle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::right_isosceles_triangle, Method::format_to);
+  derive();
+  TextAppender out(buf, n);
+  out << "base "sv << base_
+      << ", height "sv << height_
+      << ", (sides "sv << sideA_ << ", "sv << sideB_ << ")"sv
+      << ", hypotenuse "sv << hypotenuse_
+      << ", (height 2) "sv << iheight_
+      << ", perimiter "sv << perimeter()
+      << ", area "sv << area();
+  return out.size();
+}
+
+//  MARK: - Class Circle Implementation.
+/*
+ *  MARK: Circle::Circle() - default c'tor
+ */
+Circle::Circle(double radius)
+  : radius_(radius) {
+  Stats::Scope scope(Class::circle, Method::construct);
+}
+
+/*
+ *  MARK: Circle::resize()
+ */
+void
+Circle::resize(double radius) {
+  radius_ = radius;
+}
+
+/*
+ *  MARK: Circle::scale()
+ */
+void
+Circle::scale(double factor) {
+  radius_ *= factor;
+}
+
+/*
+ *  MARK: Circle::dimensions()
+ */
+std::tuple<double, double, double, double>
+Circle::dimensions() const {
+  Stats::Scope scope(Class::circle, Method::dimensions);
+  Tracer::record(Event::circle_dimensions);
+  auto const d = dims();
+  auto rt = std::make_tuple(d.radius, NAN, NAN, NAN);
+  return rt;
+}
+
+/*
+ *  MARK: Circle::display()
+ */
+std::string
+Circle::display() const {
+  Stats::Scope scope(Class::circle, Method::display);
+  std::ostringstream disp;
+  disp << "radius "s << radius_
+        << ", circumference "s << circumference()
+        << ", area "s << area();
+  return disp.str();
+}
+
+/*
+ *  MARK: Circle::format_to()
+ */
+std::size_t
+Circle::format_to(char * buf, std::size_t n) const {
+  Stats::Scope scope(Class::circle, Method::format_to);
+  TextAppender out(buf, n);
+  out << "radius "sv << radius_
+      << ", circumference "sv << circumference()
+      << ", area "sv << area();
+  return out.size();
+}
+
+/*
+ *  MARK: Circle::area()
+ */
+double
+Circle::area() const {
+  Stats::Scope scope(Class::circle, Method::area);
+  return M_PI * (radius_ * radius_);
+}
+
+/*
+ *  MARK: Circle::perimeter()
+ */
+double
+Circle::perimeter() const {
+  Stats::Scope scope(Class::circle, Method::perimeter);
+  return circumference();
+}
+
+/*
+ *  MARK: Circle::circumference()
+ */
+double
+Circle::circumference() const {
+  return M_PI * (radius_ * 2.0);
+}
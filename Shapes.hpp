@@ -0,0 +1,373 @@
+//
+//  Shapes.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 2/2/21.
+//  2021-02-02 03:23:35.0492
+//
+//  MARK: - References.
+//  @see: https://www.cprogramming.com/tutorial/virtual_inheritance.html
+//
+
+#ifndef Shapes_hpp
+#define Shapes_hpp
+
+#include <string>
+#include <tuple>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ShapeDims.hpp"
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class Shape
+ */
+class Shape {
+public:
+  virtual ~Shape() = default;
+  virtual std::string display() const = 0;
+  virtual std::size_t format_to(char * buf, std::size_t n) const = 0;
+  virtual double area() const = 0;
+  virtual double perimeter() const = 0;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const = 0;
+  //  multiply every length by factor, as if constructed scaled
+  virtual void scale(double factor) = 0;
+};
+
+/*
+ *  MARK: Class Quadrilateral.
+ */
+class Quadrilateral : public virtual Shape {
+public:
+  Quadrilateral(double baseA = NAN, double sideA = NAN,
+                double baseB = NAN, double sideB = NAN);
+  virtual ~Quadrilateral() = default;
+  virtual double perimeter() const override;
+  virtual void scale(double factor) override;
+
+protected:
+  //  hide implementation details from the interface
+  double baseA_;
+  double baseB_;
+  double sideA_;
+  double sideB_;
+};
+
+/*
+ *  MARK: Class Rectangle
+ */
+class Rectangle : public virtual Quadrilateral {
+public:
+  Rectangle(double length = 0, double breadth = 0);
+  virtual ~Rectangle() = default;
+  virtual void resize(double length, double breadth);
+  using dims_type = RectDims;
+  dims_type dims() const noexcept;
+  virtual std::string display() const override;
+  virtual std::size_t format_to(char * buf, std::size_t n) const override;
+  virtual double area() const override final;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const override;
+
+protected:
+  //  hide implementation details from the interface
+};
+
+/*
+ *  MARK: Class Square
+ */
+class Square final : public virtual Rectangle {
+public:
+  Square(double length = 0);
+  virtual ~Square() = default;
+  void resize(double length);
+  //  throws std::invalid_argument unless length == breadth
+  virtual void resize(double length, double breadth) override;
+  using dims_type = SquareDims;
+  dims_type dims() const noexcept;
+  virtual std::string display() const override final;
+  virtual std::size_t format_to(char * buf, std::size_t n) const override final;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const override;
+};
+
+class Parallelogram final : public virtual Quadrilateral {
+public:
+  Parallelogram(double height = 0, double base = 0, double side = 0);
+  virtual ~Parallelogram() = default;
+  void resize(double height, double base, double side);
+  virtual void scale(double factor) override;
+  using dims_type = ParallelogramDims;
+  dims_type dims() const noexcept;
+  std::string display() const override final;
+  std::size_t format_to(char * buf, std::size_t n) const override final;
+  virtual double area() const override final;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const override;
+
+protected:
+  //  hide implementation details from the interface
+  double height_;
+};
+
+/*
+ *  MARK: Class Triangle
+ *
+ *  Members a subclass derives from its constructor arguments (the
+ *  hypotenuse, the isosceles sides, the equilateral height, ...) are
+ *  computed by derive_members() on first use, not in the constructor,
+ *  and recomputed after resize() or scale().  Every const member
+ *  function that reads them calls derive() first.  Concurrent first
+ *  use is safe: one thread derives, the others wait for it.
+ *
+ *  resize() takes the arguments of the class's constructor.  A
+ *  subclass overrides the resize() it inherits and throws
+ *  std::invalid_argument when the arguments do not describe one of
+ *  its shapes.
+ */
+class Triangle : public virtual Shape {
+public:
+  Triangle(double base = 0, double height = 0, double sideA = NAN, double sideB = NAN);
+  Triangle(Triangle const & other);
+  Triangle & operator=(Triangle const & other);
+  virtual ~Triangle() = default;
+  virtual void resize(double base, double height, double sideA = NAN, double sideB = NAN);
+  virtual void scale(double factor) override;
+  using dims_type = TriangleDims;
+  dims_type dims() const noexcept;
+  virtual std::string display() const override;
+  virtual std::size_t format_to(char * buf, std::size_t n) const override;
+  virtual double perimeter() const override;
+  virtual double area() const override;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const override;
+
+protected:
+  //  hide implementation details from the interface
+  //  ShapeFactory adopts derived members it has already computed
+  friend class ShapeFactory;
+
+  enum : std::uint8_t { stale, deriving, derived };
+
+  void derive() const noexcept {
+    if (state_.load(std::memory_order_acquire) != derived) {
+      derive_once();
+    }
+  }
+  void invalidate() noexcept { state_.store(stale, std::memory_order_relaxed); }
+  //  derived members from value, as derive_members() would set them,
+  //  and marked derived; value is the one a subclass derives first
+  void adopt_derived(double value) noexcept {
+    adopt_members(value);
+    state_.store(derived, std::memory_order_relaxed);
+  }
+  //  fill in the derived members from the constructor arguments
+  virtual void derive_members() const noexcept {}
+  //  fill in the derived members from the first of them
+  virtual void adopt_members(double) const noexcept {}
+
+  double base_;
+  mutable double height_;
+  mutable double sideA_;
+  mutable double sideB_;
+  mutable std::atomic<std::uint8_t> state_;
+
+private:
+  void derive_once() const noexcept;
+};
+
+/*
+ *  MARK: Class RightTriangle
+ */
+class RightTriangle : public virtual Triangle {
+public:
+  RightTriangle(double base = 0, double height = 0);
+  virtual ~RightTriangle() = default;
+  virtual void resize(double base, double height);
+  virtual void resize(double base, double height, double sideA, double sideB) override;
+  using dims_type = RightTriangleDims;
+  dims_type dims() const noexcept;
+  std::string display() const override;
+  std::size_t format_to(char * buf, std::size_t n) const override;
+
+protected:
+  //  hide implementation details from the interface
+  virtual void derive_members() const noexcept override;
+  //  the hypotenuse
+  virtual void adopt_members(double value) const noexcept override;
+
+  mutable double hypotenuse_;
+};
+
+/*
+ *  MARK: Class IsoscelesTriangle
+ */
+class IsoscelesTriangle : public virtual Triangle {
+public:
+  IsoscelesTriangle(double base = 0, double height = 0);
+  virtual ~IsoscelesTriangle() = default;
+  virtual void resize(double base, double height);
+  virtual void resize(double base, double height, double sideA, double sideB) override;
+  using dims_type = IsoscelesDims;
+  dims_type dims() const noexcept;
+  std::string display() const override;
+  std::size_t format_to(char * buf, std::size_t n) const override;
+  virtual std::tuple<double, double, double, double>
+    dimensions() const override;
+
+protected:
+  virtual void derive_members() const noexcept override;
+  //  the equal sides
+  virtual void adopt_members(double value) const noexcept override;
+
+  mutable double ibase_;
+  mutable double iheight_;
+  mutable double iside_;
+};
+
+/*
+ *  MARK: Class EquilateralTriangle
+ */
+class EquilateralTriangle final : public virtual IsoscelesTriangle {
+public:
+  EquilateralTriangle(double base = 0);
+  virtual ~EquilateralTriangle() = default;
+  void resize(double base);
+  virtual void resize(double base, double height) override;
+  using dims_type = EquilateralDims;
+  dims_type dims() const noexcept;
+  virtual std::string display() const override;
+  virtual std::size_t format_to(char * buf, std::size_t n) const override;
+  virtual double area() const override;
+
+protected:
+  //  hide implementation details from the interface
+  virtual void derive_members() const noexcept override;
+  //  the height
+  virtual void adopt_members(double value) const noexcept override;
+};
+
+/*
+ *  MARK: Class RightIsoscelesTriangle
+ */
+class RightIsoscelesTriangle final
+  : public virtual IsoscelesTriangle, public virtual RightTriangle {
+public:
+  RightIsoscelesTriangle(double height = 0);
+  virtual ~RightIsoscelesTriangle() = default;
+  void resize(double height);
+  virtual void resize(double base, double height) override;
+  virtual void resize(double base, double height, double sideA, double sideB) override;
+  using dims_type = RightIsoscelesDims;
+  dims_type dims() const noexcept;
+  std::string display() const override;
+  std::size_t format_to(char * buf, std::size_t n) const override;
+
+protected:
+    //  hide implementation details from the interface
+    virtual void derive_members() const noexcept override;
+    //  the hypotenuse
+    virtual void adopt_members(double value) const noexcept override;
+
+    double height2_;
+};
+
+/*
+ *  MARK: Class Circle
+ */
+class Circle final : public virtual Shape {
+public:
+  Circle(double radius = 0);
+  virtual ~Circle() = default;
+  void resize(double radius);
+  virtual void scale(double factor) override;
+  using dims_type = CircleDims;
+  dims_type dims() const noexcept;
+  std::string display() const override;
+  std::size_t format_to(char * buf, std::size_t n) const override;
+  double area() const override;
+  double perimeter() const override;
+  double circumference() const;
+  std::tuple<double, double, double, double>
+    dimensions() const override;
+
+protected:
+  //  hide implementation details from the interface
+  double radius_;
+};
+
+//  MARK: - Inline Implementation.
+/*
+ *  MARK: dims() - typed, allocation-free and free of I/O
+ */
+inline RectDims Rectangle::dims() const noexcept {
+  return { baseA_, sideA_ };
+}
+
+inline SquareDims Square::dims() const noexcept {
+  return { baseA_ };
+}
+
+inline ParallelogramDims Parallelogram::dims() const noexcept {
+  return { baseA_, height_, sideA_ };
+}
+
+inline TriangleDims Triangle::dims() const noexcept {
+  derive();
+  return { base_, height_, sideA_, sideB_ };
+}
+
+inline RightTriangleDims RightTriangle::dims() const noexcept {
+  derive();
+  return { base_, height_, hypotenuse_ };
+}
+
+inline IsoscelesDims IsoscelesTriangle::dims() const noexcept {
+  derive();
+  if (std::isnan(ibase_) && std::isnan(iheight_) && std::isnan(iside_)) {
+    return { base_, height_, sideA_ };
+  }
+  return { ibase_, iheight_, iside_ };
+}
+
+inline EquilateralDims EquilateralTriangle::dims() const noexcept {
+  derive();
+  return { base_, height_ };
+}
+
+inline RightIsoscelesDims RightIsoscelesTriangle::dims() const noexcept {
+  derive();
+  return { height_, hypotenuse_, iheight_ };
+}
+
+inline CircleDims Circle::dims() const noexcept {
+  return { radius_ };
+}
+
+/*
+ *  MARK: extract_dims()
+ *  batch form of dims() into a caller-provided array of n entries, from
+ *  a contiguous array of objects or from an array of pointers.
+ */
+template <typename T>
+inline
+void extract_dims(T const * shapes, std::size_t n, typename T::dims_type * out) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = shapes[i].dims();
+  }
+}
+
+template <typename T>
+inline
+void extract_dims(T const * const * shapes, std::size_t n,
+                  typename T::dims_type * out) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = shapes[i]->dims();
+  }
+}
+
+#endif /* Shapes_hpp */
@@ -0,0 +1,181 @@
+//
+//  ThreadPool.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 20:31:09.6410
+//
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+//  MARK: - Class ThreadPool Implementation.
+/*
+ *  MARK: ThreadPool::ThreadPool() - c'tor
+ */
+ThreadPool::ThreadPool(unsigned threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  slices_ = std::make_unique<Slice[]>(threads);
+  workers_.reserve(threads);
+  for (std::size_t w = 0; w < threads; ++w) {
+    workers_.emplace_back(&ThreadPool::work, this, w);
+  }
+}
+
+/*
+ *  MARK: ThreadPool::~ThreadPool() - d'tor
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto & worker : workers_) {
+    worker.join();
+  }
+}
+
+/*
+ *  MARK: ThreadPool::shared()
+ */
+ThreadPool &
+ThreadPool::shared() {
+  static ThreadPool pool;
+  return pool;
+}
+
+/*
+ *  MARK: ThreadPool::run()
+ *  deal [0, tasks) out in equal slices, wake the workers and wait.
+ */
+void
+ThreadPool::run(std::size_t tasks, Task task, void * ctx) {
+  if (tasks == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> submit(submit_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto const generation = ++generation_;
+
+  auto const n = workers_.size();
+  for (std::size_t w = 0; w < n; ++w) {
+    std::lock_guard<std::mutex> guard(slices_[w].mutex);
+    slices_[w].generation = generation;
+    slices_[w].next = tasks * w / n;
+    slices_[w].end = tasks * (w + 1) / n;
+  }
+
+  task_ = task;
+  ctx_ = ctx;
+  error_ = nullptr;
+  pending_.store(tasks, std::memory_order_relaxed);
+  start_.notify_all();
+
+  done_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+  task_ = nullptr;
+  ctx_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+/*
+ *  MARK: ThreadPool::work()
+ *  worker loop: sleep until a new loop starts, then drain it.
+ */
+void
+ThreadPool::work(std::size_t self) {
+  std::uint64_t seen = 0;
+  for (;;) {
+    Task task;
+    void * ctx;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      task = task_;
+      ctx = ctx_;
+    }
+    drain(self, seen, task, ctx);
+  }
+}
+
+/*
+ *  MARK: ThreadPool::drain()
+ */
+void
+ThreadPool::drain(std::size_t self, std::uint64_t generation, Task task, void * ctx) {
+  std::size_t i;
+  while (take(self, generation, i)
+         || (steal(self, generation) && take(self, generation, i))) {
+    try {
+      task(ctx, i);
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_all();
+    }
+  }
+}
+
+/*
+ *  MARK: ThreadPool::take()
+ *  front of the own slice.
+ */
+bool
+ThreadPool::take(std::size_t self, std::uint64_t generation, std::size_t & i) {
+  auto & slice = slices_[self];
+  std::lock_guard<std::mutex> lock(slice.mutex);
+  if (slice.generation != generation || slice.next == slice.end) {
+    return false;
+  }
+  i = slice.next++;
+  return true;
+}
+
+/*
+ *  MARK: ThreadPool::steal()
+ *  back half of the first non-empty slice after self.
+ */
+bool
+ThreadPool::steal(std::size_t self, std::uint64_t generation) {
+  auto const n = workers_.size();
+  for (std::size_t k = 1; k < n; ++k) {
+    auto & victim = slices_[(self + k) % n];
+    std::size_t first;
+    std::size_t last;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.generation != generation || victim.next == victim.end) {
+        continue;
+      }
+      first = victim.next + (victim.end - victim.next) / 2;
+      last = victim.end;
+      victim.end = first;
+    }
+    auto & slice = slices_[self];
+    std::lock_guard<std::mutex> lock(slice.mutex);
+    if (slice.generation != generation) {
+      //  a new loop was dealt meanwhile, so this one is finished
+      return false;
+    }
+    slice.next = first;
+    slice.end = last;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,106 @@
+//
+//  ThreadPool.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 20:31:09.6410
+//
+//  Work-stealing pool for data-parallel loops.
+//
+//  parallel_for(tasks, fn) runs fn(i) for every i in [0, tasks).  The
+//  index range is dealt out in equal contiguous slices, one per worker.
+//  A worker takes indices from the front of its own slice; when that is
+//  empty it steals the back half of another worker's slice.  Uneven
+//  tasks therefore balance out without a shared queue, and a loop
+//  allocates nothing.
+//
+//  Which worker runs a task is not deterministic.  Callers that need
+//  reproducible results write per-task results and combine them in
+//  task order (see ShapeAggregate.hpp).
+//
+//  MARK: - References.
+//  @see: Blumofe & Leiserson, "Scheduling Multithreaded Computations
+//        by Work Stealing", JACM 46(5), 1999.
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//  MARK: - Definitions.
+/*
+ *  MARK: Class ThreadPool
+ *
+ *  threads == 0 starts one worker per hardware thread.  One loop runs
+ *  at a time; parallel_for() blocks until every task has finished and
+ *  rethrows the first exception a task threw.  Tasks must not call
+ *  parallel_for() on the same pool.
+ */
+class ThreadPool {
+public:
+  explicit ThreadPool(unsigned threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool & operator=(ThreadPool const &) = delete;
+
+  unsigned size() const noexcept { return static_cast<unsigned>(workers_.size()); }
+
+  template <typename Fn>
+  void parallel_for(std::size_t tasks, Fn && fn) {
+    using F = std::remove_reference_t<Fn>;
+    run(tasks, [](void * ctx, std::size_t i) { (*static_cast<F *>(ctx))(i); },
+        const_cast<void *>(static_cast<void const *>(&fn)));
+  }
+
+  //  process-wide pool, one worker per hardware thread
+  static ThreadPool & shared();
+
+protected:
+  //  hide implementation details from the interface
+  using Task = void (*)(void * ctx, std::size_t i);
+
+  /*
+   *  MARK: struct ThreadPool::Slice
+   *  [next, end) of loop generation still to run; owner and thieves
+   *  lock it.  A worker only runs indices of the loop it woke up for.
+   */
+  struct alignas(64) Slice {
+    std::mutex mutex;
+    std::uint64_t generation = 0;
+    std::size_t next = 0;
+    std::size_t end = 0;
+  };
+
+  void run(std::size_t tasks, Task task, void * ctx);
+  void work(std::size_t self);
+  bool take(std::size_t self, std::uint64_t generation, std::size_t & i);
+  bool steal(std::size_t self, std::uint64_t generation);
+  void drain(std::size_t self, std::uint64_t generation, Task task, void * ctx);
+
+  std::vector<std::thread> workers_;
+  std::unique_ptr<Slice[]> slices_;
+
+  std::mutex submit_;                 //  one loop at a time
+  std::mutex mutex_;                  //  guards the fields below
+  std::condition_variable start_;
+  std::condition_variable done_;
+  std::uint64_t generation_ = 0;
+  bool stop_ = false;
+  Task task_ = nullptr;
+  void * ctx_ = nullptr;
+  std::exception_ptr error_;
+  std::atomic<std::size_t> pending_ { 0 };
+};
+
+#endif /* ThreadPool_hpp */
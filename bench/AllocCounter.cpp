@@ -0,0 +1,49 @@
+//
+//  AllocCounter.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 13:05:51.2298
+//
+//  Replacement global operator new/delete counting every allocation.
+//  Link into benchmark executables that report allocations/op.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "BenchUtil.hpp"
+
+namespace {
+
+std::atomic<std::size_t> alloc_count { 0 };
+std::atomic<std::size_t> alloc_bytes { 0 };
+
+void * counted_alloc(std::size_t size) {
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (auto * p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+} /* namespace */
+
+/*
+ *  MARK: bench::alloc_stats()
+ */
+bench::AllocStats
+bench::alloc_stats() {
+  return { alloc_count.load(std::memory_order_relaxed),
+           alloc_bytes.load(std::memory_order_relaxed) };
+}
+
+//  MARK: - Replacement operators.
+void * operator new(std::size_t size) { return counted_alloc(size); }
+void * operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void * p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,171 @@
+//
+//  BenchAggregate.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 20:31:09.6410
+//
+//  Scaling curve of aggregate(): the same collection on pools of 1, 2,
+//  4, ... threads up to the hardware thread count (or -t), for the
+//  columnar ShapeBatch and for a vector of Shape pointers.  Reports
+//  time, throughput, speedup and parallel efficiency, and checks that
+//  every pool size gives bit-identical results.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchAggregate.cpp ShapeAggregate.cpp ThreadPool.cpp ShapeBatch.cpp Shapes.cpp ShapeFormat.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes]
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ShapeAggregate.hpp"
+#include "ShapeBatch.hpp"
+#include "Shapes.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: same()
+ *  bitwise, so NaN == NaN and -0 != +0.
+ */
+bool same(Summary const & a, Summary const & b) {
+  return a.count == b.count && a.nan == b.nan
+         && std::memcmp(&a.total, &b.total, sizeof(double)) == 0
+         && std::memcmp(&a.min, &b.min, sizeof(double)) == 0
+         && std::memcmp(&a.max, &b.max, sizeof(double)) == 0;
+}
+
+bool same(Aggregate const & a, Aggregate const & b) {
+  return a.count == b.count && same(a.area, b.area) && same(a.perimeter, b.perimeter);
+}
+
+bool same(BatchAggregate const & a, BatchAggregate const & b) {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    if (!same(a.kinds[k], b.kinds[k])) {
+      return false;
+    }
+  }
+  return same(a.all, b.all);
+}
+
+/*
+ *  MARK: curve()
+ *  run(pool) on every pool size; returns false on a result mismatch.
+ */
+template <typename Run>
+bool curve(std::string const & name, std::size_t n, unsigned max_threads, Run run) {
+  std::cout << name << ", " << n << " shapes\n"
+            << std::setw(8) << "threads" << std::setw(12) << "ms"
+            << std::setw(14) << "Mshapes/s" << std::setw(10) << "speedup"
+            << std::setw(12) << "efficiency" << '\n';
+
+  decltype(run(std::declval<ThreadPool &>())) reference {};
+  double base = 0;
+  bool ok = true;
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+
+  for (auto const t : sizes) {
+    ThreadPool pool(t);
+    decltype(reference) result {};
+    auto const ns = bench::best_ns([&] { result = run(pool); }, 5);
+    if (t == 1) {
+      reference = result;
+      base = ns;
+    }
+    auto const match = same(result, reference);
+    ok = ok && match;
+    std::cout << std::fixed << std::setw(8) << t
+              << std::setw(12) << std::setprecision(2) << ns / 1e6
+              << std::setw(14) << std::setprecision(1) << n / ns * 1e3
+              << std::setw(10) << std::setprecision(2) << base / ns
+              << std::setw(11) << std::setprecision(0) << 100 * base / ns / t << '%'
+              << (match ? "" : "  MISMATCH") << '\n';
+  }
+  std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+  return ok;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 16'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dim(0.5, 100.0);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+
+  ShapeBatch batch;
+  std::vector<std::unique_ptr<Shape>> owned;
+  std::vector<Shape const *> shapes;
+  auto const objects = n / 4;
+  owned.reserve(objects);
+  shapes.reserve(objects);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const a = dim(rng);
+    auto const b = dim(rng);
+    auto const c = dim(rng);
+    double const params[] = { a, b, c, a + b };
+    auto const kind = static_cast<ShapeKind>(pick(rng));
+    batch.append(kind, params, layout_of(kind).params);
+    if (i < objects) {
+      switch (kind) {
+      case ShapeKind::rectangle:                owned.push_back(std::make_unique<Rectangle>(a, b)); break;
+      case ShapeKind::square:                   owned.push_back(std::make_unique<Square>(a)); break;
+      case ShapeKind::parallelogram:            owned.push_back(std::make_unique<Parallelogram>(a, b, c)); break;
+      case ShapeKind::circle:                   owned.push_back(std::make_unique<Circle>(a)); break;
+      case ShapeKind::triangle:                 owned.push_back(std::make_unique<Triangle>(a, b, c, a + b)); break;
+      case ShapeKind::right_triangle:           owned.push_back(std::make_unique<RightTriangle>(a, b)); break;
+      case ShapeKind::isosceles_triangle:       owned.push_back(std::make_unique<IsoscelesTriangle>(a, b)); break;
+      case ShapeKind::equilateral_triangle:     owned.push_back(std::make_unique<EquilateralTriangle>(a)); break;
+      case ShapeKind::right_isosceles_triangle: owned.push_back(std::make_unique<RightIsoscelesTriangle>(a)); break;
+      }
+      shapes.push_back(owned.back().get());
+    }
+  }
+
+  auto const view = batch.view();
+  auto ok = curve("ShapeBatch"s, n, max_threads,
+                  [&](ThreadPool & pool) { return aggregate(view, pool); });
+  ok = curve("Shape *"s, shapes.size(), max_threads,
+             [&](ThreadPool & pool) { return aggregate(shapes, pool); }) && ok;
+
+  auto const result = aggregate(view);
+  std::cout << "total area " << result.all.area.total
+            << ", mean perimeter " << result.all.perimeter.mean() << '\n';
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    std::cout << "  " << std::left << std::setw(24) << shape_layouts[k].name << std::right
+              << result.kinds[k].count << '\n';
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+//
+//  BenchClassify.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 08:03:44.2716
+//
+//  Classifying raw side triples with TriangleClassifier against a
+//  plain loop that sorts each triple and tests it with branches.  The
+//  triples are scalene, right, isosceles, equilateral and right
+//  isosceles triangles in shuffled side order, with one in eight not a
+//  triangle at all.  Some isosceles ones are needles thin enough to
+//  pass the right test; those are right, not right isosceles.  Reports
+//  ns per row each way and the time to build a batch from the result.
+//  Fails if any row is filed under another kind than the one it was
+//  made as, if the two ways disagree, or if a built shape's area
+//  differs from the classifier's by more than rounding.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchClassify.cpp ShapeClassify.cpp ShapeBatch.cpp
+//  ./a.out [-n rows]
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ShapeClassify.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr double tolerance = 1e-9;
+
+/*
+ *  MARK: classify()
+ *  the plain way; the kind as an index, shape_kind_count if rejected.
+ */
+std::size_t classify(double a, double b, double c, double & area) {
+  std::array<double, 3> s { a, b, c };
+  std::sort(s.begin(), s.end());
+  auto const [lo, mid, hi] = s;
+  if (!(lo > 0) || !std::isfinite(hi) || !(hi < lo + mid)) {
+    area = NAN;
+    return shape_kind_count;
+  }
+  auto const p = (lo + mid + hi) / 2;
+  area = std::sqrt(p * (p - lo) * (p - mid) * (p - hi));
+  auto const eps = tolerance * hi;
+  bool const right = std::abs(lo * lo + mid * mid - hi * hi) <= tolerance * (hi * hi);
+  bool const isosceles = mid - lo <= eps || hi - mid <= eps;
+  if (hi - lo <= eps) {
+    return static_cast<std::size_t>(ShapeKind::equilateral_triangle);
+  }
+  if (right && mid - lo <= eps) {
+    return static_cast<std::size_t>(ShapeKind::right_isosceles_triangle);
+  }
+  if (right) {
+    return static_cast<std::size_t>(ShapeKind::right_triangle);
+  }
+  if (isosceles) {
+    return static_cast<std::size_t>(ShapeKind::isosceles_triangle);
+  }
+  return static_cast<std::size_t>(ShapeKind::triangle);
+}
+
+bool close(double value, double reference) {
+  return std::abs(value - reference) <= 1e-9 * std::abs(reference);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 4'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  //  made as kind, or shape_kind_count for a non-triangle
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> length(1, 100);
+  std::uniform_int_distribution<int> pick(0, 7);
+  std::vector<double> a(n);
+  std::vector<double> b(n);
+  std::vector<double> c(n);
+  std::vector<std::size_t> made(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::array<double, 3> s;
+    auto const p = length(rng);
+    auto const q = length(rng);
+    auto kind = ShapeKind::triangle;
+    switch (pick(rng)) {
+    case 0:
+    case 1:
+      s = { p, q, std::abs(p - q) + (p + q - std::abs(p - q)) * (0.1 + 0.8 * length(rng) / 100) };
+      break;
+
+    case 2:
+      kind = ShapeKind::right_triangle;
+      s = { p, q, std::hypot(p, q) };
+      break;
+
+    case 3:
+      kind = ShapeKind::isosceles_triangle;
+      s = { p, p, 2 * p * (0.05 + 0.4 * length(rng) / 100) };
+      break;
+
+    case 4:
+      kind = ShapeKind::equilateral_triangle;
+      s = { p, p, p };
+      break;
+
+    case 5:
+      kind = ShapeKind::right_isosceles_triangle;
+      s = { p, p, std::hypot(p, p) };
+      break;
+
+    case 6:
+      kind = ShapeKind::isosceles_triangle;
+      s = { p, p * 1.9, p * 1.9 };
+      //  needles: the right test passes, the legs are not equal
+      if (i % 2 == 0) {
+        kind = ShapeKind::right_triangle;
+        s = { p, p, p * 1e-5 };
+      }
+      break;
+
+    default:
+      s = { p, q, p + q + length(rng) };
+      if (i % 3 == 0) {
+        s[1] = i % 2 == 0 ? NAN : -q;
+      }
+      made[i] = shape_kind_count;
+      break;
+    }
+    if (made[i] != shape_kind_count) {
+      made[i] = static_cast<std::size_t>(kind);
+    }
+    std::shuffle(s.begin(), s.end(), rng);
+    a[i] = s[0];
+    b[i] = s[1];
+    c[i] = s[2];
+  }
+
+  //  the plain loop files rows the same way
+  std::array<std::vector<std::uint32_t>, shape_kind_count + 1> plain;
+  std::vector<double> plain_area(n);
+  auto const plain_ns = bench::best_ns([&] {
+    for (auto & list : plain) {
+      list.clear();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      plain[classify(a[i], b[i], c[i], plain_area[i])].push_back(static_cast<std::uint32_t>(i));
+    }
+  });
+
+  TriangleClassifier triangles(a, b, c, tolerance, false);
+  auto const classify_ns = bench::best_ns([&] {
+    triangles = TriangleClassifier(a, b, c, tolerance, false);
+  });
+
+  ShapeBatch batch;
+  auto const build_ns = bench::best_ns([&] {
+    batch = ShapeBatch();
+    triangles.build(batch);
+  });
+
+  bool ok = true;
+
+  bool filed = true;
+  bool agree = std::equal(triangles.rejected().begin(), triangles.rejected().end(),
+                          plain[shape_kind_count].begin(), plain[shape_kind_count].end());
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const list = triangles.indices(static_cast<ShapeKind>(k));
+    agree = agree && std::equal(list.begin(), list.end(), plain[k].begin(), plain[k].end());
+    for (auto const i : list) {
+      filed = filed && made[i] == k;
+    }
+  }
+  for (auto const i : triangles.rejected()) {
+    filed = filed && made[i] == shape_kind_count;
+  }
+  bench::report("rows filed as made", filed, ok);
+  bench::report("classifier against plain loop", agree, ok);
+
+  bool built = batch.size() == triangles.size();
+  auto const view = batch.view();
+  std::vector<double> areas;
+  for (std::size_t k = 0; built && k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const list = triangles.indices(kind);
+    areas.resize(view.size(kind));
+    view.areas(kind, areas.data());
+    built = areas.size() == list.size();
+    for (std::size_t r = 0; built && r < list.size(); ++r) {
+      built = close(areas[r], triangles.areas()[list[r]])
+           && close(plain_area[list[r]], triangles.areas()[list[r]]);
+    }
+  }
+  bench::report("built areas", built, ok);
+
+  std::cout << '\n' << n << " rows, " << triangles.rejected().size() << " rejected\n";
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    if (auto const count = triangles.indices(static_cast<ShapeKind>(k)).size()) {
+      std::cout << std::left << std::setw(28) << shape_layouts[k].name << std::right
+                << std::setw(12) << count << '\n';
+    }
+  }
+  std::cout << std::fixed << std::setprecision(2)
+            << "\nplain loop                  " << std::setw(10) << plain_ns / n
+            << " ns\nTriangleClassifier          " << std::setw(10) << classify_ns / n
+            << " ns\nbuild()                     " << std::setw(10) << build_ns / n << " ns\n"
+            << std::defaultfloat << std::setprecision(6);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+//
+//  BenchCollection.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:02:48.3361
+//
+//  Cost of keeping statistics current in a ShapeCollection against
+//  summing the whole collection again after every change.  A
+//  collection of shapes of all kinds takes a long random run of
+//  updates, removals and inserts, reading statistics() after each.
+//  Reports the time per change and the time of one full aggregate()
+//  over a batch of the same size, then how far the running totals have
+//  drifted from a fresh sum.  Fails if consistent() does not hold.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchCollection.cpp ShapeCollection.cpp ShapeAggregate.cpp ShapeValue.cpp ShapeBatch.cpp Shapes.cpp ShapeFormat.cpp ThreadPool.cpp -pthread
+//  ./a.out [-n shapes] [-c changes]
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ShapeAggregate.hpp"
+#include "ShapeBatch.hpp"
+#include "ShapeCollection.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: random_shape()
+ *  dimensions spread over six decades, so the totals mix magnitudes.
+ */
+template <typename Rng>
+ShapeValue random_shape(Rng & rng) {
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+  std::uniform_real_distribution<double> exponent(std::log(1e-3), std::log(1e3));
+  auto const dim = [&] { return std::exp(exponent(rng)); };
+  auto const a = dim();
+  auto const b = dim();
+  switch (static_cast<ShapeKind>(pick(rng))) {
+  case ShapeKind::rectangle:                return RectangleValue(a, b);
+  case ShapeKind::square:                   return SquareValue(a);
+  case ShapeKind::parallelogram:            return ParallelogramValue(a, b, b + dim());
+  case ShapeKind::circle:                   return CircleValue(a);
+  case ShapeKind::triangle:                 return TriangleValue(a, b, b + dim(), b + dim());
+  case ShapeKind::right_triangle:           return RightTriangleValue(a, b);
+  case ShapeKind::isosceles_triangle:       return IsoscelesTriangleValue(a, b);
+  case ShapeKind::equilateral_triangle:     return EquilateralTriangleValue(a);
+  case ShapeKind::right_isosceles_triangle: return RightIsoscelesTriangleValue(a);
+  }
+  return {};
+}
+
+double relative(double value, double reference) {
+  return value == reference ? 0 : std::abs(value - reference) / std::abs(reference);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 1'000'000;
+  std::size_t changes = 2'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+    else if (std::strcmp(argv[a], "-c") == 0) {
+      changes = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  ShapeCollection shapes;
+  std::vector<ShapeId> ids;
+  ids.reserve(n + changes);
+  for (std::size_t i = 0; i < n; ++i) {
+    ids.push_back(shapes.insert(random_shape(rng)));
+  }
+
+  //  a third each: update, remove, insert; the size stays near n
+  std::vector<ShapeValue> values(changes);
+  for (auto & value : values) {
+    value = random_shape(rng);
+  }
+  std::uniform_int_distribution<int> op(0, 2);
+  double seen = 0;
+  auto const change_ns = bench::best_ns([&] {
+    for (std::size_t c = 0; c < changes; ++c) {
+      auto const change = ids.empty() ? 2 : op(rng);
+      auto const at = ids.empty() ? 0 : std::uniform_int_distribution<std::size_t>(0, ids.size() - 1)(rng);
+      switch (change) {
+      case 0:
+        shapes.update(ids[at], values[c]);
+        break;
+
+      case 1:
+        shapes.remove(ids[at]);
+        ids[at] = ids.back();
+        ids.pop_back();
+        break;
+
+      default:
+        ids.push_back(shapes.insert(values[c]));
+        break;
+      }
+      seen += shapes.statistics().all.area.total;
+    }
+  }, 1);
+  bench::do_not_optimize(seen);
+
+  bool const ok = shapes.consistent();
+  auto const running = shapes.statistics();
+  auto fresh = running;
+  auto const recompute_ns = bench::best_ns([&] {
+    shapes.recompute();
+    fresh = shapes.statistics();
+  });
+
+  //  what a dashboard pays per change without the running state
+  ShapeBatch batch;
+  ThreadPool pool(1);
+  for (std::size_t i = 0; i < shapes.size(); ++i) {
+    batch.add_square(1.0 + i % 100);
+  }
+  auto const aggregate_ns = bench::best_ns([&] {
+    bench::do_not_optimize(aggregate(batch.view(), pool).all.area.total);
+  });
+
+  std::cout << shapes.size() << " shapes after " << changes << " changes\n"
+            << std::setw(36) << "area" << std::setw(14) << "perimeter" << '\n'
+            << std::scientific << std::setprecision(2)
+            << std::left << std::setw(22) << "drift, whole" << std::right
+            << std::setw(14) << relative(running.all.area.total, fresh.all.area.total)
+            << std::setw(14) << relative(running.all.perimeter.total, fresh.all.perimeter.total)
+            << '\n';
+  double area = 0;
+  double perimeter = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    area = std::max(area, relative(running.kinds[k].area.total, fresh.kinds[k].area.total));
+    perimeter = std::max(perimeter, relative(running.kinds[k].perimeter.total,
+                                             fresh.kinds[k].perimeter.total));
+  }
+  std::cout << std::left << std::setw(22) << "drift, worst kind" << std::right
+            << std::setw(14) << area << std::setw(14) << perimeter << '\n'
+            << std::fixed << std::setprecision(1)
+            << "\nchange + statistics()       " << std::setw(12) << change_ns / changes
+            << " ns\nrecompute() + statistics()  " << std::setw(12) << recompute_ns / 1e3
+            << " us\naggregate(), one thread     " << std::setw(12) << aggregate_ns / 1e3
+            << " us\nconsistent()                " << std::setw(12)
+            << (ok ? "yes" : "NO") << '\n'
+            << std::defaultfloat << std::setprecision(6);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+//
+//  BenchContains.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:58:14.5031
+//
+//  Point containment through the lane kernels against the scalar
+//  single-point contains(), for one placed shape of each kind and a
+//  cloud of points around it.  The scalar column is one call per point,
+//  as a caller without the array form would write it, so it includes
+//  setting up the edge functions each time.  The hoisted column sets
+//  them up once and runs the same expressions a point at a time, so
+//  its speedup is the lanes' alone.  Then the separating-axis
+//  overlaps() on random pairs.  Checks that all three containment paths
+//  agree on every point and that overlaps() agrees with sampled points
+//  found inside both shapes.
+//
+//  c++ -std=c++20 -O2 -mavx2 -I. bench/BenchContains.cpp ShapeCollide.cpp ShapeBounds.cpp ShapeBatch.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp
+//  ./a.out [-n points]
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ShapeBounds.hpp"
+#include "ShapeCollide.hpp"
+#include "ShapeKernels.hpp"
+#include "ShapeValue.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr std::size_t pairs = 1'000'000;
+constexpr std::size_t sampled_pairs = 2'000;
+constexpr std::size_t samples = 400;
+
+/*
+ *  MARK: random_shape()
+ */
+ShapeValue random_shape(ShapeKind kind, std::mt19937_64 & rng) {
+  std::uniform_real_distribution<double> dim(1.0, 10.0);
+  auto const a = dim(rng);
+  auto const b = dim(rng);
+  switch (kind) {
+  case ShapeKind::rectangle:                return RectangleValue(a, b);
+  case ShapeKind::square:                   return SquareValue(a);
+  case ShapeKind::parallelogram:            return ParallelogramValue(a, b, a + b / 2);
+  case ShapeKind::circle:                   return CircleValue(a);
+  case ShapeKind::triangle:                 return TriangleValue(a + b, a, a + 1, b + 1);
+  case ShapeKind::right_triangle:           return RightTriangleValue(a, b);
+  case ShapeKind::isosceles_triangle:       return IsoscelesTriangleValue(a, b);
+  case ShapeKind::equilateral_triangle:     return EquilateralTriangleValue(a);
+  case ShapeKind::right_isosceles_triangle: return RightIsoscelesTriangleValue(a);
+  }
+  return CircleValue(a);
+}
+
+/*
+ *  MARK: hoisted()
+ *  contains() with the edge functions of ShapeCollide.cpp set up once
+ *  for all the points.
+ */
+void hoisted(Outline const & o, double const * x, double const * y, std::uint8_t * out,
+             std::size_t n) {
+  if (o.size == 0) {
+    auto const r2 = o.radius * o.radius;
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const dx = x[i] - o.centre.x;
+      auto const dy = y[i] - o.centre.y;
+      out[i] = o.radius >= 0 && dx * dx + dy * dy <= r2;
+    }
+    return;
+  }
+  double area = 0;
+  for (std::uint8_t e = 0; e < o.size; ++e) {
+    auto const & p = o.corners[e];
+    auto const & q = o.corners[(e + 1) % o.size];
+    area += p.x * q.y - q.x * p.y;
+  }
+  auto const winding = area > 0 ? 1.0 : -1.0;
+  double a[4];
+  double b[4];
+  double c[4];
+  for (std::uint8_t e = 0; e < o.size; ++e) {
+    auto const & p = o.corners[e];
+    auto const & q = o.corners[(e + 1) % o.size];
+    a[e] = winding * (p.y - q.y);
+    b[e] = winding * (q.x - p.x);
+    c[e] = -(a[e] * p.x + b[e] * p.y);
+  }
+  auto const usable = area < 0 || area > 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    bool inside = usable;
+    for (std::uint8_t e = 0; inside && e < o.size; ++e) {
+      inside = 0 <= a[e] * x[i] + b[e] * y[i] + c[e];
+    }
+    out[i] = inside;
+  }
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 1'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> turn(0, 2 * M_PI);
+  std::vector<double> x(n);
+  std::vector<double> y(n);
+  std::vector<std::uint8_t> lanes(n);
+  std::vector<std::uint8_t> scalar(n);
+  std::vector<std::uint8_t> once(n);
+  bool ok = true;
+
+  std::cout << "containment, " << n << " points, " << shape_kernels::Lane::width << " lanes\n"
+            << std::left << std::setw(24) << "class" << std::right
+            << std::setw(12) << "lanes ns" << std::setw(12) << "scalar ns"
+            << std::setw(10) << "speedup" << std::setw(12) << "hoisted ns"
+            << std::setw(10) << "speedup" << std::setw(10) << "inside" << '\n';
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    auto const shape = outline(random_shape(kind, rng), { 3, -2, turn(rng) });
+    auto const box = bounds(shape);
+    std::uniform_real_distribution<double> px(box.min_x - 1, box.max_x + 1);
+    std::uniform_real_distribution<double> py(box.min_y - 1, box.max_y + 1);
+    for (std::size_t i = 0; i < n; ++i) {
+      x[i] = px(rng);
+      y[i] = py(rng);
+    }
+
+    auto const lanes_ns = bench::best_ns([&] {
+      contains(shape, x.data(), y.data(), lanes.data(), n);
+      bench::do_not_optimize(lanes.data());
+    });
+    auto const scalar_ns = bench::best_ns([&] {
+      for (std::size_t i = 0; i < n; ++i) {
+        scalar[i] = contains(shape, x[i], y[i]);
+      }
+      bench::do_not_optimize(scalar.data());
+    });
+    auto const hoisted_ns = bench::best_ns([&] {
+      hoisted(shape, x.data(), y.data(), once.data(), n);
+      bench::do_not_optimize(once.data());
+    });
+    auto const match = lanes == scalar && lanes == once;
+    ok = ok && match;
+    std::cout << std::left << std::setw(24) << shape_layouts[k].name << std::right << std::fixed
+              << std::setw(12) << std::setprecision(3) << lanes_ns / n
+              << std::setw(12) << std::setprecision(3) << scalar_ns / n
+              << std::setw(10) << std::setprecision(2) << scalar_ns / lanes_ns
+              << std::setw(12) << std::setprecision(3) << hoisted_ns / n
+              << std::setw(10) << std::setprecision(2) << hoisted_ns / lanes_ns
+              << std::setw(9) << std::setprecision(1)
+              << 100.0 * std::count(lanes.begin(), lanes.end(), 1) / n << '%'
+              << (match ? "" : "  MISMATCH") << std::defaultfloat << '\n';
+  }
+
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+  std::uniform_real_distribution<double> where(0, 25);
+  std::vector<Outline> a(pairs);
+  std::vector<Outline> b(pairs);
+  for (std::size_t i = 0; i < pairs; ++i) {
+    a[i] = outline(random_shape(static_cast<ShapeKind>(pick(rng)), rng),
+                   { where(rng), where(rng), turn(rng) });
+    b[i] = outline(random_shape(static_cast<ShapeKind>(pick(rng)), rng),
+                   { where(rng), where(rng), turn(rng) });
+  }
+  std::vector<std::uint8_t> hit(pairs);
+  auto const pairs_ns = bench::best_ns([&] { overlaps(a, b, hit.data()); });
+  std::cout << "\noverlaps, " << pairs << " pairs: " << std::fixed << std::setprecision(1)
+            << pairs_ns / pairs << " ns/pair, "
+            << 100.0 * std::count(hit.begin(), hit.end(), 1) / pairs << "% overlap"
+            << std::defaultfloat << std::setprecision(6) << '\n';
+
+  //  a point inside both shapes proves an overlap; none found proves nothing
+  std::size_t wrong = 0;
+  for (std::size_t i = 0; i < sampled_pairs; ++i) {
+    auto const box = bounds(a[i]);
+    std::uniform_real_distribution<double> px(box.min_x, box.max_x);
+    std::uniform_real_distribution<double> py(box.min_y, box.max_y);
+    bool both = false;
+    for (std::size_t s = 0; s < samples && !both; ++s) {
+      auto const sx = px(rng);
+      auto const sy = py(rng);
+      both = contains(a[i], sx, sy) && contains(b[i], sx, sy);
+    }
+    if ((both && !hit[i]) || hit[i] != overlaps(b[i], a[i])) {
+      ++wrong;
+    }
+  }
+  if (wrong > 0) {
+    std::cout << wrong << " of " << sampled_pairs << " sampled pairs disagree\n";
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
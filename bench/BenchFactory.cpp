@@ -0,0 +1,244 @@
+//
+//  BenchFactory.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:52:37.6120
+//
+//  Bulk construction with ShapeFactory against one shape at a time.
+//  Descriptors of every kind, shuffled, are built into heap objects,
+//  arena objects and a ShapeBatch, each first one by one and then by a
+//  factory.  Object times include a first area() and perimeter() on
+//  every shape, where the triangles derive their members.  Fails if the
+//  factory's objects or columns differ in any bit from the ones built
+//  one by one, or if the invalid descriptors mixed into a second run
+//  are not exactly the ones rejected.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchFactory.cpp ShapeFactory.cpp ShapeArena.cpp ShapeBatch.cpp Shapes.cpp ShapeFormat.cpp
+//  ./a.out [-n descriptors]
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "ShapeArena.hpp"
+#include "ShapeBatch.hpp"
+#include "ShapeFactory.hpp"
+#include "Shapes.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: make()
+ *  the shape of d, however alloc places an object of its class.
+ */
+template <typename Alloc>
+Shape * make(ShapeDescriptor const & d, Alloc && alloc) {
+  auto const p = d.params;
+  switch (d.kind) {
+  case ShapeKind::rectangle:                return alloc.template operator()<Rectangle>(p[0], p[1]);
+  case ShapeKind::square:                   return alloc.template operator()<Square>(p[0]);
+  case ShapeKind::parallelogram:            return alloc.template operator()<Parallelogram>(p[0], p[1], p[2]);
+  case ShapeKind::circle:                   return alloc.template operator()<Circle>(p[0]);
+  case ShapeKind::triangle:                 return alloc.template operator()<Triangle>(p[0], p[1], p[2], p[3]);
+  case ShapeKind::right_triangle:           return alloc.template operator()<RightTriangle>(p[0], p[1]);
+  case ShapeKind::isosceles_triangle:       return alloc.template operator()<IsoscelesTriangle>(p[0], p[1]);
+  case ShapeKind::equilateral_triangle:     return alloc.template operator()<EquilateralTriangle>(p[0]);
+  case ShapeKind::right_isosceles_triangle: return alloc.template operator()<RightIsoscelesTriangle>(p[0]);
+  }
+  return nullptr;
+}
+
+/*
+ *  MARK: first_use()
+ */
+double first_use(std::vector<Shape *> const & shapes) {
+  double total = 0;
+  for (auto const shape : shapes) {
+    total += shape->area() + shape->perimeter();
+  }
+  return total;
+}
+
+bool same(double a, double b) {
+  return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+/*
+ *  MARK: same_shape()
+ *  results and text bit for bit.
+ */
+bool same_shape(Shape const & a, Shape const & b) {
+  auto const [a0, a1, a2, a3] = a.dimensions();
+  auto const [b0, b1, b2, b3] = b.dimensions();
+  return same(a.area(), b.area()) && same(a.perimeter(), b.perimeter())
+      && same(a0, b0) && same(a1, b1) && same(a2, b2) && same(a3, b3)
+      && a.display() == b.display();
+}
+
+bool same_batch(ShapeBatch const & a, ShapeBatch const & b) {
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    if (a.size(kind) != b.size(kind)) {
+      return false;
+    }
+    for (std::size_t f = 0; f < layout_of(kind).fields; ++f) {
+      auto const x = a.column(kind, f);
+      auto const y = b.column(kind, f);
+      if (!x.empty() && std::memcmp(x.data(), y.data(), x.size_bytes()) != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 300'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dim(0.5, 50.0);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+  std::vector<ShapeDescriptor> descriptors(n);
+  for (auto & d : descriptors) {
+    d.kind = static_cast<ShapeKind>(pick(rng));
+    d.count = layout_of(d.kind).params;
+    auto const a = dim(rng);
+    auto const b = dim(rng);
+    //  a Triangle's sides must reach the apex: longer than the height
+    d.params[0] = a;
+    d.params[1] = b;
+    d.params[2] = b + dim(rng);
+    d.params[3] = b + dim(rng);
+  }
+
+  bool ok = true;
+
+  //  one by one
+  std::vector<std::unique_ptr<Shape>> owned;
+  std::vector<Shape *> heap;
+  auto const heap_ns = bench::best_ns([&] {
+    owned.clear();
+    heap.clear();
+    owned.reserve(n);
+    heap.reserve(n);
+    for (auto const & d : descriptors) {
+      owned.emplace_back(make(d, []<typename T>(auto... args) -> Shape * {
+        return new T(args...);
+      }));
+      heap.push_back(owned.back().get());
+    }
+    bench::do_not_optimize(first_use(heap));
+  });
+
+  ShapeArena single_arena;
+  std::vector<Shape *> singles;
+  auto const arena_ns = bench::best_ns([&] {
+    single_arena.release();
+    singles.clear();
+    singles.reserve(n);
+    for (auto const & d : descriptors) {
+      singles.push_back(make(d, [&]<typename T>(auto... args) -> Shape * {
+        return single_arena.make<T>(args...);
+      }));
+    }
+    bench::do_not_optimize(first_use(singles));
+  });
+
+  ShapeBatch single_batch;
+  auto const batch_ns = bench::best_ns([&] {
+    single_batch = ShapeBatch();
+    for (auto const & d : descriptors) {
+      single_batch.append(d.kind, d.params, d.count);
+    }
+    bench::do_not_optimize(single_batch.size());
+  });
+
+  //  by factory
+  ShapeArena bulk_arena;
+  std::vector<Shape *> bulk;
+  auto const factory_arena_ns = bench::best_ns([&] {
+    bulk_arena.release();
+    ShapeFactory const factory(descriptors);
+    bulk = factory.build(bulk_arena);
+    bench::do_not_optimize(first_use(bulk));
+  });
+
+  ShapeBatch bulk_batch;
+  auto const factory_batch_ns = bench::best_ns([&] {
+    bulk_batch.clear();
+    ShapeFactory const factory(descriptors);
+    factory.build(bulk_batch);
+    bench::do_not_optimize(bulk_batch.size());
+  });
+
+  bool objects = bulk.size() == singles.size();
+  for (std::size_t i = 0; objects && i < bulk.size(); ++i) {
+    objects = same_shape(*bulk[i], *singles[i]);
+  }
+  bench::report("factory objects vs one by one", objects, ok);
+  bench::report("factory batch vs one by one", same_batch(bulk_batch, single_batch), ok);
+
+  //  every seventh descriptor broken, one way or another
+  auto broken = descriptors;
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < broken.size(); i += 7) {
+    auto & d = broken[i];
+    switch (i / 7 % 5) {
+    case 0: d.params[0] = -d.params[0]; break;
+    case 1: d.params[0] = NAN; break;
+    case 2: d.params[layout_of(d.kind).required - 1] = INFINITY; break;
+    case 3: d.count = layout_of(d.kind).params + 1; break;
+    case 4: d.kind = static_cast<ShapeKind>(shape_kind_count); break;
+    }
+    expected.push_back(i);
+  }
+  ShapeFactory const lenient(broken, false);
+  bench::report("rejected descriptors", lenient.rejected() == expected, ok);
+  ShapeBatch kept;
+  for (std::size_t i = 0; i < broken.size(); ++i) {
+    if (i % 7 != 0) {
+      kept.append(broken[i].kind, broken[i].params, broken[i].count);
+    }
+  }
+  bench::report("lenient batch vs one by one", same_batch(lenient.batch(), kept), ok);
+  bool threw = false;
+  try {
+    ShapeFactory const strict(broken);
+  }
+  catch (std::invalid_argument const &) {
+    threw = true;
+  }
+  bench::report("strict factory throws", threw == !expected.empty(), ok);
+
+  auto const shapes = static_cast<double>(n);
+  std::cout << '\n' << n << " descriptors                ns/shape\n" << std::fixed
+            << std::setprecision(2)
+            << "new, one by one             " << std::setw(10) << heap_ns / shapes << '\n'
+            << "arena, one by one           " << std::setw(10) << arena_ns / shapes << '\n'
+            << "arena, factory              " << std::setw(10) << factory_arena_ns / shapes << '\n'
+            << "batch, one by one           " << std::setw(10) << batch_ns / shapes << '\n'
+            << "batch, factory              " << std::setw(10) << factory_batch_ns / shapes << '\n'
+            << std::defaultfloat << std::setprecision(6);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+//
+//  BenchFloat.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 04:06:21.9347
+//
+//  Accuracy and speed of ShapeBatchFloat against ShapeBatch, whose
+//  kernels give area() and perimeter() bit for bit.  Dimensions are
+//  log-uniform over each range in turn.  For every kind, reports the
+//  largest relative error of the derived fields, areas and perimeters,
+//  and of the area and perimeter totals with float and with widened
+//  accumulation.  Then the time of the double and float kernels over
+//  the whole batch.  Fails if any stored field, area or perimeter is
+//  outside float_tolerance.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchFloat.cpp ShapeBatchFloat.cpp ShapeBatch.cpp
+//  ./a.out [-n shapes-per-kind]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeBatchFloat.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: relative()
+ *  NaN in both is no error, NaN in one is an infinite one.
+ */
+double relative(double value, double reference) {
+  if (std::isnan(value) || std::isnan(reference)) {
+    return std::isnan(value) && std::isnan(reference) ? 0 : INFINITY;
+  }
+  return std::abs(value - reference) / std::abs(reference);
+}
+
+template <typename Float>
+double worst(std::vector<Float> const & values, std::vector<double> const & reference) {
+  double error = 0;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    error = std::max(error, relative(values[i], reference[i]));
+  }
+  return error;
+}
+
+/*
+ *  MARK: reference_total()
+ *  long double sum of the double values.
+ */
+double reference_total(std::vector<double> const & values) {
+  long double total = 0;
+  for (auto const x : values) {
+    total += x;
+  }
+  return static_cast<double>(total);
+}
+
+void column(char const * name, double error) {
+  std::cout << std::setw(11) << name << std::scientific << std::setw(10) << std::setprecision(2)
+            << error << std::defaultfloat << std::setprecision(6);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 200'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  struct Range {
+    double low;
+    double high;
+  };
+  constexpr Range ranges[] = { { 0.1, 100.0 }, { 1e-3, 1e3 }, { 1.0, 1e6 } };
+
+  bool ok = true;
+  ShapeBatch batch;
+  for (auto const range : ranges) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> exponent(std::log(range.low), std::log(range.high));
+    auto const dim = [&] { return std::exp(exponent(rng)); };
+
+    batch.clear();
+    for (std::size_t k = 0; k < shape_kind_count; ++k) {
+      auto const kind = static_cast<ShapeKind>(k);
+      batch.reserve(kind, n);
+      for (std::size_t i = 0; i < n; ++i) {
+        auto const a = dim();
+        auto const b = dim();
+        //  a Triangle's sides must reach the apex: longer than the height
+        double const params[] = { a, b, b * (1 + dim() / range.high), b * (1 + dim() / range.high) };
+        batch.append(kind, params, layout_of(kind).params);
+      }
+    }
+    ShapeBatchFloat const floats(batch.view());
+
+    std::cout << "dimensions " << range.low << " to " << range.high << ", " << n
+              << " per kind, relative errors\n";
+    for (std::size_t k = 0; k < shape_kind_count; ++k) {
+      auto const kind = static_cast<ShapeKind>(k);
+      auto const & layout = layout_of(kind);
+
+      double fields = 0;
+      for (std::size_t f = 0; f < layout.fields; ++f) {
+        auto const d = batch.column(kind, f);
+        auto const s = floats.column(kind, f);
+        for (std::size_t i = 0; i < n; ++i) {
+          fields = std::max(fields, relative(s[i], d[i]));
+        }
+      }
+
+      std::vector<double> d_area(n), d_perimeter(n);
+      std::vector<float> s_area(n), s_perimeter(n);
+      batch.areas(kind, d_area.data());
+      batch.perimeters(kind, d_perimeter.data());
+      floats.areas(kind, s_area.data());
+      floats.perimeters(kind, s_perimeter.data());
+      auto const area = worst(s_area, d_area);
+      auto const perimeter = worst(s_perimeter, d_perimeter);
+
+      std::cout << std::left << std::setw(24) << layout.name << std::right;
+      column("fields", fields);
+      column("area", area);
+      column("perimeter", perimeter);
+      auto const pass = fields <= float_tolerance && area <= float_tolerance
+                     && perimeter <= float_tolerance;
+      std::cout << (pass ? "" : "  OUT OF TOLERANCE") << '\n';
+      ok = ok && pass;
+    }
+
+    std::vector<double> d_area(batch.size()), d_perimeter(batch.size());
+    batch.areas(d_area.data());
+    batch.perimeters(d_perimeter.data());
+    auto const area = reference_total(d_area);
+    auto const perimeter = reference_total(d_perimeter);
+    std::cout << std::left << std::setw(45) << "total, float" << std::right;
+    column("area", relative(floats.total_area(Accumulator::single), area));
+    column("perimeter", relative(floats.total_perimeter(Accumulator::single), perimeter));
+    std::cout << '\n' << std::left << std::setw(45) << "total, widened" << std::right;
+    column("area", relative(floats.total_area(Accumulator::widened), area));
+    column("perimeter", relative(floats.total_perimeter(Accumulator::widened), perimeter));
+    std::cout << "\n\n";
+  }
+
+  //  the last range's batch
+  ShapeBatchFloat const floats(batch.view());
+  std::vector<double> d_out(batch.size());
+  std::vector<float> s_out(batch.size());
+  auto const d_ns = bench::best_ns([&] {
+    batch.areas(d_out.data());
+    batch.perimeters(d_out.data());
+    bench::do_not_optimize(d_out.front());
+  });
+  auto const s_ns = bench::best_ns([&] {
+    floats.areas(s_out.data());
+    floats.perimeters(s_out.data());
+    bench::do_not_optimize(s_out.front());
+  });
+  double d_total = 0;
+  auto const d_total_ns = bench::best_ns([&] {
+    batch.areas(d_out.data());
+    d_total = std::accumulate(d_out.begin(), d_out.end(), 0.0);
+    bench::do_not_optimize(d_total);
+  });
+  double s_total = 0;
+  auto const s_total_ns = bench::best_ns([&] {
+    s_total = floats.total_area();
+    bench::do_not_optimize(s_total);
+  });
+
+  auto const shapes = static_cast<double>(batch.size());
+  std::cout << "kernels, " << batch.size() << " shapes         ns/shape\n" << std::fixed
+            << std::setprecision(3)
+            << "double areas + perimeters  " << std::setw(10) << d_ns / shapes << '\n'
+            << "float areas + perimeters   " << std::setw(10) << s_ns / shapes << '\n'
+            << "double area total          " << std::setw(10) << d_total_ns / shapes << '\n'
+            << "float area total, widened  " << std::setw(10) << s_total_ns / shapes << '\n'
+            << std::defaultfloat << std::setprecision(6);
+  return ok ? 0 : 1;
+}
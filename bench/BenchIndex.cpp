@@ -0,0 +1,208 @@
+//
+//  BenchIndex.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 23:05:51.2087
+//
+//  ShapeIndex over randomly placed shapes: build time on pools of 1, 2,
+//  4, ... threads up to the hardware thread count (or -t), then the
+//  cost of range, point and k-nearest queries.  Checks that every pool
+//  size builds the same tree and that a sample of queries matches a
+//  linear scan.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchIndex.cpp ShapeIndex.cpp ShapeBounds.cpp ShapeBatch.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp ThreadPool.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeBounds.hpp"
+#include "ShapeIndex.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr double world = 100'000;
+constexpr std::size_t queries = 10'000;
+constexpr std::size_t checked = 200;
+
+/*
+ *  MARK: scan()
+ *  the linear-scan answer to a range query.
+ */
+std::vector<ShapeIndex::Id> scan(std::vector<Box> const & boxes, Box const & region) {
+  std::vector<ShapeIndex::Id> ids;
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    if (boxes[i].overlaps(region)) {
+      ids.push_back(static_cast<ShapeIndex::Id>(i));
+    }
+  }
+  return ids;
+}
+
+/*
+ *  MARK: scan_nearest()
+ */
+std::vector<ShapeIndex::Id> scan_nearest(std::vector<Box> const & boxes,
+                                         double x, double y, std::size_t k) {
+  std::vector<ShapeIndex::Neighbour> all;
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    all.push_back({ static_cast<ShapeIndex::Id>(i), boxes[i].distance2(x, y) });
+  }
+  k = std::min(k, all.size());
+  std::partial_sort(all.begin(), all.begin() + k, all.end(), [](auto const & a, auto const & b) {
+    return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+  });
+  std::vector<ShapeIndex::Id> ids;
+  for (std::size_t i = 0; i < k; ++i) {
+    ids.push_back(all[i].id);
+  }
+  return ids;
+}
+
+/*
+ *  MARK: report()
+ */
+void report(char const * name, double ns, double hits) {
+  std::cout << std::left << std::setw(12) << name << std::right << std::fixed
+            << std::setw(10) << std::setprecision(2) << ns / queries / 1e3 << " us/query"
+            << std::setw(10) << std::setprecision(1) << hits / queries << " hits/query"
+            << std::defaultfloat << std::setprecision(6) << '\n';
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 4'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dim(0.5, 100.0);
+  std::uniform_real_distribution<double> where(0, world);
+  std::uniform_real_distribution<double> turn(0, 2 * M_PI);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+
+  ShapeBatch batch;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const a = dim(rng);
+    auto const b = dim(rng);
+    double const params[] = { a, a + b, a + b / 2, a + b };
+    auto const kind = static_cast<ShapeKind>(pick(rng));
+    batch.append(kind, params, layout_of(kind).params);
+  }
+  std::vector<Placement> at(n);
+  for (auto & p : at) {
+    p = { where(rng), where(rng), turn(rng) };
+  }
+  std::vector<Box> boxes(n);
+  auto const bounds_ns = bench::best_ns([&] { bounds(batch.view(), at, boxes.data()); }, 1);
+  std::cout << n << " shapes, bounds " << std::fixed << std::setprecision(1)
+            << bounds_ns / 1e6 << " ms\n\n"
+            << std::setw(8) << "threads" << std::setw(12) << "build ms"
+            << std::setw(10) << "nodes" << '\n';
+
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+
+  ShapeIndex index;
+  std::vector<ShapeIndex::Id> reference;
+  bool ok = true;
+  for (auto const t : sizes) {
+    ThreadPool pool(t);
+    auto const ns = bench::best_ns([&] { index.build(boxes, pool); }, 3);
+    std::vector<ShapeIndex::Id> all;
+    index.query(index.bounds(), all);
+    if (t == sizes.front()) {
+      reference = all;
+    }
+    auto const match = all == reference;
+    ok = ok && match;
+    std::cout << std::setw(8) << t << std::setw(12) << std::setprecision(1) << ns / 1e6
+              << std::setw(10) << index.nodes() << (match ? "" : "  MISMATCH") << '\n';
+  }
+  std::cout << std::defaultfloat << std::setprecision(6) << '\n';
+
+  std::vector<Box> regions(queries);
+  std::vector<Point> points(queries);
+  for (std::size_t q = 0; q < queries; ++q) {
+    auto const x = where(rng);
+    auto const y = where(rng);
+    regions[q] = { x, y, x + 500, y + 500 };
+    points[q] = { where(rng), where(rng) };
+  }
+
+  std::vector<ShapeIndex::Id> ids;
+  std::vector<ShapeIndex::Neighbour> near;
+  double hits = 0;
+  auto const range_ns = bench::best_ns([&] {
+    hits = 0;
+    for (auto const & r : regions) {
+      ids.clear();
+      index.query(r, ids);
+      hits += ids.size();
+    }
+  });
+  report("range", range_ns, hits);
+  auto const point_ns = bench::best_ns([&] {
+    hits = 0;
+    for (auto const & p : points) {
+      ids.clear();
+      index.query(p.x, p.y, ids);
+      hits += ids.size();
+    }
+  });
+  report("point", point_ns, hits);
+  auto const nearest_ns = bench::best_ns([&] {
+    hits = 0;
+    for (auto const & p : points) {
+      near.clear();
+      index.nearest(p.x, p.y, 8, near);
+      hits += near.size();
+    }
+  });
+  report("nearest 8", nearest_ns, hits);
+
+  for (std::size_t q = 0; q < checked; ++q) {
+    ids.clear();
+    index.query(regions[q], ids);
+    std::sort(ids.begin(), ids.end());
+    near.clear();
+    index.nearest(points[q].x, points[q].y, 8, near);
+    std::vector<ShapeIndex::Id> near_ids;
+    for (auto const & neighbour : near) {
+      near_ids.push_back(neighbour.id);
+    }
+    if (ids != scan(boxes, regions[q]) || near_ids != scan_nearest(boxes, points[q].x, points[q].y, 8)) {
+      std::cout << "query " << q << " differs from a linear scan\n";
+      ok = false;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+//
+//  BenchIntern.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 05:31:12.4408
+//
+//  Memory and time of interned shapes against one object per shape.
+//  Shapes are drawn with a heavy skew from a pool of distinct ones, as
+//  in real datasets where the same few sizes repeat.  Reports the bytes
+//  allocated each way, the time to build and to total the areas, and
+//  the time to intern the whole set on pools of 1, 2, 4, ... threads.
+//  Fails if any cached area or perimeter differs from the object's, if
+//  equal shapes get different handles, if NaN padding with any payload
+//  is not treated as one value, or if a negative NaN is not kept apart
+//  from it.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchIntern.cpp bench/AllocCounter.cpp ShapeIntern.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp ShapeBatch.cpp ThreadPool.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes] [-d distinct]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShapeFactory.hpp"
+#include "ShapeIntern.hpp"
+#include "Shapes.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: make()
+ */
+std::unique_ptr<Shape> make(ShapeDescriptor const & d) {
+  //  arguments not given are NAN, as ShapeBatch::append() pads them
+  double p[4];
+  for (std::size_t f = 0; f < 4; ++f) {
+    p[f] = f < d.count ? d.params[f] : NAN;
+  }
+  switch (d.kind) {
+  case ShapeKind::rectangle:                return std::make_unique<Rectangle>(p[0], p[1]);
+  case ShapeKind::square:                   return std::make_unique<Square>(p[0]);
+  case ShapeKind::parallelogram:            return std::make_unique<Parallelogram>(p[0], p[1], p[2]);
+  case ShapeKind::circle:                   return std::make_unique<Circle>(p[0]);
+  case ShapeKind::triangle:                 return std::make_unique<Triangle>(p[0], p[1], p[2], p[3]);
+  case ShapeKind::right_triangle:           return std::make_unique<RightTriangle>(p[0], p[1]);
+  case ShapeKind::isosceles_triangle:       return std::make_unique<IsoscelesTriangle>(p[0], p[1]);
+  case ShapeKind::equilateral_triangle:     return std::make_unique<EquilateralTriangle>(p[0]);
+  case ShapeKind::right_isosceles_triangle: return std::make_unique<RightIsoscelesTriangle>(p[0]);
+  }
+  return nullptr;
+}
+
+bool same(double a, double b) {
+  return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+void row(char const * name, double mib, double ms) {
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+            << std::setw(10) << std::setprecision(1) << mib
+            << std::setw(10) << std::setprecision(2) << ms << '\n'
+            << std::defaultfloat << std::setprecision(6);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 2'000'000;
+  std::size_t distinct = 2'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+    else if (std::strcmp(argv[a], "-d") == 0) {
+      distinct = std::max<std::size_t>(1, std::strtoull(argv[a + 1], nullptr, 10));
+    }
+  }
+
+  //  the pool, whole and half sizes; Triangles half with sides not given
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+  std::uniform_int_distribution<int> size(1, 80);
+  std::vector<ShapeDescriptor> pool(distinct);
+  for (std::size_t i = 0; i < distinct; ++i) {
+    auto & d = pool[i];
+    d.kind = static_cast<ShapeKind>(pick(rng));
+    d.count = i % 2 == 0 ? layout_of(d.kind).params : layout_of(d.kind).required;
+    auto const b = size(rng) / 2.;
+    d.params[0] = size(rng) / 2.;
+    d.params[1] = b;
+    d.params[2] = b + size(rng);
+    d.params[3] = b + size(rng);
+  }
+  //  log-uniform rank: the first few dominate
+  std::uniform_real_distribution<double> rank(0, std::log(double(distinct)));
+  std::vector<ShapeDescriptor> descriptors(n);
+  for (auto & d : descriptors) {
+    d = pool[std::min(distinct - 1, static_cast<std::size_t>(std::exp(rank(rng))) - 1)];
+  }
+
+  bool ok = true;
+
+  //  one object per shape
+  auto before = bench::alloc_stats();
+  std::vector<std::unique_ptr<Shape>> objects;
+  objects.reserve(n);
+  auto const objects_ns = bench::best_ns([&] {
+    objects.clear();
+    for (auto const & d : descriptors) {
+      objects.push_back(make(d));
+    }
+  }, 1);
+  auto const objects_bytes = bench::alloc_stats().bytes - before.bytes;
+  double objects_total = 0;
+  auto const objects_area_ns = bench::best_ns([&] {
+    objects_total = 0;
+    for (auto const & s : objects) {
+      objects_total += s->area();
+    }
+    bench::do_not_optimize(objects_total);
+  });
+
+  //  one handle per shape
+  before = bench::alloc_stats();
+  ShapeInterner interner;
+  std::vector<ShapeHandle> handles(n);
+  auto const intern_ns = bench::best_ns([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      handles[i] = interner.intern(descriptors[i].kind, descriptors[i].params, descriptors[i].count);
+    }
+  }, 1);
+  auto const intern_bytes = bench::alloc_stats().bytes - before.bytes;
+  double intern_total = 0;
+  auto const intern_area_ns = bench::best_ns([&] {
+    intern_total = 0;
+    for (auto const h : handles) {
+      intern_total += h->area;
+    }
+    bench::do_not_optimize(intern_total);
+  });
+
+  bool cached = true;
+  bool shared = true;
+  for (std::size_t i = 0; i < n; ++i) {
+    cached = cached && same(handles[i]->area, objects[i]->area())
+                    && same(handles[i]->perimeter, objects[i]->perimeter());
+    shared = shared && interner.intern(*objects[i]) == handles[i];
+  }
+  std::vector<ShapeHandle> unique(handles);
+  std::sort(unique.begin(), unique.end());
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+  bench::report("cached area and perimeter", cached, ok);
+  auto const interned = interner.size();
+  bench::report("one handle per distinct shape", shared && unique.size() == interned, ok);
+
+  double const sides[] = { 3, 4, NAN, NAN };
+  double const payload[] = { 3, 4, std::nan("1"), std::nan("7") };
+  double const negative[] = { 3, 4, -NAN, NAN };
+  auto const padded = interner.intern(ShapeKind::triangle, sides, 2);
+  bench::report("NaN padding",
+                padded == interner.intern(ShapeKind::triangle, sides, 4)
+                && padded == interner.intern(ShapeKind::triangle, payload, 4)
+                && padded == interner.intern(TriangleValue(3, 4))
+                && padded != interner.intern(ShapeKind::right_triangle, sides, 2), ok);
+  bench::report("negative NaN kept apart",
+                padded != interner.intern(ShapeKind::triangle, negative, 4), ok);
+
+  std::cout << '\n' << n << " shapes, " << interned << " distinct\n"
+            << std::setw(34) << "MiB" << std::setw(10) << "ms" << '\n';
+  row("objects, build", objects_bytes / 1048576., objects_ns / 1e6);
+  row("objects, area total", 0, objects_area_ns / 1e6);
+  row("interned, build", intern_bytes / 1048576., intern_ns / 1e6);
+  row("interned, area total", 0, intern_area_ns / 1e6);
+
+  //  concurrent interning into a fresh table
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+  std::cout << '\n' << std::setw(8) << "threads" << std::setw(12) << "ms" << '\n';
+  constexpr std::size_t chunk = 4096;
+  for (auto const t : sizes) {
+    ThreadPool threads(t);
+    std::unique_ptr<ShapeInterner> table;
+    std::vector<ShapeHandle> mine(n);
+    auto const ns = bench::best_ns([&] {
+      table = std::make_unique<ShapeInterner>();
+      threads.parallel_for((n + chunk - 1) / chunk, [&](std::size_t c) {
+        for (std::size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); ++i) {
+          mine[i] = table->intern(descriptors[i].kind, descriptors[i].params, descriptors[i].count);
+        }
+      });
+    });
+    bool match = table->size() == interned;
+    for (std::size_t i = 0; match && i < n; ++i) {
+      match = mine[i] == table->find(descriptors[i].kind, descriptors[i].params, descriptors[i].count)
+           && interner.intern(mine[i]->value) == handles[i];
+    }
+    ok = ok && match;
+    std::cout << std::fixed << std::setw(8) << t << std::setw(12) << std::setprecision(2)
+              << ns / 1e6 << (match ? "" : "  MISMATCH") << '\n'
+              << std::defaultfloat << std::setprecision(6);
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+//
+//  BenchPack.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 07:26:05.8841
+//
+//  Packing random rectangles onto sheets, with skyline and maxrects,
+//  with and without rotation.  Reports rectangles per second, sheets
+//  used and utilization, then the time for the same rectangles split
+//  into independent jobs on pools of 1, 2, 4, ... threads.  Fails if a
+//  placed rectangle leaves its sheet or overlaps another, if the ones
+//  too large for a sheet are not exactly the rejected ones, or if a job
+//  packs differently on a pool than alone.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchPack.cpp ShapePack.cpp ShapeBounds.cpp ShapeBatch.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp ThreadPool.cpp -pthread
+//  ./a.out [-t max-threads] [-n rectangles]
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShapeBounds.hpp"
+#include "ShapePack.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+/*
+ *  MARK: valid()
+ *  inside the sheet and apart, through the outlines of ShapeBounds.hpp;
+ *  turned rectangles are allowed rounding from cos(pi / 2).
+ */
+bool valid(std::span<RectDims const> rects, Packing const & p) {
+  constexpr double slack = 1e-9;
+  std::vector<std::vector<Box>> sheets(p.sheets());
+  for (std::size_t i = 0; i < rects.size(); ++i) {
+    if (p.sheet[i] == Packing::unpacked) {
+      continue;
+    }
+    double const fields[] = { rects[i].length, rects[i].breadth };
+    auto box = bounds(outline(ShapeKind::rectangle, fields, p.at[i]));
+    if (box.min_x < -slack || box.min_y < -slack
+        || box.max_x > p.width + slack || box.max_y > p.height + slack) {
+      return false;
+    }
+    box.min_x += slack;
+    box.min_y += slack;
+    box.max_x -= slack;
+    box.max_y -= slack;
+    if (!box.empty()) {
+      sheets[p.sheet[i]].push_back(box);
+    }
+  }
+  for (auto & boxes : sheets) {
+    std::sort(boxes.begin(), boxes.end(),
+              [](Box const & a, Box const & b) { return a.min_x < b.min_x; });
+    for (std::size_t a = 0; a < boxes.size(); ++a) {
+      for (auto b = a + 1; b < boxes.size() && boxes[b].min_x < boxes[a].max_x; ++b) {
+        if (boxes[a].min_y < boxes[b].max_y && boxes[b].min_y < boxes[a].max_y) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool same(Packing const & a, Packing const & b) {
+  return a.used == b.used && a.sheet == b.sheet && a.rejected == b.rejected
+      && std::equal(a.at.begin(), a.at.end(), b.at.begin(), [](Placement const & p, Placement const & q) {
+           return p.x == q.x && p.y == q.y && p.angle == q.angle;
+         });
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 200'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  //  parts of 5 to 120 on 1000 x 1000 sheets; one in a thousand too long
+  //  to fit either way
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> side(5, 120);
+  std::vector<RectDims> rects(n);
+  std::size_t too_large = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    rects[i] = { std::round(side(rng)), std::round(side(rng)) };
+    if (i % 1000 == 999) {
+      rects[i].length = 1500;
+      ++too_large;
+    }
+  }
+
+  bool ok = true;
+  std::cout << n << " rectangles on 1000 x 1000 sheets\n"
+            << std::left << std::setw(20) << "heuristic" << std::right
+            << std::setw(14) << "rects/s" << std::setw(10) << "sheets"
+            << std::setw(14) << "utilization" << '\n';
+  for (auto const heuristic : { PackHeuristic::skyline, PackHeuristic::maxrects }) {
+    for (auto const rotate : { false, true }) {
+      PackOptions options;
+      options.width = 1000;
+      options.height = 1000;
+      options.heuristic = heuristic;
+      options.rotate = rotate;
+      Packing packing;
+      auto const ns = bench::best_ns([&] { packing = pack(rects, options); }, 3);
+      auto const pass = packing.rejected == too_large && valid(rects, packing);
+      ok = ok && pass;
+      std::string name = heuristic == PackHeuristic::skyline ? "skyline" : "maxrects";
+      name += rotate ? ", rotate" : "";
+      std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+                << std::setw(14) << std::setprecision(0) << n / (ns / 1e9)
+                << std::setw(10) << packing.sheets()
+                << std::setw(13) << std::setprecision(1) << 100 * packing.utilization() << '%'
+                << (pass ? "" : "  MISMATCH") << '\n'
+                << std::defaultfloat << std::setprecision(6);
+    }
+  }
+
+  //  independent jobs of 1 / 64 of the rectangles each
+  constexpr std::size_t job_count = 64;
+  PackOptions options;
+  options.width = 1000;
+  options.height = 1000;
+  options.heuristic = PackHeuristic::maxrects;
+  std::vector<PackJob> jobs;
+  std::vector<Packing> alone;
+  for (std::size_t j = 0; j < job_count; ++j) {
+    auto const first = n * j / job_count;
+    auto const last = n * (j + 1) / job_count;
+    jobs.push_back({ std::span<RectDims const>(rects).subspan(first, last - first), options });
+    alone.push_back(pack(jobs.back().rectangles, options));
+  }
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+  std::cout << '\n' << job_count << " maxrects jobs\n"
+            << std::setw(8) << "threads" << std::setw(14) << "rects/s" << '\n';
+  for (auto const t : sizes) {
+    ThreadPool pool(t);
+    std::vector<Packing> results;
+    auto const ns = bench::best_ns([&] { results = pack(jobs, pool); }, 3);
+    bool match = results.size() == job_count;
+    for (std::size_t j = 0; match && j < job_count; ++j) {
+      match = same(results[j], alone[j]);
+    }
+    ok = ok && match;
+    std::cout << std::fixed << std::setw(8) << t << std::setw(14) << std::setprecision(0)
+              << n / (ns / 1e9) << (match ? "" : "  MISMATCH") << '\n'
+              << std::defaultfloat << std::setprecision(6);
+  }
+  return ok ? 0 : 1;
+}
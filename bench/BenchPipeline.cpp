@@ -0,0 +1,145 @@
+//
+//  BenchPipeline.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 03:12:44.5081
+//
+//  The shape report job over a generated CSV file of all nine kinds:
+//  run_sequential() against run_pipeline() on 1, 2, 4, ... threads up
+//  to the hardware thread count (or -t), one lane per thread, and with
+//  a single lane.  Reports input MB/s and Mshapes/s, and checks that
+//  every run writes the same bytes as the sequential run and that its
+//  totals agree.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchPipeline.cpp ShapePipeline.cpp ShapeLoader.cpp ShapeBatch.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapePipeline.hpp"
+#include "BenchUtil.hpp"
+
+using namespace shape_pipeline;
+
+//  MARK: - Helpers.
+namespace {
+
+std::string slurp(std::string const & path) {
+  std::ifstream in(path, std::ios::binary);
+  return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+}
+
+bool close(double a, double b) {
+  return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b));
+}
+
+/*
+ *  MARK: report()
+ */
+void report(char const * name, unsigned threads, unsigned lanes, double ns,
+            PipelineStats const & stats, bool match) {
+  std::cout << std::left << std::setw(12) << name << std::right << std::setw(8) << threads
+            << std::setw(8) << lanes
+            << std::fixed << std::setw(12) << std::setprecision(1) << ns / 1e6
+            << std::setw(12) << std::setprecision(1) << stats.bytes_in / ns * 1e3
+            << std::setw(12) << std::setprecision(2) << stats.records / ns * 1e3
+            << (match ? "" : "  MISMATCH") << std::defaultfloat << std::setprecision(6) << '\n';
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 1'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  auto const dir = std::filesystem::temp_directory_path();
+  auto const in = (dir / "BenchPipeline.in.csv").string();
+  auto const reference = (dir / "BenchPipeline.seq.txt").string();
+  auto const out = (dir / "BenchPipeline.out.txt").string();
+  {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dim(0.5, 100.0);
+    std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+    std::ofstream csv(in, std::ios::binary);
+    csv << "# " << n << " shapes\n" << std::setprecision(17);
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const kind = static_cast<ShapeKind>(pick(rng));
+      auto const & layout = layout_of(kind);
+      csv << layout.name;
+      for (std::size_t p = 0; p < layout.params; ++p) {
+        csv << ',' << dim(rng);
+      }
+      csv << '\n';
+    }
+  }
+
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+
+  PipelineStats expected;
+  auto const seq_ns = bench::best_ns([&] { expected = run_sequential(in, reference); }, 3);
+  auto const text = slurp(reference);
+
+  std::cout << n << " shapes, " << std::fixed << std::setprecision(1)
+            << expected.bytes_in / 1e6 << " MB in, " << expected.bytes_out / 1e6 << " MB out\n"
+            << std::defaultfloat << std::setprecision(6)
+            << std::left << std::setw(12) << "" << std::right << std::setw(8) << "threads"
+            << std::setw(8) << "lanes" << std::setw(12) << "ms" << std::setw(12) << "MB/s"
+            << std::setw(12) << "Mshapes/s" << '\n';
+  report("sequential", 1, 1, seq_ns, expected, true);
+
+  bool ok = true;
+  auto const run = [&](unsigned threads, unsigned lanes) {
+    PipelineOptions options;
+    options.threads = threads;
+    options.lanes = lanes;
+    PipelineStats stats;
+    auto const ns = bench::best_ns([&] { stats = run_pipeline(in, out, options); }, 3);
+    auto const match = stats.records == expected.records && stats.bytes_out == expected.bytes_out
+                    && close(stats.area, expected.area)
+                    && close(stats.perimeter, expected.perimeter) && slurp(out) == text;
+    report("pipeline", threads, lanes, ns, stats, match);
+    ok = ok && match;
+  };
+  for (auto const t : sizes) {
+    run(t, 1);
+    if (t > 1) {
+      run(t, t);
+    }
+  }
+
+  std::filesystem::remove(in);
+  std::filesystem::remove(reference);
+  std::filesystem::remove(out);
+  return ok ? 0 : 1;
+}
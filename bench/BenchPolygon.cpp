@@ -0,0 +1,172 @@
+//
+//  BenchPolygon.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 06:48:20.5127
+//
+//  Area and perimeter of many polygons: plain scalar loops over the
+//  coordinates, one virtual call per Polygon, areas() and perimeters()
+//  of PolygonBuffer, and measure().  Polygons are star-shaped, 3 to -v
+//  vertices, at random sizes.  Reports ns per polygon each way.  Fails
+//  if any batch result differs in any bit from the object's, if the
+//  plain loops differ by more than rounding, or if a square, a right
+//  triangle, a clockwise hexagon and a unit square 1e10 from the origin
+//  do not measure as expected.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchPolygon.cpp ShapePolygon.cpp Shapes.cpp ShapeFormat.cpp
+//  ./a.out [-n polygons] [-v max-vertices]
+//
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ShapePolygon.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+bool same(double a, double b) {
+  return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+void row(char const * name, double ns) {
+  std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+            << std::setw(10) << std::setprecision(2) << ns << " ns\n"
+            << std::defaultfloat << std::setprecision(6);
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t n = 1'000'000;
+  std::size_t max_vertices = 12;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+    else if (std::strcmp(argv[a], "-v") == 0) {
+      max_vertices = std::max<std::size_t>(3, std::strtoull(argv[a + 1], nullptr, 10));
+    }
+  }
+
+  //  a radius per vertex at evenly spaced angles about a random centre
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<std::size_t> sides(3, max_vertices);
+  std::uniform_real_distribution<double> radius(0.5, 50);
+  std::uniform_real_distribution<double> centre(-1e3, 1e3);
+  auto buffer = std::make_shared<PolygonBuffer>();
+  buffer->reserve(n, n * (max_vertices + 3) / 2);
+  std::vector<Point> ring;
+  for (std::size_t p = 0; p < n; ++p) {
+    ring.resize(sides(rng));
+    auto const cx = centre(rng);
+    auto const cy = centre(rng);
+    for (std::size_t v = 0; v < ring.size(); ++v) {
+      auto const angle = 2 * M_PI * v / ring.size();
+      auto const r = radius(rng);
+      ring[v] = { cx + r * std::cos(angle), cy + r * std::sin(angle) };
+    }
+    buffer->add(ring);
+  }
+  std::vector<std::unique_ptr<Shape>> objects;
+  objects.reserve(n);
+  for (std::size_t p = 0; p < n; ++p) {
+    objects.push_back(std::make_unique<Polygon>(buffer, p));
+  }
+
+  //  in vertex order, one term at a time
+  std::vector<double> plain_area(n);
+  std::vector<double> plain_perimeter(n);
+  auto const plain_ns = bench::best_ns([&] {
+    auto const * x = buffer->x();
+    auto const * y = buffer->y();
+    for (std::size_t p = 0; p < n; ++p) {
+      auto const first = buffer->offset(p);
+      double area = 0;
+      double perimeter = 0;
+      for (auto i = first; i < first + buffer->length(p); ++i) {
+        area += (x[i] - x[first]) * (y[i + 1] - y[first]) - (x[i + 1] - x[first]) * (y[i] - y[first]);
+        auto const dx = x[i + 1] - x[i];
+        auto const dy = y[i + 1] - y[i];
+        perimeter += std::sqrt(dx * dx + dy * dy);
+      }
+      plain_area[p] = std::abs(area) / 2.0;
+      plain_perimeter[p] = perimeter;
+    }
+  });
+
+  std::vector<double> object_area(n);
+  std::vector<double> object_perimeter(n);
+  auto const object_ns = bench::best_ns([&] {
+    for (std::size_t p = 0; p < n; ++p) {
+      object_area[p] = objects[p]->area();
+      object_perimeter[p] = objects[p]->perimeter();
+    }
+  });
+
+  std::vector<double> batch_area(n);
+  std::vector<double> batch_perimeter(n);
+  auto const batch_ns = bench::best_ns([&] {
+    buffer->areas(batch_area.data());
+    buffer->perimeters(batch_perimeter.data());
+  });
+
+  std::vector<double> measure_area(n);
+  std::vector<double> measure_perimeter(n);
+  auto const measure_ns = bench::best_ns([&] {
+    buffer->measure(measure_area.data(), measure_perimeter.data());
+  });
+
+  bool ok = true;
+
+  bool match = true;
+  bool close = true;
+  for (std::size_t p = 0; p < n; ++p) {
+    match = match && same(batch_area[p], object_area[p]) && same(measure_area[p], object_area[p])
+                  && same(batch_perimeter[p], object_perimeter[p])
+                  && same(measure_perimeter[p], object_perimeter[p]);
+    close = close && std::abs(plain_area[p] - object_area[p]) <= 1e-9 * plain_area[p]
+                  && std::abs(plain_perimeter[p] - object_perimeter[p]) <= 1e-9 * plain_perimeter[p];
+  }
+  bench::report("batch against objects", match, ok);
+  bench::report("plain loops against objects", close, ok);
+
+  Point const square[] = { { 0, 0 }, { 2, 0 }, { 2, 2 }, { 0, 2 } };
+  Point const right[] = { { 0, 0 }, { 3, 0 }, { 0, 4 } };
+  Point hexagon[6];
+  for (std::size_t v = 0; v < 6; ++v) {
+    hexagon[v] = { std::cos(-M_PI / 3 * v), std::sin(-M_PI / 3 * v) };
+  }
+  //  far from the origin, where raw cross products would cancel
+  Point const offset[] = { { 1e10, 1e10 }, { 1e10 + 1, 1e10 }, { 1e10 + 1, 1e10 + 1 },
+                           { 1e10, 1e10 + 1 } };
+  Polygon const s(square);
+  Polygon const t(right);
+  Polygon const h(hexagon);
+  Polygon const o(offset);
+  bench::report("known shapes",
+                s.area() == 4 && s.perimeter() == 8 && t.area() == 6 && t.perimeter() == 12
+                && std::abs(h.area() - 3 * std::sqrt(3.) / 2) < 1e-12
+                && std::abs(h.perimeter() - 6) < 1e-12 && o.area() == 1 && o.perimeter() == 4
+                && s.display() == "vertices 4, perimeter 8, area 4.000000", ok);
+
+  std::cout << '\n' << n << " polygons, 3 to " << max_vertices << " vertices\n"
+            << std::setw(41) << "area + perimeter\n";
+  row("plain loops", plain_ns / n);
+  row("Polygon objects", object_ns / n);
+  row("areas() + perimeters()", batch_ns / n);
+  row("measure()", measure_ns / n);
+  return ok ? 0 : 1;
+}
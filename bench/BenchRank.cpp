@@ -0,0 +1,225 @@
+//
+//  BenchRank.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 02:24:50.1736
+//
+//  Ordering Shape pointers by area() and by perimeter(): a comparator
+//  sort calling the virtual metric in every comparison, against
+//  sort_by() (keys once, then the radix sort), and a partial_sort of
+//  the 1000 first against top_k().  Then sort_by() and top_k() over a
+//  ShapeBatch.  The parallel forms run on pools of 1, 2, 4, ... threads
+//  up to the hardware thread count (or -t).  Checks that the Shape
+//  pointer results match the comparator sort, NaN perimeters last, and
+//  that the batch results are stably sorted by the batch's own values.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchRank.cpp ShapeRank.cpp ThreadPool.cpp ShapeBatch.cpp Shapes.cpp ShapeFormat.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeRank.hpp"
+#include "Shapes.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr std::size_t k = 1000;
+
+/*
+ *  MARK: first()
+ *  the reference order: NaN last, ties in position order.
+ */
+bool first(double a, double b, Order order) {
+  if (std::isnan(a)) {
+    return false;
+  }
+  if (std::isnan(b)) {
+    return true;
+  }
+  return order == Order::ascending ? a < b : b < a;
+}
+
+/*
+ *  MARK: in_order()
+ *  a permutation, sorted, with ties in position order.
+ */
+bool in_order(std::vector<std::uint32_t> const & rows, std::vector<double> const & values,
+              Order order) {
+  std::vector<std::uint8_t> seen(values.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    if (rows[i] >= values.size() || seen[rows[i]]++) {
+      return false;
+    }
+    if (i > 0) {
+      auto const a = values[rows[i - 1]];
+      auto const b = values[rows[i]];
+      auto const tied = !first(a, b, order) && !first(b, a, order);
+      if (first(b, a, order) || (tied && rows[i - 1] > rows[i])) {
+        return false;
+      }
+    }
+  }
+  return rows.size() == values.size();
+}
+
+/*
+ *  MARK: report()
+ */
+void report(char const * name, unsigned threads, double ns, std::size_t n, bool match) {
+  std::cout << std::left << std::setw(28) << name << std::right << std::setw(8) << threads
+            << std::fixed << std::setw(12) << std::setprecision(1) << ns / 1e6
+            << std::setw(12) << std::setprecision(1) << n / ns * 1e3
+            << (match ? "" : "  MISMATCH") << std::defaultfloat << std::setprecision(6) << '\n';
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 2'000'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dim(0.5, 100.0);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+
+  ShapeBatch batch;
+  std::vector<std::unique_ptr<Shape>> owned;
+  std::vector<Shape const *> shapes;
+  owned.reserve(n);
+  shapes.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    //  rounded, so there are ties to keep in order
+    auto const a = std::round(dim(rng));
+    auto const b = std::round(dim(rng));
+    auto const c = std::round(dim(rng));
+    double const params[] = { a, b, c, a + b };
+    auto const kind = static_cast<ShapeKind>(pick(rng));
+    batch.append(kind, params, layout_of(kind).params);
+    switch (kind) {
+    case ShapeKind::rectangle:                owned.push_back(std::make_unique<Rectangle>(a, b)); break;
+    case ShapeKind::square:                   owned.push_back(std::make_unique<Square>(a)); break;
+    case ShapeKind::parallelogram:            owned.push_back(std::make_unique<Parallelogram>(a, b, c)); break;
+    case ShapeKind::circle:                   owned.push_back(std::make_unique<Circle>(a)); break;
+    case ShapeKind::triangle:                 owned.push_back(std::make_unique<Triangle>(a, b)); break;
+    case ShapeKind::right_triangle:           owned.push_back(std::make_unique<RightTriangle>(a, b)); break;
+    case ShapeKind::isosceles_triangle:       owned.push_back(std::make_unique<IsoscelesTriangle>(a, b)); break;
+    case ShapeKind::equilateral_triangle:     owned.push_back(std::make_unique<EquilateralTriangle>(a)); break;
+    case ShapeKind::right_isosceles_triangle: owned.push_back(std::make_unique<RightIsoscelesTriangle>(a)); break;
+    }
+    shapes.push_back(owned.back().get());
+  }
+
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+
+  std::cout << n << " shapes, top " << k << '\n'
+            << std::left << std::setw(28) << "" << std::right << std::setw(8) << "threads"
+            << std::setw(12) << "ms" << std::setw(12) << "Mshapes/s" << '\n';
+  bool ok = true;
+  for (auto const metric : { Metric::area, Metric::perimeter }) {
+    auto const order = metric == Metric::area ? Order::descending : Order::ascending;
+    auto const value = [metric](Shape const * s) {
+      return metric == Metric::area ? s->area() : s->perimeter();
+    };
+    std::cout << (metric == Metric::area ? "\narea, descending\n" : "\nperimeter, ascending\n");
+
+    std::vector<std::uint32_t> reference(n);
+    auto const sort_ns = bench::best_ns([&] {
+      std::iota(reference.begin(), reference.end(), 0u);
+      std::stable_sort(reference.begin(), reference.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return first(value(shapes[a]), value(shapes[b]), order);
+      });
+    }, 1);
+    report("stable_sort, virtual", 1, sort_ns, n, true);
+
+    std::vector<std::uint32_t> partial(n);
+    auto const partial_ns = bench::best_ns([&] {
+      std::iota(partial.begin(), partial.end(), 0u);
+      std::partial_sort(partial.begin(), partial.begin() + std::min(k, n), partial.end(),
+                        [&](std::uint32_t a, std::uint32_t b) {
+        auto const va = value(shapes[a]);
+        auto const vb = value(shapes[b]);
+        return first(va, vb, order) || (!first(vb, va, order) && a < b);
+      });
+    }, 1);
+    partial.resize(std::min(k, n));
+    std::vector<std::uint32_t> const top(reference.begin(), reference.begin() + std::min(k, n));
+    report("partial_sort, virtual", 1, partial_ns, n, partial == top);
+    ok = ok && partial == top;
+
+    for (auto const t : sizes) {
+      ThreadPool pool(t);
+      std::vector<std::uint32_t> sorted;
+      auto const ns = bench::best_ns([&] { sorted = sort_by(shapes, metric, order, pool); }, 3);
+      report("sort_by, Shape *", t, ns, n, sorted == reference);
+      ok = ok && sorted == reference;
+    }
+    for (auto const t : sizes) {
+      ThreadPool pool(t);
+      std::vector<std::uint32_t> best;
+      auto const ns = bench::best_ns([&] { best = top_k(shapes, metric, k, order, pool); }, 3);
+      report("top_k, Shape *", t, ns, n, best == top);
+      ok = ok && best == top;
+    }
+
+    //  the batch in its own row order
+    auto const view = batch.view();
+    std::vector<double> values(n);
+    if (metric == Metric::area) {
+      view.areas(values.data());
+    }
+    else {
+      view.perimeters(values.data());
+    }
+    for (auto const t : sizes) {
+      ThreadPool pool(t);
+      std::vector<std::uint32_t> sorted;
+      auto const ns = bench::best_ns([&] { sorted = sort_by(view, metric, order, pool); }, 3);
+      auto const match = in_order(sorted, values, order);
+      report("sort_by, ShapeBatch", t, ns, n, match);
+      ok = ok && match;
+    }
+    auto const rows = sort_by(view, metric, order);
+    for (auto const t : sizes) {
+      ThreadPool pool(t);
+      std::vector<std::uint32_t> best;
+      auto const ns = bench::best_ns([&] { best = top_k(view, metric, k, order, pool); }, 3);
+      auto const match = std::equal(best.begin(), best.end(), rows.begin());
+      report("top_k, ShapeBatch", t, ns, n, match);
+      ok = ok && match;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+//
+//  BenchRaster.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-18 00:41:37.9264
+//
+//  rasterize() of randomly placed shapes into a 4096 x 4096 grid, in
+//  both coverage modes, on pools of 1, 2, 4, ... threads up to the
+//  hardware thread count (or -t); reports shapes/s and cells/s (cells
+//  of the shapes' bounding boxes drawn).  Checks that every pool size
+//  gives the same grid, and that area coverage of a sample of shapes
+//  drawn alone sums to the shape's area.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchRaster.cpp ShapeRaster.cpp ShapeCollide.cpp ShapeBounds.cpp ShapeBatch.cpp ShapeValue.cpp Shapes.cpp ShapeFormat.cpp ThreadPool.cpp -pthread
+//  ./a.out [-t max-threads] [-n shapes]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ShapeBatch.hpp"
+#include "ShapeBounds.hpp"
+#include "ShapeRaster.hpp"
+#include "ThreadPool.hpp"
+#include "BenchUtil.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr std::size_t side = 4096;
+constexpr std::size_t checked = 500;
+
+/*
+ *  MARK: exact_area()
+ *  of the outline itself, which is what the grid sees.
+ */
+double exact_area(Outline const & o) {
+  if (o.size == 0) {
+    return M_PI * o.radius * o.radius;
+  }
+  double area = 0;
+  for (std::uint8_t i = 0; i < o.size; ++i) {
+    auto const & p = o.corners[i];
+    auto const & q = o.corners[(i + 1) % o.size];
+    area += p.x * q.y - q.x * p.y;
+  }
+  return std::abs(area) / 2;
+}
+
+/*
+ *  MARK: total()
+ */
+double total(CoverageGrid const & grid) {
+  double sum = 0;
+  for (std::size_t r = 0; r < grid.height(); ++r) {
+    auto const row = grid.row(r);
+    sum = std::accumulate(row.begin(), row.end(), sum);
+  }
+  return sum;
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t n = 200'000;
+  for (int a = 1; a + 1 < argc; a += 2) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      max_threads = std::max(1u, static_cast<unsigned>(std::strtoul(argv[a + 1], nullptr, 10)));
+    }
+    else if (std::strcmp(argv[a], "-n") == 0) {
+      n = std::strtoull(argv[a + 1], nullptr, 10);
+    }
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dim(1.0, 24.0);
+  std::uniform_real_distribution<double> where(0, side);
+  std::uniform_real_distribution<double> turn(0, 2 * M_PI);
+  std::uniform_int_distribution<std::size_t> pick(0, shape_kind_count - 1);
+
+  ShapeBatch batch;
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const a = dim(rng);
+    auto const b = dim(rng);
+    double const params[] = { a, a + b, a + b / 2, a + b };
+    auto const kind = static_cast<ShapeKind>(pick(rng));
+    batch.append(kind, params, layout_of(kind).params);
+  }
+
+  //  rows in ShapeKind order, as the batch lays them out
+  auto const view = batch.view();
+  std::vector<Outline> shapes;
+  double cells = 0;
+  for (std::size_t k = 0; k < shape_kind_count; ++k) {
+    auto const kind = static_cast<ShapeKind>(k);
+    for (std::size_t i = 0; i < view.size(kind); ++i) {
+      double fields[4] = {};
+      for (std::size_t f = 0; f < layout_of(kind).fields; ++f) {
+        fields[f] = view.column(kind, f)[i];
+      }
+      shapes.push_back(outline(kind, fields, { where(rng), where(rng), turn(rng) }));
+      auto const box = bounds(shapes.back());
+      cells += (std::floor(box.max_x) - std::floor(box.min_x) + 1)
+               * (std::floor(box.max_y) - std::floor(box.min_y) + 1);
+    }
+  }
+
+  std::vector<unsigned> sizes;
+  for (unsigned t = 1; t < max_threads; t *= 2) {
+    sizes.push_back(t);
+  }
+  sizes.push_back(max_threads);
+
+  std::cout << n << " shapes, " << side << " x " << side << " grid, "
+            << std::fixed << std::setprecision(1) << cells / n << " cells/shape\n\n"
+            << std::left << std::setw(8) << "mode" << std::right << std::setw(8) << "threads"
+            << std::setw(10) << "ms" << std::setw(14) << "Mshapes/s" << std::setw(14) << "Mcells/s"
+            << std::setw(10) << "covered" << '\n';
+
+  bool ok = true;
+  CoverageGrid grid(side, side);
+  for (auto const mode : { Coverage::centre, Coverage::area }) {
+    std::vector<float> reference;
+    for (auto const t : sizes) {
+      ThreadPool pool(t);
+      auto const ns = bench::best_ns([&] {
+        grid.clear();
+        rasterize(shapes, grid, mode, pool);
+      }, 3);
+      std::vector<float> cover;
+      for (std::size_t r = 0; r < side; ++r) {
+        cover.insert(cover.end(), grid.row(r).begin(), grid.row(r).end());
+      }
+      if (t == sizes.front()) {
+        reference = cover;
+      }
+      auto const match = cover == reference;
+      ok = ok && match;
+      std::cout << std::left << std::setw(8) << (mode == Coverage::centre ? "centre" : "area")
+                << std::right << std::setw(8) << t
+                << std::setw(10) << std::setprecision(1) << ns / 1e6
+                << std::setw(14) << std::setprecision(2) << n / ns * 1e3
+                << std::setw(14) << std::setprecision(1) << cells / ns * 1e3
+                << std::setw(9) << std::setprecision(1)
+                << 100.0 * grid.covered() / (side * side) << '%'
+                << (match ? "" : "  MISMATCH") << '\n';
+    }
+  }
+  std::cout << std::defaultfloat << std::setprecision(6);
+
+  //  each shape alone on a grid around it: coverage sums to its area
+  std::size_t wrong = 0;
+  double worst = 0;
+  ThreadPool pool(1);
+  for (std::size_t i = 0; i < std::min(checked, n); ++i) {
+    auto const box = bounds(shapes[i]);
+    Point const corner { std::floor(box.min_x), std::floor(box.min_y) };
+    CoverageGrid alone(static_cast<std::size_t>(box.max_x - corner.x) + 1,
+                       static_cast<std::size_t>(box.max_y - corner.y) + 1, 1, corner);
+    rasterize(std::span(shapes).subspan(i, 1), alone, Coverage::area, pool);
+    auto const want = exact_area(shapes[i]);
+    auto const error = std::abs(total(alone) - want) / want;
+    worst = std::max(worst, error);
+    if (error > 1e-5) {
+      ++wrong;
+    }
+  }
+  std::cout << "\narea check: worst relative error " << worst << '\n';
+  if (wrong > 0) {
+    std::cout << wrong << " of " << checked << " shapes miss their area\n";
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
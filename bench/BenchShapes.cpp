@@ -0,0 +1,234 @@
+//
+//  BenchShapes.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 13:05:51.2298
+//
+//  Baseline microbenchmarks: construction (heap and ShapeArena),
+//  area(), perimeter(), dimensions(), display(), format_to() and dims()
+//  for each concrete class on a single object and on 1K / 1M
+//  collections, plus mixed collections of all nine classes sorted by
+//  class and shuffled.
+//  Reports ns/op, allocations/op and bytes/op.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchShapes.cpp bench/AllocCounter.cpp Shapes.cpp ShapeFormat.cpp ShapeArena.cpp
+//  ./a.out [filter]
+//
+//  Build with -DSHAPE_TRACE=1 to include the cost of tracing.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Shapes.hpp"
+#include "ShapeArena.hpp"
+#include "BenchUtil.hpp"
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Helpers.
+namespace {
+
+using Collection = std::vector<std::unique_ptr<Shape>>;
+using Maker = std::function<std::unique_ptr<Shape>()>;
+
+constexpr std::size_t single_ops = 100'000;
+constexpr std::size_t sizes[] = { 1'000, 1'000'000 };
+
+char const * filter = nullptr;
+
+/*
+ *  MARK: report()
+ */
+void report(std::string const & name, std::string const & op,
+            std::string const & size, bench::Measurement const & m) {
+  std::cout << std::left << std::setw(24) << name
+       << std::setw(12) << op
+       << std::setw(10) << size << std::right << std::fixed
+       << std::setw(12) << std::setprecision(2) << m.ns_per_op << " ns/op"
+       << std::setw(10) << std::setprecision(2) << m.allocs_per_op << " allocs/op"
+       << std::setw(10) << std::setprecision(1) << m.bytes_per_op << " B/op"
+       << std::endl;
+}
+
+bool selected(std::string const & name) {
+  return filter == nullptr || name.find(filter) != std::string::npos;
+}
+
+int reps_for(std::size_t n) {
+  return n >= 1'000'000 ? 1 : 5;
+}
+
+/*
+ *  MARK: bench_methods()
+ *  area/perimeter/dimensions/display over every element of shapes.
+ */
+void bench_methods(std::string const & name, std::string const & size,
+                   Collection const & shapes) {
+  auto const n = shapes.size();
+  auto const reps = reps_for(n);
+
+  report(name, "area"s, size, bench::measure(n, [&] {
+    for (auto const & s : shapes) { bench::do_not_optimize(s->area()); }
+  }, reps));
+  report(name, "perimeter"s, size, bench::measure(n, [&] {
+    for (auto const & s : shapes) { bench::do_not_optimize(s->perimeter()); }
+  }, reps));
+  report(name, "dimensions"s, size, bench::measure(n, [&] {
+    for (auto const & s : shapes) { bench::do_not_optimize(s->dimensions()); }
+  }, reps));
+  report(name, "display"s, size, bench::measure(n, [&] {
+    for (auto const & s : shapes) { bench::do_not_optimize(s->display()); }
+  }, reps));
+  report(name, "format_to"s, size, bench::measure(n, [&] {
+    char buf[256];
+    for (auto const & s : shapes) { bench::do_not_optimize(s->format_to(buf, sizeof(buf))); }
+  }, reps));
+}
+
+/*
+ *  MARK: bench_class()
+ */
+template <typename T, typename... Args>
+void bench_class(std::string const & name, Args... args) {
+  if (!selected(name)) {
+    return;
+  }
+
+  //  single object, stack constructed / called through Shape &
+  report(name, "construct"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) {
+      T shape(args...);
+      bench::do_not_optimize(shape);
+    }
+  }));
+
+  T object(args...);
+  Shape const & shape = object;
+  report(name, "area"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) { bench::do_not_optimize(shape.area()); }
+  }));
+  report(name, "perimeter"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) { bench::do_not_optimize(shape.perimeter()); }
+  }));
+  report(name, "dimensions"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) { bench::do_not_optimize(shape.dimensions()); }
+  }));
+  report(name, "display"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) { bench::do_not_optimize(shape.display()); }
+  }));
+  report(name, "format_to"s, "single"s, bench::measure(single_ops, [&] {
+    char buf[256];
+    for (std::size_t i = 0; i < single_ops; ++i) {
+      bench::do_not_optimize(shape.format_to(buf, sizeof(buf)));
+    }
+  }));
+  report(name, "dims"s, "single"s, bench::measure(single_ops, [&] {
+    for (std::size_t i = 0; i < single_ops; ++i) { bench::do_not_optimize(object.dims()); }
+  }));
+
+  //  heap collections, the way a polymorphic container holds them
+  for (auto n : sizes) {
+    auto const size = std::to_string(n);
+    report(name, "construct"s, size, bench::measure(n, [&] {
+      Collection shapes;
+      shapes.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        shapes.push_back(std::make_unique<T>(args...));
+      }
+      bench::do_not_optimize(shapes.data());
+    }, reps_for(n)));
+    report(name, "arena"s, size, bench::measure(n, [&] {
+      ShapeArena arena;
+      std::vector<Shape *> shapes;
+      shapes.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        shapes.push_back(arena.make<T>(args...));
+      }
+      bench::do_not_optimize(shapes.data());
+    }, reps_for(n)));
+
+    Collection shapes;
+    shapes.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      shapes.push_back(std::make_unique<T>(args...));
+    }
+    bench_methods(name, size, shapes);
+  }
+}
+
+/*
+ *  MARK: bench_mixed()
+ *  all nine classes in equal proportion, grouped by class or shuffled.
+ */
+void bench_mixed() {
+  std::vector<Maker> const makers {
+    [] { return std::make_unique<Rectangle>(3., 4.); },
+    [] { return std::make_unique<Square>(4.); },
+    [] { return std::make_unique<Parallelogram>(4., 3., 5.); },
+    [] { return std::make_unique<Circle>(10.0); },
+    [] { return std::make_unique<Triangle>(3., 4.); },
+    [] { return std::make_unique<RightTriangle>(3., 4.); },
+    [] { return std::make_unique<IsoscelesTriangle>(6., 4.); },
+    [] { return std::make_unique<EquilateralTriangle>(4.0); },
+    [] { return std::make_unique<RightIsoscelesTriangle>(5.); },
+  };
+
+  for (auto const * order : { "sorted", "shuffled" }) {
+    auto const name = "Mixed "s + order;
+    if (!selected(name)) {
+      continue;
+    }
+    for (auto n : sizes) {
+      std::vector<std::size_t> kinds(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        kinds[i] = i % makers.size();
+      }
+      if (std::strcmp(order, "sorted") == 0) {
+        std::sort(kinds.begin(), kinds.end());
+      }
+      else {
+        std::shuffle(kinds.begin(), kinds.end(), std::mt19937_64(20210202));
+      }
+
+      Collection shapes;
+      shapes.reserve(n);
+      for (auto k : kinds) {
+        shapes.push_back(makers[k]());
+      }
+      bench_methods(name, std::to_string(n), shapes);
+    }
+  }
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  filter = argc > 1 ? argv[1] : nullptr;
+
+
+  bench_class<Rectangle>("Rectangle"s, 3., 4.);
+  bench_class<Square>("Square"s, 4.);
+  bench_class<Parallelogram>("Parallelogram"s, 4., 3., 5.);
+  bench_class<Circle>("Circle"s, 10.0);
+  bench_class<Triangle>("Triangle"s, 3., 4.);
+  bench_class<RightTriangle>("RightTriangle"s, 3., 4.);
+  bench_class<IsoscelesTriangle>("IsoscelesTriangle"s, 6., 4.);
+  bench_class<EquilateralTriangle>("EquilateralTriangle"s, 4.0);
+  bench_class<RightIsoscelesTriangle>("RightIsoscelesTriangle"s, 5.);
+  bench_mixed();
+
+  return 0;
+}
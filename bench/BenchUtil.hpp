@@ -0,0 +1,100 @@
+//
+//  BenchUtil.hpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 11:40:18.0663
+//
+
+#ifndef BenchUtil_hpp
+#define BenchUtil_hpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+//  MARK: - Definitions.
+namespace bench {
+
+/*
+ *  MARK: do_not_optimize()
+ *  keep the optimiser from discarding a result.
+ */
+template <typename T>
+inline
+void do_not_optimize(T const & value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*
+ *  MARK: report()
+ *  one check, printed as "same" or "MISMATCH"; ok is cleared if it
+ *  fails.
+ */
+inline
+void report(char const * what, bool pass, bool & ok) {
+  std::cout << std::left << std::setw(40) << what << std::right
+            << (pass ? "same" : "MISMATCH") << '\n';
+  ok = ok && pass;
+}
+
+/*
+ *  MARK: struct AllocStats
+ *  running totals kept by the operator new replacement in
+ *  AllocCounter.cpp; only valid in programs linked with it.
+ */
+struct AllocStats {
+  std::size_t count;
+  std::size_t bytes;
+};
+
+AllocStats alloc_stats();
+
+/*
+ *  MARK: struct Measurement
+ */
+struct Measurement {
+  double ns_per_op;
+  double allocs_per_op;
+  double bytes_per_op;
+};
+
+/*
+ *  MARK: best_ns()
+ *  wall time of the fastest of reps runs of fn, in nanoseconds.
+ */
+template <typename Fn>
+double best_ns(Fn && fn, int reps = 5) {
+  using clock = std::chrono::steady_clock;
+  auto best = std::numeric_limits<double>::max();
+  for (int r = 0; r < reps; ++r) {
+    auto const t0 = clock::now();
+    fn();
+    auto const t1 = clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+  }
+  return best;
+}
+
+/*
+ *  MARK: measure()
+ *  fn performs ops operations per call.  Time is the best of reps
+ *  calls, allocations are averaged over all of them.
+ */
+template <typename Fn>
+Measurement measure(std::size_t ops, Fn && fn, int reps = 5) {
+  auto const before = alloc_stats();
+  auto const ns = best_ns(fn, reps);
+  auto const after = alloc_stats();
+  auto const total = double(ops) * reps;
+  return { ns / ops,
+           double(after.count - before.count) / total,
+           double(after.bytes - before.bytes) / total };
+}
+
+} /* namespace bench */
+
+#endif /* BenchUtil_hpp */
@@ -0,0 +1,139 @@
+//
+//  BenchVariant.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 11:40:18.0663
+//
+//  Throughput of the virtual Shape hierarchy against the ShapeValue
+//  variant on a mixed collection, shuffled and sorted by kind.
+//
+//  c++ -std=c++20 -O2 -I. bench/BenchVariant.cpp Shapes.cpp ShapeValue.cpp ShapeFormat.cpp
+//  ./a.out [shapes]
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Shapes.hpp"
+#include "ShapeValue.hpp"
+#include "BenchUtil.hpp"
+
+using namespace std::literals::string_literals;
+
+//  MARK: - Helpers.
+namespace {
+
+struct Spec {
+  std::size_t kind;
+  double a;
+  double b;
+  double c;
+};
+
+std::unique_ptr<Shape> make_object(Spec const & s) {
+  switch (s.kind) {
+  case 0: return std::make_unique<Rectangle>(s.a, s.b);
+  case 1: return std::make_unique<Square>(s.a);
+  case 2: return std::make_unique<Parallelogram>(s.a, s.b, s.c);
+  case 3: return std::make_unique<Circle>(s.a);
+  case 4: return std::make_unique<Triangle>(s.a, s.b, s.c, s.c);
+  case 5: return std::make_unique<RightTriangle>(s.a, s.b);
+  case 6: return std::make_unique<IsoscelesTriangle>(s.a, s.b);
+  case 7: return std::make_unique<EquilateralTriangle>(s.a);
+  default: return std::make_unique<RightIsoscelesTriangle>(s.a);
+  }
+}
+
+ShapeValue make_value(Spec const & s) {
+  switch (s.kind) {
+  case 0: return RectangleValue(s.a, s.b);
+  case 1: return SquareValue(s.a);
+  case 2: return ParallelogramValue(s.a, s.b, s.c);
+  case 3: return CircleValue(s.a);
+  case 4: return TriangleValue(s.a, s.b, s.c, s.c);
+  case 5: return RightTriangleValue(s.a, s.b);
+  case 6: return IsoscelesTriangleValue(s.a, s.b);
+  case 7: return EquilateralTriangleValue(s.a);
+  default: return RightIsoscelesTriangleValue(s.a);
+  }
+}
+
+void report(std::string const & label, double ns, std::size_t n, double sum) {
+  std::cout << std::setw(28) << std::left << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(3) << ns / n
+            << " ns/shape   checksum " << std::setprecision(1) << sum << '\n';
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  std::size_t const n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+  std::mt19937_64 rng(20210202);
+  std::uniform_int_distribution<std::size_t> kind(0, 8);
+  std::uniform_real_distribution<double> length(1., 100.);
+  std::vector<Spec> specs(n);
+  for (auto & s : specs) {
+    s = { kind(rng), length(rng), length(rng), length(rng) };
+  }
+  auto sorted = specs;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](Spec const & l, Spec const & r) { return l.kind < r.kind; });
+
+  std::cout << "shapes " << n << '\n'
+            << "sizeof RightIsoscelesTriangle " << sizeof(RightIsoscelesTriangle)
+            << ", sizeof ShapeValue " << sizeof(ShapeValue) << "\n\n";
+
+  for (auto const * order : { &specs, &sorted }) {
+    auto const tag = order == &specs ? " shuffled"s : " sorted"s;
+
+    std::vector<std::unique_ptr<Shape>> objects;
+    objects.reserve(n);
+    for (auto const & s : *order) {
+      objects.push_back(make_object(s));
+    }
+
+    std::vector<ShapeValue> values;
+    values.reserve(n);
+    for (auto const & s : *order) {
+      values.push_back(make_value(s));
+    }
+
+    double vsum = 0;
+    auto const vns = bench::best_ns([&] {
+      double sum = 0;
+      for (auto const & shape : objects) {
+        sum += shape->area() + shape->perimeter();
+      }
+      bench::do_not_optimize(sum);
+      vsum = sum;
+    });
+
+    double xsum = 0;
+    auto const xns = bench::best_ns([&] {
+      double sum = 0;
+      for (auto const & value : values) {
+        sum += area(value) + perimeter(value);
+      }
+      bench::do_not_optimize(sum);
+      xsum = sum;
+    });
+
+    report("virtual Shape"s + tag, vns, n, vsum);
+    report("ShapeValue variant"s + tag, xns, n, xsum);
+    std::cout << "speedup " << std::setprecision(2) << vns / xns << "x\n\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+//
+//  ShapeIngest.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 18:05:12.3306
+//
+//  Loads a CSV or binary shape record file and reports per-kind counts,
+//  total area and throughput.  -w streams the file in windows of the
+//  given size in MiB, -j sets the parser thread count, -o writes the
+//  shapes back out as a binary record file, -c as a column file.
+//
+//  c++ -std=c++20 -O2 -I. tools/ShapeIngest.cpp ShapeLoader.cpp ShapeStore.cpp ShapeBatch.cpp -pthread
+//  ./a.out [-w MiB] [-j threads] [-o out.shr] [-c out.col] records-file
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ShapeLoader.hpp"
+#include "ShapeStore.hpp"
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  shape_loader::LoadOptions options;
+  bool stream = false;
+  char const * path = nullptr;
+  char const * save = nullptr;
+  char const * columns = nullptr;
+  for (int a = 1; a < argc; ++a) {
+    if (std::strcmp(argv[a], "-w") == 0 && a + 1 < argc) {
+      stream = true;
+      options.window = std::strtoull(argv[++a], nullptr, 10) << 20;
+    }
+    else if (std::strcmp(argv[a], "-j") == 0 && a + 1 < argc) {
+      options.threads = static_cast<unsigned>(std::strtoul(argv[++a], nullptr, 10));
+    }
+    else if (std::strcmp(argv[a], "-o") == 0 && a + 1 < argc) {
+      save = argv[++a];
+    }
+    else if (std::strcmp(argv[a], "-c") == 0 && a + 1 < argc) {
+      columns = argv[++a];
+    }
+    else {
+      path = argv[a];
+    }
+  }
+  if (path == nullptr || (stream && options.window == 0)
+      || (stream && (save != nullptr || columns != nullptr))) {
+    std::cerr << "usage: " << argv[0]
+              << " [-w MiB | -o out.shr -c out.col] [-j threads] records-file\n";
+    return 2;
+  }
+
+  std::size_t counts[shape_kind_count] = {};
+  double total_area = 0;
+  std::vector<double> areas;
+  auto const tally = [&](ShapeBatch const & batch) {
+    for (std::size_t k = 0; k < shape_kind_count; ++k) {
+      auto const kind = static_cast<ShapeKind>(k);
+      areas.resize(batch.size(kind));
+      batch.areas(kind, areas.data());
+      for (auto area : areas) {
+        total_area += area;
+      }
+      counts[k] += areas.size();
+    }
+  };
+
+  try {
+    auto const start = std::chrono::steady_clock::now();
+    shape_loader::LoadStats stats;
+    ShapeBatch batch;
+    if (stream) {
+      stats = shape_loader::stream_shapes(path, tally, options);
+    }
+    else {
+      stats = shape_loader::load_shapes(path, batch, options);
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    if (!stream) {
+      tally(batch);
+    }
+
+    for (std::size_t k = 0; k < shape_kind_count; ++k) {
+      std::cout << shape_layouts[k].name << ": " << counts[k] << '\n';
+    }
+    std::cout << "records " << stats.records << ", rejected " << stats.rejected
+              << ", windows " << stats.windows << '\n'
+              << "total area " << total_area << '\n'
+              << stats.bytes / 1048576.0 / elapsed.count() << " MiB/s, "
+              << stats.records / elapsed.count() << " records/s\n";
+
+    if (save != nullptr) {
+      shape_loader::save_records(save, batch);
+    }
+    if (columns != nullptr) {
+      shape_store::write_columns(columns, batch.view());
+    }
+  }
+  catch (std::exception const & e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,165 @@
+//
+//  ShapeLayout.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 21:48:27.1175
+//
+//  Per-shape memory report.  For every class: sizeof and alignof, the
+//  bytes of data members the complete object holds (virtual bases
+//  counted once, a triangle's derive state included), the bytes the
+//  constructor arguments need, and what is left over for vptrs,
+//  virtual-base offsets and padding.  Then the same shape as a
+//  ShapeValue and in a ShapeBatch, and the measured bytes per object
+//  of operator new against ShapeArena.
+//
+//  c++ -std=c++20 -O2 -I. tools/ShapeLayout.cpp ShapeArena.cpp Shapes.cpp ShapeFormat.cpp
+//  ./a.out
+//
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ShapeArena.hpp"
+#include "ShapeBatch.hpp"
+#include "ShapeValue.hpp"
+#include "Shapes.hpp"
+
+//  MARK: - Helpers.
+namespace {
+
+constexpr std::size_t samples = 4096;
+
+/*
+ *  MARK: own
+ *  bytes of the data members each class declares itself, by type.
+ *  The members are protected and most of the classes final, so the
+ *  types are listed here, in declaration order.
+ */
+namespace own {
+//  baseA_, baseB_, sideA_, sideB_
+constexpr std::size_t quadrilateral = 4 * sizeof(double);
+//  height_
+constexpr std::size_t parallelogram = sizeof(double);
+//  radius_
+constexpr std::size_t circle = sizeof(double);
+//  base_, height_, sideA_, sideB_, state_
+constexpr std::size_t triangle = 4 * sizeof(double) + sizeof(std::atomic<std::uint8_t>);
+//  hypotenuse_
+constexpr std::size_t right_triangle = sizeof(double);
+//  ibase_, iheight_, iside_
+constexpr std::size_t isosceles_triangle = 3 * sizeof(double);
+//  height2_
+constexpr std::size_t right_isosceles_triangle = sizeof(double);
+} /* namespace own */
+
+/*
+ *  MARK: stride()
+ *  average distance between consecutive objects made by make().
+ */
+template <typename Make>
+double stride(Make make) {
+  std::vector<std::uintptr_t> at;
+  at.reserve(samples);
+  for (std::size_t i = 0; i < samples; ++i) {
+    at.push_back(reinterpret_cast<std::uintptr_t>(make()));
+  }
+  std::uintptr_t total = 0;
+  std::size_t n = 0;
+  for (std::size_t i = 1; i < samples; ++i) {
+    //  only neighbours in allocation order, as a block or heap page allows
+    if (at[i] > at[i - 1] && at[i] - at[i - 1] < 4096) {
+      total += at[i] - at[i - 1];
+      ++n;
+    }
+  }
+  return n == 0 ? 0 : double(total) / n;
+}
+
+/*
+ *  MARK: report()
+ *  data: bytes of data members held by the complete object.
+ */
+template <typename T, typename Value, typename... Args>
+void report(char const * name, ShapeKind kind, std::size_t data, Args... args) {
+  auto const needed = layout_of(kind).params * sizeof(double);
+
+  std::vector<std::unique_ptr<T>> heap;
+  heap.reserve(samples);
+  auto const heap_stride = stride([&] {
+    heap.push_back(std::make_unique<T>(args...));
+    return heap.back().get();
+  });
+  ShapeArena arena;
+  auto const arena_stride = stride([&] { return arena.make<T>(args...); });
+
+  std::cout << std::left << std::setw(24) << name << std::right
+            << std::setw(7) << sizeof(T)
+            << std::setw(7) << alignof(T)
+            << std::setw(7) << data
+            << std::setw(7) << needed
+            << std::setw(10) << sizeof(T) - data
+            << std::setw(8) << sizeof(Value)
+            << std::setw(8) << layout_of(kind).fields * sizeof(double)
+            << std::fixed << std::setprecision(1)
+            << std::setw(8) << heap_stride
+            << std::setw(8) << arena_stride
+            << std::defaultfloat << '\n';
+}
+
+} /* namespace */
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main() {
+  std::cout << std::left << std::setw(24) << "class" << std::right
+            << std::setw(7) << "sizeof"
+            << std::setw(7) << "align"
+            << std::setw(7) << "data"
+            << std::setw(7) << "args"
+            << std::setw(10) << "overhead"
+            << std::setw(8) << "value"
+            << std::setw(8) << "batch"
+            << std::setw(8) << "new"
+            << std::setw(8) << "arena" << '\n';
+
+  auto const quadrilateral = own::quadrilateral;
+  auto const right_triangle = own::triangle + own::right_triangle;
+  auto const isosceles_triangle = own::triangle + own::isosceles_triangle;
+  auto const right_isosceles_triangle = own::triangle + own::right_triangle
+                                      + own::isosceles_triangle + own::right_isosceles_triangle;
+
+  report<Rectangle, RectangleValue>("Rectangle", ShapeKind::rectangle, quadrilateral, 3.0, 4.0);
+  report<Square, SquareValue>("Square", ShapeKind::square, quadrilateral, 3.0);
+  report<Parallelogram, ParallelogramValue>("Parallelogram", ShapeKind::parallelogram,
+                                            quadrilateral + own::parallelogram, 2.0, 5.0, 3.0);
+  report<Circle, CircleValue>("Circle", ShapeKind::circle, own::circle, 2.5);
+  report<Triangle, TriangleValue>("Triangle", ShapeKind::triangle, own::triangle,
+                                  3.0, 4.0, 5.0, 6.0);
+  report<RightTriangle, RightTriangleValue>("RightTriangle", ShapeKind::right_triangle,
+                                            right_triangle, 3.0, 4.0);
+  report<IsoscelesTriangle, IsoscelesTriangleValue>("IsoscelesTriangle",
+                                                    ShapeKind::isosceles_triangle,
+                                                    isosceles_triangle, 6.0, 4.0);
+  report<EquilateralTriangle, EquilateralTriangleValue>("EquilateralTriangle",
+                                                        ShapeKind::equilateral_triangle,
+                                                        isosceles_triangle, 6.0);
+  report<RightIsoscelesTriangle, RightIsoscelesTriangleValue>("RightIsoscelesTriangle",
+                                                              ShapeKind::right_isosceles_triangle,
+                                                              right_isosceles_triangle, 7.0);
+
+  std::cout << "\nsizeof(ShapeValue) " << sizeof(ShapeValue) << '\n'
+            << "data: bytes of data members, derive state included;\n"
+            << "args: constructor arguments;\n"
+            << "overhead: sizeof - data (vptrs, virtual-base offsets, padding);\n"
+            << "value/batch: bytes as a ShapeValue alternative / ShapeBatch row;\n"
+            << "new/arena: measured bytes between consecutive objects\n";
+  return 0;
+}
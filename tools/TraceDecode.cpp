@@ -0,0 +1,50 @@
+//
+//  TraceDecode.cpp
+//  JuicyCreativeDirectory
+//
+//  Created by Alan Sampson on 10/17/26.
+//  2026-10-17 14:21:36.7405
+//
+//  Offline decoder for binary traces written by shape_trace::dump().
+//
+//  c++ -std=c++20 -O2 -I. tools/TraceDecode.cpp ShapeTrace.cpp
+//  ./a.out [-t] shapes.trace
+//
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "ShapeTrace.hpp"
+
+//  MARK: - Implementation.
+/*
+ *  MARK: main()
+ */
+int main(int argc, char const * argv[]) {
+  bool annotate = false;
+  char const * path = nullptr;
+  for (int a = 1; a < argc; ++a) {
+    if (std::strcmp(argv[a], "-t") == 0) {
+      annotate = true;
+    }
+    else {
+      path = argv[a];
+    }
+  }
+  if (path == nullptr) {
+    std::cerr << "usage: " << argv[0] << " [-t] trace-file\n";
+    return 2;
+  }
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << path << ": cannot open\n";
+    return 1;
+  }
+  if (!shape_trace::decode(in, std::cout, annotate)) {
+    std::cerr << path << ": not a shape trace\n";
+    return 1;
+  }
+  return 0;
+}